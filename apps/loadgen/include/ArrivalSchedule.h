@@ -0,0 +1,49 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <string_view>
+
+namespace astra::loadgen {
+
+// When each request of an open-loop run is due, as an offset from the
+// start of the run. The schedule never looks at responses: a slow server
+// does not slow the arrivals down, which is what keeps the generator from
+// hiding the server's queueing delay.
+class ArrivalSchedule {
+public:
+  enum class Kind {
+    Constant, // exactly 1/rate apart
+    Poisson   // exponential gaps with mean 1/rate
+  };
+
+  // Throws std::invalid_argument unless rate > 0
+  static ArrivalSchedule create(Kind kind, double rate, uint64_t seed = 1);
+  // "constant" or "poisson"; throws std::invalid_argument otherwise
+  static Kind parse_kind(std::string_view name);
+  static std::string_view kind_name(Kind kind) noexcept;
+
+  // Offset of the next arrival
+  std::chrono::nanoseconds next();
+
+  [[nodiscard]] Kind kind() const noexcept {
+    return m_kind;
+  }
+  [[nodiscard]] double rate() const noexcept {
+    return m_rate;
+  }
+
+private:
+  ArrivalSchedule(Kind kind, double rate, uint64_t seed);
+
+  Kind m_kind;
+  double m_rate;
+  uint64_t m_count = 0;
+  // Seconds; accumulated in floating point so gaps below 1ns still add up
+  double m_poisson_at = 0;
+  std::mt19937_64 m_rng;
+  std::exponential_distribution<double> m_gap;
+};
+
+} // namespace astra::loadgen
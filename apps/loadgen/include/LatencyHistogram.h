@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace astra::loadgen {
+
+// HDR histogram: values from 1 up to a highest trackable value, each kept
+// to a fixed number of significant decimal digits. Buckets double in
+// width, so memory grows with the log of the range rather than the range,
+// and recording is a couple of shifts and an increment. Values above the
+// highest trackable one are clamped to it.
+//
+// Not thread-safe; record into one per thread and merge().
+class LatencyHistogram {
+public:
+  // Throws std::invalid_argument unless 1 <= significant_digits <= 5 and
+  // highest_trackable >= 2
+  LatencyHistogram(uint64_t highest_trackable, int significant_digits = 3);
+
+  void record(uint64_t value, uint64_t count = 1);
+  // Throws std::invalid_argument when the layouts differ
+  void merge(const LatencyHistogram &other);
+
+  [[nodiscard]] uint64_t count() const noexcept {
+    return m_total;
+  }
+  [[nodiscard]] uint64_t min() const noexcept {
+    return m_total > 0 ? m_min : 0;
+  }
+  [[nodiscard]] uint64_t max() const noexcept {
+    return m_max;
+  }
+  [[nodiscard]] double mean() const noexcept;
+  // Highest value equivalent to the one at `percentile` (0-100)
+  [[nodiscard]] uint64_t value_at_percentile(double percentile) const;
+
+private:
+  [[nodiscard]] size_t index_of(uint64_t value) const noexcept;
+  [[nodiscard]] uint64_t highest_equivalent(size_t index) const noexcept;
+
+  uint64_t m_highest;
+  int m_digits;
+  int m_sub_bucket_half_magnitude;
+  uint64_t m_sub_bucket_half_count;
+  uint64_t m_sub_bucket_mask;
+  std::vector<uint64_t> m_counts;
+
+  uint64_t m_total = 0;
+  uint64_t m_min = UINT64_MAX;
+  uint64_t m_max = 0;
+  long double m_sum = 0;
+};
+
+} // namespace astra::loadgen
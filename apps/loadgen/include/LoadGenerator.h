@@ -0,0 +1,84 @@
+#pragma once
+
+#include "ArrivalSchedule.h"
+#include "LatencyHistogram.h"
+
+#include <HeaderBlock.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace astra::loadgen {
+
+struct LoadConfig {
+  std::string host = "127.0.0.1";
+  uint16_t port = 8081;
+  std::string method = "GET";
+  std::string path = "/health";
+  std::string body;
+  astra::utils::HeaderBlock headers;
+
+  // Offered load, independent of how fast responses come back
+  double rate = 1000;
+  ArrivalSchedule::Kind arrival = ArrivalSchedule::Kind::Constant;
+  uint64_t seed = 1;
+  // Sent but not recorded, so connection setup stays out of the numbers
+  std::chrono::milliseconds warmup{0};
+  std::chrono::milliseconds duration{10000};
+  // Requests are spread round-robin over this many HTTP/2 connections
+  size_t connections = 1;
+
+  std::chrono::milliseconds connect_timeout{2000};
+  std::chrono::milliseconds request_timeout{5000};
+  // How long to wait for stragglers after the last send
+  std::chrono::milliseconds drain{5000};
+};
+
+struct LoadReport {
+  // Microseconds, 3 significant digits, up to a minute
+  static constexpr uint64_t kHighestLatencyUs = 60'000'000;
+
+  LoadConfig config;
+
+  uint64_t sent = 0;
+  uint64_t ok = 0;     // 2xx
+  uint64_t errors = 0; // any other status
+  uint64_t failed = 0; // no response: timeout, reset, connection loss
+  std::map<int, uint64_t> statuses;
+  std::chrono::nanoseconds window{0}; // measured part of the run
+  // Worst gap between a request's scheduled and actual send time
+  std::chrono::nanoseconds max_send_lag{0};
+
+  // From the scheduled send time: includes any time the request spent
+  // waiting behind earlier ones, which is what a real caller would see
+  LatencyHistogram latency{kHighestLatencyUs};
+  // From the actual send time; what a closed-loop tool would report
+  LatencyHistogram service_time{kHighestLatencyUs};
+
+  [[nodiscard]] uint64_t unfinished() const noexcept {
+    return sent - ok - errors - failed;
+  }
+  [[nodiscard]] double offered_rps() const noexcept;
+  [[nodiscard]] double completed_rps() const noexcept;
+
+  [[nodiscard]] std::string to_json() const;
+};
+
+// Open-loop HTTP/2 load: one Http2Client per connection, requests submitted
+// from the calling thread on an ArrivalSchedule, responses recorded on each
+// client's own thread.
+class LoadGenerator {
+public:
+  // Throws std::invalid_argument for a config that cannot run
+  explicit LoadGenerator(LoadConfig config);
+
+  // Blocks for warmup + duration + up to drain
+  LoadReport run();
+
+private:
+  LoadConfig m_config;
+};
+
+} // namespace astra::loadgen
@@ -0,0 +1,143 @@
+#include "LoadGenerator.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace {
+
+using astra::loadgen::ArrivalSchedule;
+using astra::loadgen::LoadConfig;
+using astra::loadgen::LoadGenerator;
+using astra::loadgen::LoadReport;
+
+void usage(const char *program) {
+  std::cerr
+      << "usage: " << program << " [options]\n"
+      << "  --host HOST            target host (127.0.0.1)\n"
+      << "  --port PORT            target port (8081)\n"
+      << "  --method METHOD        request method (GET)\n"
+      << "  --path PATH            request path (/health)\n"
+      << "  --body-file FILE       request body, read once up front\n"
+      << "  --header NAME:VALUE    extra request header, repeatable\n"
+      << "  --rate RPS             offered requests per second (1000)\n"
+      << "  --arrival KIND         constant or poisson (constant)\n"
+      << "  --seed N               seed for poisson arrivals (1)\n"
+      << "  --connections N        HTTP/2 connections (1)\n"
+      << "  --warmup-ms MS         unrecorded lead-in (0)\n"
+      << "  --duration-ms MS       recorded run length (10000)\n"
+      << "  --timeout-ms MS        per-request timeout (5000)\n"
+      << "  --drain-ms MS          wait for stragglers (5000)\n"
+      << "  --output FILE          write the JSON report here, not stdout\n";
+}
+
+std::string read_file(const std::string &path) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    throw std::invalid_argument("cannot read " + path);
+  }
+  std::ostringstream body;
+  body << in.rdbuf();
+  return body.str();
+}
+
+// Throws std::invalid_argument on anything it does not understand
+LoadConfig parse(int argc, char **argv, std::string &output) {
+  LoadConfig config;
+  for (int i = 1; i < argc; ++i) {
+    std::string_view flag = argv[i];
+    if (i + 1 >= argc) {
+      throw std::invalid_argument("missing value for " + std::string(flag));
+    }
+    std::string value = argv[++i];
+
+    if (flag == "--host") {
+      config.host = value;
+    } else if (flag == "--port") {
+      config.port = static_cast<uint16_t>(std::stoul(value));
+    } else if (flag == "--method") {
+      config.method = value;
+    } else if (flag == "--path") {
+      config.path = value;
+    } else if (flag == "--body-file") {
+      config.body = read_file(value);
+    } else if (flag == "--header") {
+      auto colon = value.find(':');
+      if (colon == std::string::npos || colon == 0) {
+        throw std::invalid_argument("header must be NAME:VALUE: " + value);
+      }
+      auto header_value = value.substr(colon + 1);
+      header_value.erase(0, header_value.find_first_not_of(' '));
+      config.headers.set(value.substr(0, colon), std::move(header_value));
+    } else if (flag == "--rate") {
+      config.rate = std::stod(value);
+    } else if (flag == "--arrival") {
+      config.arrival = ArrivalSchedule::parse_kind(value);
+    } else if (flag == "--seed") {
+      config.seed = std::stoull(value);
+    } else if (flag == "--connections") {
+      config.connections = std::stoul(value);
+    } else if (flag == "--warmup-ms") {
+      config.warmup = std::chrono::milliseconds(std::stol(value));
+    } else if (flag == "--duration-ms") {
+      config.duration = std::chrono::milliseconds(std::stol(value));
+    } else if (flag == "--timeout-ms") {
+      config.request_timeout = std::chrono::milliseconds(std::stol(value));
+    } else if (flag == "--drain-ms") {
+      config.drain = std::chrono::milliseconds(std::stol(value));
+    } else if (flag == "--output") {
+      output = value;
+    } else {
+      throw std::invalid_argument("unknown option " + std::string(flag));
+    }
+  }
+  return config;
+}
+
+void summarize(const LoadReport &report) {
+  const auto &latency = report.latency;
+  std::cerr << "sent " << report.sent << ", ok " << report.ok << ", errors "
+            << report.errors << ", failed " << report.failed
+            << ", unfinished " << report.unfinished() << "\n"
+            << "offered " << report.offered_rps() << " rps, completed "
+            << report.completed_rps() << " rps\n"
+            << "latency us: p50 " << latency.value_at_percentile(50)
+            << ", p99 " << latency.value_at_percentile(99) << ", p99.9 "
+            << latency.value_at_percentile(99.9) << ", max " << latency.max()
+            << "\n";
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  std::string output;
+  std::unique_ptr<LoadGenerator> generator;
+  try {
+    generator = std::make_unique<LoadGenerator>(parse(argc, argv, output));
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << "\n";
+    usage(argv[0]);
+    return 2;
+  }
+
+  auto report = generator->run();
+  summarize(report);
+
+  if (output.empty()) {
+    std::cout << report.to_json() << std::endl;
+  } else {
+    std::ofstream out(output);
+    out << report.to_json() << "\n";
+    if (!out) {
+      std::cerr << "cannot write " << output << "\n";
+      return 1;
+    }
+  }
+  // Requests that never finished mean the numbers undercount the tail
+  return report.unfinished() == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,47 @@
+#include "ArrivalSchedule.h"
+
+#include <stdexcept>
+#include <string>
+
+namespace astra::loadgen {
+
+ArrivalSchedule ArrivalSchedule::create(Kind kind, double rate,
+                                        uint64_t seed) {
+  if (!(rate > 0)) {
+    throw std::invalid_argument("rate must be positive");
+  }
+  return ArrivalSchedule(kind, rate, seed);
+}
+
+ArrivalSchedule::Kind ArrivalSchedule::parse_kind(std::string_view name) {
+  if (name == "constant") {
+    return Kind::Constant;
+  }
+  if (name == "poisson") {
+    return Kind::Poisson;
+  }
+  throw std::invalid_argument("unknown arrival schedule: " +
+                              std::string(name));
+}
+
+std::string_view ArrivalSchedule::kind_name(Kind kind) noexcept {
+  return kind == Kind::Constant ? "constant" : "poisson";
+}
+
+ArrivalSchedule::ArrivalSchedule(Kind kind, double rate, uint64_t seed)
+    : m_kind(kind), m_rate(rate), m_rng(seed), m_gap(rate) {
+}
+
+std::chrono::nanoseconds ArrivalSchedule::next() {
+  double seconds = 0;
+  if (m_kind == Kind::Constant) {
+    // From the index rather than a running sum, so rounding cannot drift
+    seconds = static_cast<double>(m_count++) / m_rate;
+  } else {
+    seconds = m_poisson_at;
+    m_poisson_at += m_gap(m_rng);
+  }
+  return std::chrono::nanoseconds(static_cast<int64_t>(seconds * 1e9));
+}
+
+} // namespace astra::loadgen
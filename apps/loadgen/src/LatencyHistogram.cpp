@@ -0,0 +1,114 @@
+#include "LatencyHistogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace astra::loadgen {
+
+namespace {
+
+int bit_length(uint64_t value) {
+  return value == 0 ? 0 : 64 - __builtin_clzll(value);
+}
+
+} // namespace
+
+LatencyHistogram::LatencyHistogram(uint64_t highest_trackable,
+                                   int significant_digits)
+    : m_highest(highest_trackable), m_digits(significant_digits) {
+  if (significant_digits < 1 || significant_digits > 5) {
+    throw std::invalid_argument("significant_digits must be in 1-5");
+  }
+  if (highest_trackable < 2) {
+    throw std::invalid_argument("highest_trackable must be at least 2");
+  }
+
+  // Enough sub-buckets that every value below this one is exact
+  uint64_t single_unit_limit = 2;
+  for (int i = 0; i < significant_digits; ++i) {
+    single_unit_limit *= 10;
+  }
+  int sub_bucket_magnitude = bit_length(single_unit_limit - 1);
+  m_sub_bucket_half_magnitude = sub_bucket_magnitude - 1;
+  uint64_t sub_bucket_count = uint64_t{1} << sub_bucket_magnitude;
+  m_sub_bucket_half_count = sub_bucket_count / 2;
+  m_sub_bucket_mask = sub_bucket_count - 1;
+
+  size_t buckets = 1;
+  for (uint64_t trackable = sub_bucket_count; trackable <= highest_trackable;
+       trackable <<= 1) {
+    ++buckets;
+    if (trackable > (UINT64_MAX >> 1)) {
+      break;
+    }
+  }
+  m_counts.assign((buckets + 1) * m_sub_bucket_half_count, 0);
+}
+
+void LatencyHistogram::record(uint64_t value, uint64_t count) {
+  value = std::min(value, m_highest);
+  m_counts[index_of(value)] += count;
+  m_total += count;
+  m_min = std::min(m_min, value);
+  m_max = std::max(m_max, value);
+  m_sum += static_cast<long double>(value) * count;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram &other) {
+  if (other.m_highest != m_highest || other.m_digits != m_digits) {
+    throw std::invalid_argument("histogram layouts differ");
+  }
+  for (size_t i = 0; i < m_counts.size(); ++i) {
+    m_counts[i] += other.m_counts[i];
+  }
+  m_total += other.m_total;
+  m_min = std::min(m_min, other.m_min);
+  m_max = std::max(m_max, other.m_max);
+  m_sum += other.m_sum;
+}
+
+double LatencyHistogram::mean() const noexcept {
+  return m_total > 0 ? static_cast<double>(m_sum / m_total) : 0.0;
+}
+
+uint64_t LatencyHistogram::value_at_percentile(double percentile) const {
+  if (m_total == 0) {
+    return 0;
+  }
+  percentile = std::clamp(percentile, 0.0, 100.0);
+  auto target = static_cast<uint64_t>(
+      std::ceil(percentile / 100.0 * static_cast<double>(m_total)));
+  target = std::max<uint64_t>(target, 1);
+
+  uint64_t seen = 0;
+  for (size_t i = 0; i < m_counts.size(); ++i) {
+    seen += m_counts[i];
+    if (seen >= target) {
+      return std::min(highest_equivalent(i), m_max);
+    }
+  }
+  return m_max;
+}
+
+size_t LatencyHistogram::index_of(uint64_t value) const noexcept {
+  int bucket = bit_length(value | m_sub_bucket_mask) -
+               (m_sub_bucket_half_magnitude + 1);
+  uint64_t sub_bucket = value >> bucket;
+  return (static_cast<size_t>(bucket + 1) << m_sub_bucket_half_magnitude) +
+         (sub_bucket - m_sub_bucket_half_count);
+}
+
+uint64_t LatencyHistogram::highest_equivalent(size_t index) const noexcept {
+  int bucket = static_cast<int>(index >> m_sub_bucket_half_magnitude) - 1;
+  uint64_t sub_bucket =
+      (index & (m_sub_bucket_half_count - 1)) + m_sub_bucket_half_count;
+  if (bucket < 0) {
+    sub_bucket -= m_sub_bucket_half_count;
+    bucket = 0;
+  }
+  uint64_t lowest = sub_bucket << bucket;
+  return lowest + (uint64_t{1} << bucket) - 1;
+}
+
+} // namespace astra::loadgen
@@ -0,0 +1,239 @@
+#include "LoadGenerator.h"
+
+#include <Http2Client.h>
+#include <JsonWriter.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace astra::loadgen {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+uint64_t to_us(Clock::duration d) {
+  auto us = std::chrono::duration_cast<std::chrono::microseconds>(d).count();
+  return us > 0 ? static_cast<uint64_t>(us) : 0;
+}
+
+// Results of one connection. Its client calls back on a single thread, so
+// the lock is uncontended until the final merge.
+struct Lane {
+  std::mutex mutex;
+  uint64_t ok = 0;
+  uint64_t errors = 0;
+  uint64_t failed = 0;
+  std::map<int, uint64_t> statuses;
+  LatencyHistogram latency{LoadReport::kHighestLatencyUs};
+  LatencyHistogram service_time{LoadReport::kHighestLatencyUs};
+
+  void merge_into(LoadReport &report) {
+    std::lock_guard<std::mutex> lock(mutex);
+    report.ok += ok;
+    report.errors += errors;
+    report.failed += failed;
+    for (const auto &[status, count] : statuses) {
+      report.statuses[status] += count;
+    }
+    report.latency.merge(latency);
+    report.service_time.merge(service_time);
+  }
+};
+
+struct Pending {
+  std::atomic<size_t> count{0};
+  std::mutex mutex;
+  std::condition_variable drained;
+
+  void done() {
+    if (count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      std::lock_guard<std::mutex> lock(mutex);
+      drained.notify_all();
+    }
+  }
+};
+
+void add_histogram(json::JsonWriter &writer, const std::string &key,
+                   const LatencyHistogram &histogram) {
+  writer.start_object(key);
+  writer.add("count", static_cast<unsigned long>(histogram.count()));
+  writer.add("min", static_cast<unsigned long>(histogram.min()));
+  writer.add("mean", histogram.mean());
+  for (auto [name, percentile] : {std::pair{"p50", 50.0},
+                                  {"p75", 75.0},
+                                  {"p90", 90.0},
+                                  {"p99", 99.0},
+                                  {"p99_9", 99.9},
+                                  {"p99_99", 99.99}}) {
+    writer.add(name, static_cast<unsigned long>(
+                         histogram.value_at_percentile(percentile)));
+  }
+  writer.add("max", static_cast<unsigned long>(histogram.max()));
+  writer.end_object();
+}
+
+} // namespace
+
+double LoadReport::offered_rps() const noexcept {
+  auto seconds = std::chrono::duration<double>(window).count();
+  return seconds > 0 ? static_cast<double>(sent) / seconds : 0.0;
+}
+
+double LoadReport::completed_rps() const noexcept {
+  auto seconds = std::chrono::duration<double>(window).count();
+  return seconds > 0 ? static_cast<double>(ok + errors) / seconds : 0.0;
+}
+
+std::string LoadReport::to_json() const {
+  json::JsonWriter writer;
+
+  writer.start_object("target");
+  writer.add("host", config.host);
+  writer.add("port", static_cast<int>(config.port));
+  writer.add("method", config.method);
+  writer.add("path", config.path);
+  writer.end_object();
+
+  writer.start_object("load");
+  writer.add("arrival", std::string(ArrivalSchedule::kind_name(config.arrival)));
+  writer.add("rate", config.rate);
+  writer.add("connections", static_cast<unsigned long>(config.connections));
+  writer.add("warmup_ms", static_cast<long>(config.warmup.count()));
+  writer.add("duration_ms", static_cast<long>(config.duration.count()));
+  writer.end_object();
+
+  writer.start_object("requests");
+  writer.add("sent", static_cast<unsigned long>(sent));
+  writer.add("ok", static_cast<unsigned long>(ok));
+  writer.add("errors", static_cast<unsigned long>(errors));
+  writer.add("failed", static_cast<unsigned long>(failed));
+  writer.add("unfinished", static_cast<unsigned long>(unfinished()));
+  writer.end_object();
+
+  writer.start_object("status_codes");
+  for (const auto &[status, count] : statuses) {
+    writer.add(std::to_string(status), static_cast<unsigned long>(count));
+  }
+  writer.end_object();
+
+  writer.add("offered_rps", offered_rps());
+  writer.add("completed_rps", completed_rps());
+  writer.add("max_send_lag_us",
+             static_cast<unsigned long>(to_us(max_send_lag)));
+  add_histogram(writer, "latency_us", latency);
+  add_histogram(writer, "service_time_us", service_time);
+  return writer.get_string();
+}
+
+LoadGenerator::LoadGenerator(LoadConfig config) : m_config(std::move(config)) {
+  if (!(m_config.rate > 0)) {
+    throw std::invalid_argument("rate must be positive");
+  }
+  if (m_config.connections == 0) {
+    throw std::invalid_argument("connections must be at least 1");
+  }
+  if (m_config.duration.count() <= 0) {
+    throw std::invalid_argument("duration must be positive");
+  }
+  if (m_config.warmup.count() < 0) {
+    throw std::invalid_argument("warmup must not be negative");
+  }
+}
+
+LoadReport LoadGenerator::run() {
+  const auto &config = m_config;
+
+  http2::ClientConfig client_config;
+  client_config.set_connect_timeout_ms(
+      static_cast<uint32_t>(config.connect_timeout.count()));
+  client_config.set_request_timeout_ms(
+      static_cast<uint32_t>(config.request_timeout.count()));
+
+  std::vector<std::unique_ptr<http2::Http2Client>> clients;
+  std::vector<std::shared_ptr<Lane>> lanes;
+  for (size_t i = 0; i < config.connections; ++i) {
+    clients.push_back(std::make_unique<http2::Http2Client>(client_config));
+    lanes.push_back(std::make_shared<Lane>());
+  }
+  auto pending = std::make_shared<Pending>();
+  auto schedule =
+      ArrivalSchedule::create(config.arrival, config.rate, config.seed);
+
+  LoadReport report;
+  report.config = config;
+
+  const auto start = Clock::now();
+  const auto record_from = start + config.warmup;
+  const auto end = record_from + config.duration;
+  size_t next_lane = 0;
+
+  while (true) {
+    const auto due = start + schedule.next();
+    if (due >= end) {
+      break;
+    }
+    auto now = Clock::now();
+    if (due > now) {
+      std::this_thread::sleep_until(due);
+      now = Clock::now();
+    }
+
+    const bool measured = due >= record_from;
+    if (measured) {
+      ++report.sent;
+      report.max_send_lag = std::max(report.max_send_lag, now - due);
+    }
+
+    auto lane = lanes[next_lane];
+    auto &client = *clients[next_lane];
+    next_lane = (next_lane + 1) % clients.size();
+
+    pending->count.fetch_add(1, std::memory_order_relaxed);
+    client.submit(
+        config.host, config.port, config.method, config.path, config.body,
+        config.headers,
+        [lane, pending, due, sent_at = now, measured](auto result) {
+          const auto done = Clock::now();
+          if (measured) {
+            std::lock_guard<std::mutex> lock(lane->mutex);
+            if (result.is_err()) {
+              ++lane->failed;
+            } else {
+              int status = result.value().status_code();
+              ++lane->statuses[status];
+              if (status >= 200 && status < 300) {
+                ++lane->ok;
+              } else {
+                ++lane->errors;
+              }
+              lane->latency.record(to_us(done - due));
+              lane->service_time.record(to_us(done - sent_at));
+            }
+          }
+          pending->done();
+        });
+  }
+  // A sender that fell behind stretched the run; rates use the real span
+  report.window = std::max<Clock::duration>(config.duration,
+                                            Clock::now() - record_from);
+
+  {
+    std::unique_lock<std::mutex> lock(pending->mutex);
+    pending->drained.wait_for(lock, config.drain, [&pending]() {
+      return pending->count.load(std::memory_order_acquire) == 0;
+    });
+  }
+
+  for (auto &lane : lanes) {
+    lane->merge_into(report);
+  }
+  return report;
+}
+
+} // namespace astra::loadgen
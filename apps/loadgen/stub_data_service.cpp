@@ -0,0 +1,69 @@
+// Canned HTTP/2 data service for load tests: answers the calls the URI
+// shortener makes with fixed bodies, so a run measures the shortener and
+// not a real store. Stops on SIGINT/SIGTERM.
+#include <Http2Server.h>
+#include <PreparedResponse.h>
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <pthread.h>
+#include <string>
+
+namespace {
+
+using astra::router::IRequest;
+using astra::router::IResponse;
+using astra::router::PreparedResponse;
+
+astra::router::Handler reply(std::shared_ptr<const PreparedResponse> prepared) {
+  return [prepared = std::move(prepared)](std::shared_ptr<IRequest>,
+                                          std::shared_ptr<IResponse> res) {
+    res->send_prepared(prepared);
+  };
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  astra::http2::ServerConfig config;
+  config.set_address("127.0.0.1");
+  config.set_port(argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 8080);
+  config.set_thread_count(argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2]))
+                                   : 1);
+  config.set_max_concurrent_streams(1000);
+
+  // Blocked before the server spawns its threads, so only sigwait sees them
+  sigset_t signals;
+  sigemptyset(&signals);
+  sigaddset(&signals, SIGINT);
+  sigaddset(&signals, SIGTERM);
+  pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+  astra::http2::Http2Server server(config);
+  auto &router = server.router();
+
+  const astra::utils::HeaderBlock json{{"content-type", "application/json"}};
+  auto created = PreparedResponse::create(
+      201, json, R"({"id":"abc123","status":"created"})");
+  auto found = PreparedResponse::create(
+      200, json, R"({"url":"https://example.com","active":true})");
+
+  router.post("/api/v1/links", reply(created));
+  router.get("/api/v1/links/:id", reply(found));
+  router.del("/api/v1/links/:id", reply(found));
+  router.get("/health", reply(PreparedResponse::create(
+                            200, json, R"({"status":"ok"})")));
+
+  if (server.start().is_err()) {
+    std::cerr << "cannot listen on port " << config.port() << "\n";
+    return EXIT_FAILURE;
+  }
+  std::cerr << "stub data service on 127.0.0.1:" << config.port() << "\n";
+
+  int signal = 0;
+  sigwait(&signals, &signal);
+  server.stop();
+  server.join();
+  return EXIT_SUCCESS;
+}
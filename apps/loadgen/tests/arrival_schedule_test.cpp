@@ -0,0 +1,57 @@
+#include "ArrivalSchedule.h"
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+using astra::loadgen::ArrivalSchedule;
+using namespace std::chrono_literals;
+
+TEST(ArrivalScheduleTest, ConstantIsEvenlySpaced) {
+  auto schedule = ArrivalSchedule::create(ArrivalSchedule::Kind::Constant, 1000);
+
+  EXPECT_EQ(schedule.next(), 0ns);
+  EXPECT_EQ(schedule.next(), 1ms);
+  EXPECT_EQ(schedule.next(), 2ms);
+  for (int i = 3; i < 1000; ++i) {
+    schedule.next();
+  }
+  EXPECT_EQ(schedule.next(), 1s);
+}
+
+TEST(ArrivalScheduleTest, PoissonMeanRateMatches) {
+  auto schedule =
+      ArrivalSchedule::create(ArrivalSchedule::Kind::Poisson, 10'000, 42);
+
+  std::chrono::nanoseconds last{0};
+  for (int i = 0; i < 100'000; ++i) {
+    auto at = schedule.next();
+    ASSERT_GE(at, last);
+    last = at;
+  }
+  // 100k arrivals at 10k/s: about 10s, well within 2%
+  EXPECT_NEAR(std::chrono::duration<double>(last).count(), 10.0, 0.2);
+}
+
+TEST(ArrivalScheduleTest, PoissonIsReproducibleBySeed) {
+  auto a = ArrivalSchedule::create(ArrivalSchedule::Kind::Poisson, 500, 7);
+  auto b = ArrivalSchedule::create(ArrivalSchedule::Kind::Poisson, 500, 7);
+  auto c = ArrivalSchedule::create(ArrivalSchedule::Kind::Poisson, 500, 8);
+
+  bool differs = false;
+  for (int i = 0; i < 100; ++i) {
+    auto next_a = a.next();
+    EXPECT_EQ(next_a, b.next());
+    differs = differs || next_a != c.next();
+  }
+  EXPECT_TRUE(differs);
+}
+
+TEST(ArrivalScheduleTest, RejectsBadInput) {
+  EXPECT_THROW(ArrivalSchedule::create(ArrivalSchedule::Kind::Constant, 0),
+               std::invalid_argument);
+  EXPECT_THROW(ArrivalSchedule::create(ArrivalSchedule::Kind::Poisson, -1),
+               std::invalid_argument);
+  EXPECT_THROW(ArrivalSchedule::parse_kind("bursty"), std::invalid_argument);
+  EXPECT_EQ(ArrivalSchedule::parse_kind("poisson"),
+            ArrivalSchedule::Kind::Poisson);
+}
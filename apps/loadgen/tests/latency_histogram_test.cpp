@@ -0,0 +1,82 @@
+#include "LatencyHistogram.h"
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+using astra::loadgen::LatencyHistogram;
+
+TEST(LatencyHistogramTest, SmallValuesAreExact) {
+  LatencyHistogram histogram(3'600'000'000, 3);
+  for (uint64_t v = 1; v <= 1000; ++v) {
+    histogram.record(v);
+  }
+
+  EXPECT_EQ(histogram.count(), 1000u);
+  EXPECT_EQ(histogram.min(), 1u);
+  EXPECT_EQ(histogram.max(), 1000u);
+  EXPECT_EQ(histogram.value_at_percentile(50), 500u);
+  EXPECT_EQ(histogram.value_at_percentile(99), 990u);
+  EXPECT_EQ(histogram.value_at_percentile(100), 1000u);
+  EXPECT_DOUBLE_EQ(histogram.mean(), 500.5);
+}
+
+TEST(LatencyHistogramTest, LargeValuesKeepSignificantDigits) {
+  LatencyHistogram histogram(3'600'000'000, 3);
+  const uint64_t value = 123'456'789;
+  histogram.record(value);
+
+  auto reported = histogram.value_at_percentile(50);
+  // Three significant digits: within 0.1% of the recorded value
+  EXPECT_GE(reported, value * 999 / 1000);
+  EXPECT_LE(reported, value * 1001 / 1000);
+}
+
+TEST(LatencyHistogramTest, TailIsNotHiddenByTheBulk) {
+  LatencyHistogram histogram(60'000'000, 3);
+  histogram.record(100, 9990);
+  histogram.record(50'000, 10);
+
+  EXPECT_EQ(histogram.value_at_percentile(99), 100u);
+  EXPECT_GE(histogram.value_at_percentile(99.95), 49'950u);
+  EXPECT_EQ(histogram.max(), 50'000u);
+}
+
+TEST(LatencyHistogramTest, ClampsAboveHighestTrackable) {
+  LatencyHistogram histogram(1000, 2);
+  histogram.record(5000);
+
+  EXPECT_EQ(histogram.max(), 1000u);
+  EXPECT_LE(histogram.value_at_percentile(100), 1000u);
+}
+
+TEST(LatencyHistogramTest, MergeAddsCounts) {
+  LatencyHistogram a(1'000'000, 3);
+  LatencyHistogram b(1'000'000, 3);
+  a.record(10, 5);
+  b.record(20, 5);
+
+  a.merge(b);
+  EXPECT_EQ(a.count(), 10u);
+  EXPECT_EQ(a.min(), 10u);
+  EXPECT_EQ(a.max(), 20u);
+  EXPECT_EQ(a.value_at_percentile(50), 10u);
+  EXPECT_EQ(a.value_at_percentile(60), 20u);
+}
+
+TEST(LatencyHistogramTest, RejectsBadLayouts) {
+  EXPECT_THROW(LatencyHistogram(1000, 0), std::invalid_argument);
+  EXPECT_THROW(LatencyHistogram(1000, 6), std::invalid_argument);
+  EXPECT_THROW(LatencyHistogram(1, 3), std::invalid_argument);
+
+  LatencyHistogram a(1000, 3);
+  LatencyHistogram b(2000, 3);
+  EXPECT_THROW(a.merge(b), std::invalid_argument);
+}
+
+TEST(LatencyHistogramTest, EmptyReportsZero) {
+  LatencyHistogram histogram(1000, 3);
+  EXPECT_EQ(histogram.count(), 0u);
+  EXPECT_EQ(histogram.min(), 0u);
+  EXPECT_EQ(histogram.value_at_percentile(99), 0u);
+  EXPECT_EQ(histogram.mean(), 0.0);
+}
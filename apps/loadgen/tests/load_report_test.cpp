@@ -0,0 +1,64 @@
+#include "LoadGenerator.h"
+
+#include <JsonDocument.h>
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+using astra::loadgen::LoadConfig;
+using astra::loadgen::LoadGenerator;
+using astra::loadgen::LoadReport;
+using namespace std::chrono_literals;
+
+TEST(LoadReportTest, RatesUseTheMeasuredWindow) {
+  LoadReport report;
+  report.sent = 1000;
+  report.ok = 900;
+  report.errors = 50;
+  report.failed = 10;
+  report.window = 2s;
+
+  EXPECT_EQ(report.unfinished(), 40u);
+  EXPECT_DOUBLE_EQ(report.offered_rps(), 500.0);
+  EXPECT_DOUBLE_EQ(report.completed_rps(), 475.0);
+}
+
+TEST(LoadReportTest, JsonCarriesCountsAndPercentiles) {
+  LoadReport report;
+  report.config.path = "/shorten";
+  report.config.arrival = astra::loadgen::ArrivalSchedule::Kind::Poisson;
+  report.sent = 3;
+  report.ok = 2;
+  report.errors = 1;
+  report.statuses = {{200, 2}, {503, 1}};
+  report.window = 1s;
+  report.latency.record(100);
+  report.latency.record(200);
+  report.latency.record(5000);
+
+  auto doc = astra::json::JsonDocument::parse(report.to_json());
+  EXPECT_EQ(doc.get_child("target").get_string("path"), "/shorten");
+  EXPECT_EQ(doc.get_child("load").get_string("arrival"), "poisson");
+  EXPECT_EQ(doc.get_child("requests").get_uint64("sent"), 3u);
+  EXPECT_EQ(doc.get_child("requests").get_uint64("unfinished"), 0u);
+  EXPECT_EQ(doc.get_child("status_codes").get_uint64("503"), 1u);
+
+  auto latency = doc.get_child("latency_us");
+  EXPECT_EQ(latency.get_uint64("count"), 3u);
+  EXPECT_EQ(latency.get_uint64("p50"), 200u);
+  EXPECT_EQ(latency.get_uint64("max"), 5000u);
+  EXPECT_EQ(doc.get_child("service_time_us").get_uint64("count"), 0u);
+}
+
+TEST(LoadGeneratorTest, RejectsConfigsThatCannotRun) {
+  LoadConfig no_rate;
+  no_rate.rate = 0;
+  EXPECT_THROW(LoadGenerator{no_rate}, std::invalid_argument);
+
+  LoadConfig no_connections;
+  no_connections.connections = 0;
+  EXPECT_THROW(LoadGenerator{no_connections}, std::invalid_argument);
+
+  LoadConfig no_duration;
+  no_duration.duration = 0ms;
+  EXPECT_THROW(LoadGenerator{no_duration}, std::invalid_argument);
+}
@@ -3,11 +3,14 @@
 #include "Result.h"
 #include "uri_shortener.pb.h"
 
+#include <chrono>
 #include <cstdlib>
 #include <fstream>
 #include <google/protobuf/util/json_util.h>
 #include <iostream>
 #include <optional>
+#include <resilience/policy/CriticalityPolicy.h>
+#include <resilience/policy/HedgingPolicy.h>
 #include <sstream>
 #include <string>
 
@@ -17,6 +20,8 @@ using ConfigResult = astra::outcome::Result<Config, std::string>;
 
 class ProtoConfigLoader {
 public:
+  static constexpr const char *kDefaultPath = "config/uri_shortener.json";
+
   static ConfigResult loadFromFile(const std::string &path) {
     std::ifstream file(path);
     if (!file.is_open()) {
@@ -29,7 +34,7 @@ public:
   }
 
   static ConfigResult load() {
-    return loadFromFile("config/uri_shortener.json");
+    return loadFromFile(kDefaultPath);
   }
 
   static ConfigResult loadFromString(const std::string &json) {
@@ -77,6 +82,50 @@ private:
           return "Invalid trace_sample_rate: must be 0.0-1.0";
         }
       }
+
+      for (const auto &[name, bulkhead] :
+           bootstrap.dataservice().resilience().bulkheads()) {
+        if (bulkhead.max_concurrent() == 0) {
+          return "Invalid bulkheads." + name + ".max_concurrent: must be > 0";
+        }
+      }
+
+      const auto &hedging = bootstrap.dataservice().resilience().hedging();
+      if (hedging.quantile() < 0.0 || hedging.quantile() >= 1.0) {
+        return "Invalid hedging.quantile: must be 0.0-1.0 (exclusive)";
+      }
+      if (hedging.budget_ratio() < 0.0 || hedging.budget_ratio() > 1.0) {
+        return "Invalid hedging.budget_ratio: must be 0.0-1.0";
+      }
+      // Unset (0) max_delay_ms takes HedgingPolicy's default
+      auto max_delay = hedging.max_delay_ms() > 0
+                           ? std::chrono::milliseconds(hedging.max_delay_ms())
+                           : astra::resilience::HedgingPolicy{}.max_delay;
+      if (std::chrono::milliseconds(hedging.min_delay_ms()) > max_delay) {
+        return "Invalid hedging.min_delay_ms: must not exceed max_delay_ms";
+      }
+    }
+
+    if (config.has_runtime() && config.runtime().has_load_shedder()) {
+      const auto &shedder = config.runtime().load_shedder();
+      if (shedder.default_share() < 0.0 || shedder.default_share() > 1.0) {
+        return "Invalid load_shedder.default_share: must be 0.0-1.0";
+      }
+      if (shedder.sheddable_share() < 0.0 || shedder.sheddable_share() > 1.0) {
+        return "Invalid load_shedder.sheddable_share: must be 0.0-1.0";
+      }
+      // Unset (0) shares take CriticalityPolicy's defaults
+      astra::resilience::CriticalityPolicy defaults;
+      double default_share = shedder.default_share() > 0.0
+                                 ? shedder.default_share()
+                                 : defaults.default_share;
+      double sheddable_share = shedder.sheddable_share() > 0.0
+                                   ? shedder.sheddable_share()
+                                   : defaults.sheddable_share;
+      if (sheddable_share > default_share) {
+        return "Invalid load_shedder.sheddable_share: must not exceed "
+               "default_share";
+      }
     }
 
     return std::nullopt;
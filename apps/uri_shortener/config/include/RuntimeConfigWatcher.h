@@ -0,0 +1,79 @@
+#pragma once
+
+#include "uri_shortener.pb.h"
+
+#include <AtomicSnapshot.h>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace uri_shortener {
+
+/// Describes one accepted RuntimeConfig reload
+struct RuntimeConfigChange {
+  const RuntimeConfig &previous;
+  const RuntimeConfig &current;
+  std::vector<std::string> changed_fields; // Top-level RuntimeConfig fields
+
+  [[nodiscard]] bool changed(const std::string &field) const;
+};
+
+/// Watches the config file and hot-reloads its RuntimeConfig section.
+///
+/// Reloads are triggered by inotify events on the file (the parent directory
+/// is watched so atomic rename-into-place updates are seen) and by SIGHUP.
+/// Each reload re-parses and validates the whole file with ProtoConfigLoader;
+/// invalid files are rejected and the current snapshot is kept. Accepted
+/// changes are published as a new immutable snapshot and pushed to
+/// subscribers on the watcher thread. BootstrapConfig changes are ignored
+/// and require a restart.
+class RuntimeConfigWatcher {
+public:
+  using Subscriber = std::function<void(const RuntimeConfigChange &)>;
+
+  RuntimeConfigWatcher(std::string path, RuntimeConfig initial);
+  ~RuntimeConfigWatcher();
+
+  RuntimeConfigWatcher(const RuntimeConfigWatcher &) = delete;
+  RuntimeConfigWatcher &operator=(const RuntimeConfigWatcher &) = delete;
+
+  /// Subscribers must be registered before start()
+  void subscribe(Subscriber subscriber);
+
+  /// Start the watcher thread and install the SIGHUP handler
+  bool start();
+  void stop();
+
+  /// Re-read the file now. Returns true if a change was published.
+  bool reload();
+
+  /// Shared reference to the current runtime config; stays valid across
+  /// reloads for as long as the caller holds it
+  [[nodiscard]] std::shared_ptr<const RuntimeConfig> current() const {
+    return m_snapshot.load();
+  }
+
+  [[nodiscard]] const std::string &path() const noexcept {
+    return m_path;
+  }
+
+private:
+  void run();
+
+  std::string m_path;
+  astra::utils::AtomicSnapshot<RuntimeConfig> m_snapshot;
+  std::vector<Subscriber> m_subscribers;
+  std::mutex m_reload_mutex;
+
+  int m_inotify_fd{-1};
+  int m_stop_fd{-1};
+  int m_sighup_fd{-1}; // Set only while this watcher owns SIGHUP
+  std::atomic<bool> m_running{false};
+  std::thread m_thread;
+};
+
+} // namespace uri_shortener
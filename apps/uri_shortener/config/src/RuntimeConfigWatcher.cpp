@@ -0,0 +1,228 @@
+#include "RuntimeConfigWatcher.h"
+
+#include "ProtoConfigLoader.h"
+
+#include <Log.h>
+#include <Metrics.h>
+#include <algorithm>
+#include <csignal>
+#include <google/protobuf/util/message_differencer.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+namespace uri_shortener {
+
+namespace {
+
+// SIGHUP handlers may only touch async-signal-safe state, so the handler
+// just pokes an eventfd that the watcher thread polls.
+std::atomic<int> g_sighup_fd{-1};
+struct sigaction g_previous_sighup {};
+
+void on_sighup(int) {
+  int fd = g_sighup_fd.load(std::memory_order_relaxed);
+  if (fd >= 0) {
+    uint64_t one = 1;
+    [[maybe_unused]] auto n = ::write(fd, &one, sizeof(one));
+  }
+}
+
+void drain(int fd) {
+  uint64_t value = 0;
+  [[maybe_unused]] auto n = ::read(fd, &value, sizeof(value));
+}
+
+std::vector<std::string> diff_fields(const RuntimeConfig &previous,
+                                     const RuntimeConfig &current) {
+  const auto *descriptor = RuntimeConfig::descriptor();
+  std::vector<std::string> changed;
+
+  for (int i = 0; i < descriptor->field_count(); ++i) {
+    google::protobuf::util::MessageDifferencer differencer;
+    for (int j = 0; j < descriptor->field_count(); ++j) {
+      if (j != i) {
+        differencer.IgnoreField(descriptor->field(j));
+      }
+    }
+    if (!differencer.Compare(previous, current)) {
+      changed.push_back(descriptor->field(i)->name());
+    }
+  }
+  return changed;
+}
+
+std::pair<std::string, std::string> split_path(const std::string &path) {
+  auto slash = path.find_last_of('/');
+  if (slash == std::string::npos) {
+    return {".", path};
+  }
+  return {slash == 0 ? "/" : path.substr(0, slash), path.substr(slash + 1)};
+}
+
+} // namespace
+
+bool RuntimeConfigChange::changed(const std::string &field) const {
+  return std::find(changed_fields.begin(), changed_fields.end(), field) !=
+         changed_fields.end();
+}
+
+RuntimeConfigWatcher::RuntimeConfigWatcher(std::string path,
+                                           RuntimeConfig initial)
+    : m_path(std::move(path)), m_snapshot(std::move(initial)) {
+}
+
+RuntimeConfigWatcher::~RuntimeConfigWatcher() {
+  stop();
+}
+
+void RuntimeConfigWatcher::subscribe(Subscriber subscriber) {
+  m_subscribers.push_back(std::move(subscriber));
+}
+
+bool RuntimeConfigWatcher::start() {
+  if (m_running.load(std::memory_order_acquire)) {
+    return true;
+  }
+
+  m_stop_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  int sighup_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  m_inotify_fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (m_stop_fd < 0 || sighup_fd < 0 || m_inotify_fd < 0) {
+    obs::error("Config watcher failed to create file descriptors");
+    for (int fd : {m_stop_fd, sighup_fd, m_inotify_fd}) {
+      if (fd >= 0) {
+        ::close(fd);
+      }
+    }
+    m_stop_fd = m_inotify_fd = -1;
+    return false;
+  }
+
+  auto [dir, file] = split_path(m_path);
+  if (::inotify_add_watch(m_inotify_fd, dir.c_str(),
+                          IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE) < 0) {
+    obs::warn("Config watcher cannot watch directory, SIGHUP only",
+              {{"dir", dir}});
+  }
+
+  int expected = -1;
+  if (g_sighup_fd.compare_exchange_strong(expected, sighup_fd)) {
+    m_sighup_fd = sighup_fd;
+    struct sigaction action {};
+    action.sa_handler = on_sighup;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    ::sigaction(SIGHUP, &action, &g_previous_sighup);
+  } else {
+    obs::warn("SIGHUP already owned by another config watcher");
+    ::close(sighup_fd);
+  }
+
+  m_running.store(true, std::memory_order_release);
+  m_thread = std::thread([this]() {
+    run();
+  });
+
+  obs::info("Config watcher started", {{"path", m_path}});
+  return true;
+}
+
+void RuntimeConfigWatcher::stop() {
+  if (!m_running.exchange(false, std::memory_order_acq_rel)) {
+    return;
+  }
+
+  uint64_t one = 1;
+  [[maybe_unused]] auto n = ::write(m_stop_fd, &one, sizeof(one));
+  if (m_thread.joinable()) {
+    m_thread.join();
+  }
+
+  if (m_sighup_fd >= 0) {
+    ::sigaction(SIGHUP, &g_previous_sighup, nullptr);
+    g_sighup_fd.store(-1, std::memory_order_release);
+    ::close(m_sighup_fd);
+  }
+  ::close(m_inotify_fd);
+  ::close(m_stop_fd);
+  m_inotify_fd = m_stop_fd = m_sighup_fd = -1;
+}
+
+void RuntimeConfigWatcher::run() {
+  auto file = split_path(m_path).second;
+
+  pollfd fds[3] = {{m_stop_fd, POLLIN, 0},
+                   {m_inotify_fd, POLLIN, 0},
+                   {m_sighup_fd, POLLIN, 0}};
+
+  while (m_running.load(std::memory_order_acquire)) {
+    if (::poll(fds, m_sighup_fd >= 0 ? 3 : 2, -1) < 0) {
+      continue; // EINTR
+    }
+    if (fds[0].revents & POLLIN) {
+      break;
+    }
+
+    bool triggered = false;
+
+    if (fds[1].revents & POLLIN) {
+      alignas(inotify_event) char buffer[4096];
+      ssize_t len;
+      while ((len = ::read(m_inotify_fd, buffer, sizeof(buffer))) > 0) {
+        for (char *p = buffer; p < buffer + len;) {
+          auto *event = reinterpret_cast<inotify_event *>(p);
+          if (event->len > 0 && file == event->name) {
+            triggered = true;
+          }
+          p += sizeof(inotify_event) + event->len;
+        }
+      }
+    }
+
+    if (m_sighup_fd >= 0 && (fds[2].revents & POLLIN)) {
+      drain(m_sighup_fd);
+      obs::info("SIGHUP received, reloading config");
+      triggered = true;
+    }
+
+    if (triggered) {
+      reload();
+    }
+  }
+}
+
+bool RuntimeConfigWatcher::reload() {
+  std::lock_guard<std::mutex> lock(m_reload_mutex);
+
+  auto result = ProtoConfigLoader::loadFromFile(m_path);
+  if (result.is_err()) {
+    obs::counter("config.reload.rejected").inc();
+    obs::warn("Config reload rejected, keeping current config",
+              {{"path", m_path}, {"error", result.error()}});
+    return false;
+  }
+
+  RuntimeConfig next = result.value().runtime();
+  auto changed = diff_fields(*m_snapshot.load(), next);
+  if (changed.empty()) {
+    return false;
+  }
+
+  auto previous = m_snapshot.publish(std::move(next));
+  auto current = m_snapshot.load();
+  RuntimeConfigChange change{*previous, *current, std::move(changed)};
+
+  obs::counter("config.reload.applied").inc();
+  for (const auto &field : change.changed_fields) {
+    obs::info("Runtime config changed", {{"field", field}});
+  }
+
+  for (const auto &subscriber : m_subscribers) {
+    subscriber(change);
+  }
+  return true;
+}
+
+} // namespace uri_shortener
@@ -141,6 +141,105 @@ TEST(ProtoConfigLoaderTest, AllowsValidTraceSampleRate) {
   ASSERT_TRUE(result.is_ok()) << result.error();
 }
 
+TEST(ProtoConfigLoaderTest, ValidatesLoadShedderShares) {
+  const char *json = R"({
+        "schema_version": 1,
+        "runtime": {
+            "load_shedder": {"max_concurrent_requests": 100, "sheddable_share": 1.2}
+        }
+    })";
+
+  auto result = ProtoConfigLoader::loadFromString(json);
+
+  EXPECT_TRUE(result.is_err());
+  EXPECT_NE(result.error().find("sheddable_share"), std::string::npos);
+}
+
+TEST(ProtoConfigLoaderTest, RejectsSheddableShareAboveDefaultShare) {
+  const char *json = R"({
+        "schema_version": 1,
+        "runtime": {
+            "load_shedder": {"default_share": 0.6, "sheddable_share": 0.9}
+        }
+    })";
+
+  auto result = ProtoConfigLoader::loadFromString(json);
+
+  EXPECT_TRUE(result.is_err());
+  EXPECT_NE(result.error().find("sheddable_share"), std::string::npos);
+}
+
+TEST(ProtoConfigLoaderTest, AllowsValidLoadShedderShares) {
+  const char *json = R"({
+        "schema_version": 1,
+        "runtime": {
+            "load_shedder": {"default_share": 0.95, "sheddable_share": 0.8}
+        }
+    })";
+
+  auto result = ProtoConfigLoader::loadFromString(json);
+
+  ASSERT_TRUE(result.is_ok()) << result.error();
+  EXPECT_DOUBLE_EQ(result.value().runtime().load_shedder().sheddable_share(),
+                   0.8);
+}
+
+TEST(ProtoConfigLoaderTest, ValidatesBulkheadConcurrency) {
+  const char *json = R"({
+        "schema_version": 1,
+        "bootstrap": {
+            "dataservice": {
+                "resilience": {
+                    "bulkheads": {"find": {"max_concurrent": 0, "max_queue": 8}}
+                }
+            }
+        }
+    })";
+
+  auto result = ProtoConfigLoader::loadFromString(json);
+
+  EXPECT_TRUE(result.is_err());
+  EXPECT_NE(result.error().find("bulkheads.find"), std::string::npos);
+}
+
+TEST(ProtoConfigLoaderTest, ValidatesHedgingDelays) {
+  const char *json = R"({
+        "schema_version": 1,
+        "bootstrap": {
+            "dataservice": {
+                "resilience": {
+                    "hedging": {"budget_ratio": 0.05, "min_delay_ms": 50,
+                                "max_delay_ms": 10}
+                }
+            }
+        }
+    })";
+
+  auto result = ProtoConfigLoader::loadFromString(json);
+
+  EXPECT_TRUE(result.is_err());
+  EXPECT_NE(result.error().find("hedging.min_delay_ms"), std::string::npos);
+}
+
+TEST(ProtoConfigLoaderTest, ValidatesHedgingMinDelayAgainstDefaultMax) {
+  // No max_delay_ms means the 1s default, which 5s cannot fit under
+  const char *json = R"({
+        "schema_version": 1,
+        "bootstrap": {
+            "dataservice": {
+                "resilience": {
+                    "hedging": {"budget_ratio": 0.05, "min_delay_ms": 5000}
+                }
+            }
+        }
+    })";
+
+  auto result = ProtoConfigLoader::loadFromString(json);
+
+  EXPECT_TRUE(result.is_err());
+  EXPECT_NE(result.error().find("hedging.min_delay_ms"), std::string::npos);
+}
+
 // =============================================================================
 // FILE LOADING TESTS
 // =============================================================================
@@ -0,0 +1,165 @@
+#include "ProtoConfigLoader.h"
+#include "RuntimeConfigWatcher.h"
+
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <fstream>
+#include <future>
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+namespace uri_shortener::test {
+
+namespace {
+
+std::string config_json(uint32_t max_concurrent, double sheddable_share) {
+  return R"({
+        "schema_version": 1,
+        "runtime": {
+            "load_shedder": {
+                "max_concurrent_requests": )" +
+         std::to_string(max_concurrent) + R"(,
+                "sheddable_share": )" +
+         std::to_string(sheddable_share) + R"(
+            }
+        }
+    })";
+}
+
+} // namespace
+
+class RuntimeConfigWatcherTest : public ::testing::Test {
+protected:
+  std::string m_path;
+
+  void SetUp() override {
+    m_path = "/tmp/runtime_config_watcher_test_" + std::to_string(::getpid()) +
+             ".json";
+    writeFile(config_json(100, 0.8));
+  }
+
+  void TearDown() override {
+    std::remove(m_path.c_str());
+  }
+
+  void writeFile(const std::string &content) {
+    std::ofstream file(m_path);
+    file << content;
+  }
+
+  // Write to a sibling file and rename over the config, as deploy tools do
+  void replaceFile(const std::string &content) {
+    std::string tmp = m_path + ".tmp";
+    {
+      std::ofstream file(tmp);
+      file << content;
+    }
+    std::rename(tmp.c_str(), m_path.c_str());
+  }
+
+  RuntimeConfig initial() {
+    return ProtoConfigLoader::loadFromFile(m_path).value().runtime();
+  }
+};
+
+TEST_F(RuntimeConfigWatcherTest, CurrentStartsWithInitialConfig) {
+  RuntimeConfigWatcher watcher(m_path, initial());
+
+  EXPECT_EQ(watcher.current()->load_shedder().max_concurrent_requests(), 100);
+}
+
+TEST_F(RuntimeConfigWatcherTest, ReloadPublishesChangedFields) {
+  RuntimeConfigWatcher watcher(m_path, initial());
+  std::vector<std::string> seen;
+  uint32_t previous_max = 0;
+  watcher.subscribe([&](const RuntimeConfigChange &change) {
+    seen = change.changed_fields;
+    previous_max = change.previous.load_shedder().max_concurrent_requests();
+  });
+
+  writeFile(config_json(200, 0.8));
+
+  ASSERT_TRUE(watcher.reload());
+  EXPECT_EQ(watcher.current()->load_shedder().max_concurrent_requests(), 200);
+  EXPECT_EQ(previous_max, 100);
+  ASSERT_EQ(seen.size(), 1);
+  EXPECT_EQ(seen[0], "load_shedder");
+}
+
+TEST_F(RuntimeConfigWatcherTest, ReloadWithoutChangeIsNoop) {
+  RuntimeConfigWatcher watcher(m_path, initial());
+  int calls = 0;
+  watcher.subscribe([&](const RuntimeConfigChange &) {
+    ++calls;
+  });
+
+  EXPECT_FALSE(watcher.reload());
+  EXPECT_EQ(calls, 0);
+}
+
+TEST_F(RuntimeConfigWatcherTest, InvalidFileKeepsCurrentConfig) {
+  RuntimeConfigWatcher watcher(m_path, initial());
+  auto before = watcher.current();
+
+  writeFile(config_json(200, 1.5));
+  EXPECT_FALSE(watcher.reload());
+
+  writeFile("{not valid json");
+  EXPECT_FALSE(watcher.reload());
+
+  EXPECT_EQ(watcher.current(), before);
+  EXPECT_EQ(watcher.current()->load_shedder().max_concurrent_requests(), 100);
+}
+
+TEST_F(RuntimeConfigWatcherTest, OldSnapshotStaysValidAfterReload) {
+  RuntimeConfigWatcher watcher(m_path, initial());
+  auto old = watcher.current();
+
+  writeFile(config_json(300, 0.5));
+  ASSERT_TRUE(watcher.reload());
+
+  EXPECT_EQ(old->load_shedder().max_concurrent_requests(), 100);
+  EXPECT_EQ(watcher.current()->load_shedder().max_concurrent_requests(), 300);
+}
+
+TEST_F(RuntimeConfigWatcherTest, FileReplaceTriggersReload) {
+  RuntimeConfigWatcher watcher(m_path, initial());
+  std::promise<uint32_t> applied;
+  watcher.subscribe([&](const RuntimeConfigChange &change) {
+    applied.set_value(change.current.load_shedder().max_concurrent_requests());
+  });
+  ASSERT_TRUE(watcher.start());
+
+  replaceFile(config_json(400, 0.8));
+
+  auto future = applied.get_future();
+  ASSERT_EQ(future.wait_for(std::chrono::seconds(5)),
+            std::future_status::ready);
+  EXPECT_EQ(future.get(), 400);
+  watcher.stop();
+}
+
+TEST_F(RuntimeConfigWatcherTest, SighupTriggersReload) {
+  // The file changed before the watcher started, so no inotify event will
+  // arrive; only SIGHUP can pick it up.
+  auto stale = initial();
+  writeFile(config_json(500, 0.8));
+
+  RuntimeConfigWatcher watcher(m_path, stale);
+  std::promise<uint32_t> applied;
+  watcher.subscribe([&](const RuntimeConfigChange &change) {
+    applied.set_value(change.current.load_shedder().max_concurrent_requests());
+  });
+  ASSERT_TRUE(watcher.start());
+
+  std::raise(SIGHUP);
+
+  auto future = applied.get_future();
+  ASSERT_EQ(future.wait_for(std::chrono::seconds(5)),
+            std::future_status::ready);
+  EXPECT_EQ(future.get(), 500);
+  watcher.stop();
+}
+
+} // namespace uri_shortener::test
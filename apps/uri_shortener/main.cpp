@@ -1,9 +1,15 @@
+#include "UriShortenerApp.h"
 #include "UriShortenerBuilder.h"
 
 #include <Log.h>
 
-int main() {
-  auto result = uri_shortener::UriShortenerBuilder::bootstrap();
+int main(int argc, char **argv) {
+  // Before any thread exists, so none of them can take a shutdown signal
+  uri_shortener::UriShortenerApp::block_shutdown_signals();
+
+  auto result =
+      argc > 1 ? uri_shortener::UriShortenerBuilder::bootstrap(argv[1])
+               : uri_shortener::UriShortenerBuilder::bootstrap();
   if (result.is_err()) {
     obs::error("Failed to start URI Shortener",
                {{"error", uri_shortener::to_string(result.error())}});
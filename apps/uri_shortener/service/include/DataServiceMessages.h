@@ -1,5 +1,6 @@
 #pragma once
 
+#include <Deadline.h>
 #include <IResponse.h>
 #include <functional>
 #include <memory>
@@ -14,10 +15,31 @@ class Span;
 namespace uri_shortener::service {
 
 /// Error codes for infrastructure failures
-enum class InfraError { NONE = 0, CONNECTION_FAILED, TIMEOUT, PROTOCOL_ERROR };
+enum class InfraError {
+  NONE = 0,
+  CONNECTION_FAILED,
+  TIMEOUT,
+  PROTOCOL_ERROR,
+  BULKHEAD_FULL // Rejected locally, the call was never sent
+};
 
 /// Protocol-agnostic operation types
 enum class DataServiceOperation { SAVE, FIND, DELETE, EXISTS };
+constexpr size_t kDataServiceOperationCount = 4;
+
+inline const char *to_string(DataServiceOperation op) {
+  switch (op) {
+  case DataServiceOperation::SAVE:
+    return "save";
+  case DataServiceOperation::FIND:
+    return "find";
+  case DataServiceOperation::DELETE:
+    return "delete";
+  case DataServiceOperation::EXISTS:
+    return "exists";
+  }
+  return "unknown";
+}
 
 /// Protocol-agnostic request to data service
 struct DataServiceRequest {
@@ -26,6 +48,7 @@ struct DataServiceRequest {
   std::string payload;                                // JSON payload for SAVE
   std::shared_ptr<astra::router::IResponse> response; // Response interface
   std::shared_ptr<astra::observability::Span> span;
+  astra::utils::Deadline deadline{}; // Propagated to the data service
 };
 
 /// Protocol-agnostic response from data service
@@ -4,17 +4,50 @@
 #include "IDataServiceAdapter.h"
 #include "IServiceResolver.h"
 
+#include <MetricsRegistry.h>
+#include <array>
+#include <map>
+#include <memory>
+#include <optional>
+#include <resilience/impl/Bulkhead.h>
+#include <resilience/impl/HedgeBudget.h>
+#include <resilience/impl/LatencyTracker.h>
+#include <resilience/policy/HedgingPolicy.h>
 #include <string>
 
 namespace uri_shortener::service {
 
 /// HTTP/2 implementation of the data service adapter
 /// Translates protocol-agnostic requests to HTTP/2 calls
+///
+/// Each operation runs behind its own bulkhead so a slow operation cannot
+/// take every connection slot from the others. Calls beyond a bulkhead's
+/// concurrency and queue bound fail fast with InfraError::BULKHEAD_FULL.
+///
+/// When hedging is configured, a FIND still pending after the observed
+/// latency quantile is sent again (to another endpoint when the resolver
+/// knows several); the first success wins and the other is cancelled, while
+/// a failure waits for the other attempt if one is still running. Hedges
+/// take a free FIND bulkhead slot or are skipped, and are capped by a budget
+/// relative to primary calls so a slow backend does not see its load
+/// doubled.
+///
+/// A request deadline is sent downstream as grpc-timeout and caps the
+/// client timeout; requests whose deadline passed are not sent at all.
 class HttpDataServiceAdapter : public IDataServiceAdapter {
 public:
+  /// Concurrency pool and wait queue bound for one bulkhead
+  struct BulkheadLimits {
+    size_t max_concurrent = 256;
+    size_t max_queue = 512;
+  };
+
   /// Configuration for the adapter
   struct Config {
     std::string base_path = "/api/v1/links"; // Base API path
+    BulkheadLimits bulkhead;                 // Default for every operation
+    std::map<DataServiceOperation, BulkheadLimits> bulkhead_overrides;
+    std::optional<astra::resilience::HedgingPolicy> hedging; // FIND only
   };
 
   /// Construct with Http2 client, service resolver, service name, and config
@@ -33,7 +66,34 @@ public:
   void execute(DataServiceRequest request,
                DataServiceCallback callback) override;
 
+  /// Bulkhead guarding the given operation
+  [[nodiscard]] const astra::resilience::Bulkhead &
+  bulkhead(DataServiceOperation op) const;
+
+  /// Observed FIND latency that drives the hedge delay
+  [[nodiscard]] const astra::resilience::LatencyTracker &
+  find_latency() const noexcept {
+    return m_find_latency;
+  }
+
 private:
+  /// Send the request once its bulkhead admitted it
+  void send(DataServiceRequest request, DataServiceCallback callback,
+            astra::resilience::Bulkhead::Permit permit);
+
+  /// Send a FIND and hedge it if it outlives the latency quantile
+  void send_hedged(const std::string &method, const std::string &path,
+                   const std::string &body,
+                   const astra::utils::HeaderBlock &headers,
+                   astra::utils::Deadline deadline,
+                   astra::http2::ResponseHandler complete);
+
+  /// Translate a client result into a data service response
+  static DataServiceResponse
+  to_response(astra::outcome::Result<astra::http2::Http2ClientResponse,
+                                     astra::http2::Http2ClientError>
+                  result);
+
   /// Translate operation to HTTP method
   static std::string operation_to_method(DataServiceOperation op);
 
@@ -48,6 +108,15 @@ private:
   astra::service_discovery::IServiceResolver &m_resolver;
   std::string m_service_name;
   Config m_config;
+
+  // Indexed by DataServiceOperation; named "<service>.<operation>"
+  std::array<std::unique_ptr<astra::resilience::Bulkhead>,
+             kDataServiceOperationCount>
+      m_bulkheads;
+  std::array<std::string, kDataServiceOperationCount> m_bulkhead_names;
+  astra::resilience::LatencyTracker m_find_latency;
+  astra::resilience::HedgeBudget m_hedge_budget;
+  obs::MetricsRegistry m_metrics;
 };
 
 } // namespace uri_shortener::service
@@ -8,6 +8,11 @@ class UriShortenerApp {
 public:
   explicit UriShortenerApp(UriShortenerComponents components);
 
+  /// Block SIGINT and SIGTERM in the calling thread. Call it first in
+  /// main(), before bootstrap starts executor and exporter threads, so
+  /// every thread inherits the mask and run() alone receives them.
+  static void block_shutdown_signals();
+
   [[nodiscard]] int run();
 
   UriShortenerApp(UriShortenerApp &&) noexcept;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "ProtoConfigLoader.h"
 #include "Result.h"
 #include "UriShortenerApp.h"
 #include "UriShortenerComponents.h"
@@ -23,7 +24,10 @@ inline std::string to_string(BuilderError err) {
 
 class UriShortenerBuilder {
 public:
-  static astra::outcome::Result<UriShortenerApp, BuilderError> bootstrap();
+  /// Load the config from config_path and build the app; the same path is
+  /// watched for hot reloads
+  static astra::outcome::Result<UriShortenerApp, BuilderError>
+  bootstrap(const std::string &config_path = ProtoConfigLoader::kDefaultPath);
 
   explicit UriShortenerBuilder(const Config &config);
 
@@ -31,6 +35,7 @@ public:
   UriShortenerBuilder &backend();
   UriShortenerBuilder &messaging();
   UriShortenerBuilder &resilience();
+  UriShortenerBuilder &hotReload(const std::string &path);
 
   astra::outcome::Result<UriShortenerApp, BuilderError> build();
 
@@ -13,7 +13,7 @@ namespace astra::execution {
 class AffinityExecutor;
 }
 namespace astra::resilience {
-class AtomicLoadShedder;
+class CriticalityLoadShedder;
 }
 
 namespace uri_shortener {
@@ -34,6 +34,7 @@ class UriShortenerMessageHandler;
 class ObservableMessageHandler;
 class UriShortenerRequestHandler;
 class ObservableRequestHandler;
+class RuntimeConfigWatcher;
 
 struct UriShortenerComponents {
   std::shared_ptr<domain::ILinkRepository> repo;
@@ -53,7 +54,8 @@ struct UriShortenerComponents {
   std::unique_ptr<ObservableRequestHandler> obs_req_handler;
 
   std::unique_ptr<astra::http2::Http2Server> server;
-  std::unique_ptr<astra::resilience::AtomicLoadShedder> load_shedder;
+  std::unique_ptr<astra::resilience::CriticalityLoadShedder> load_shedder;
+  std::unique_ptr<RuntimeConfigWatcher> config_watcher;
 
   UriShortenerComponents();
   ~UriShortenerComponents();
@@ -8,7 +8,9 @@
 #include <IMessageHandler.h>
 #include <IRequest.h>
 #include <IResponse.h>
+#include <SingleFlight.h>
 #include <memory>
+#include <vector>
 
 namespace uri_shortener {
 
@@ -19,15 +21,24 @@ public:
 
   void setResponseExecutor(astra::execution::IExecutor &executor);
 
+  /// Coalesce concurrent FINDs of one code into a single downstream call.
+  /// Requires an AffinityExecutor with lane_count lanes delivering both the
+  /// requests and the adapter responses, so each flight stays on one lane.
+  void enableCoalescing(size_t lane_count);
+
   void handle(astra::execution::Message &msg) override;
 
 private:
   void processHttpRequest(std::shared_ptr<astra::router::IRequest> req,
                           std::shared_ptr<astra::router::IResponse> res,
-                          uint64_t affinity_key, obs::Context &trace_ctx);
+                          uint64_t affinity_key, obs::Context &trace_ctx,
+                          astra::utils::Deadline deadline);
 
   void processDataServiceResponse(service::DataServiceResponse &resp);
 
+  void processCoalescedResponse(const std::string &key,
+                                service::DataServiceResponse &resp);
+
   std::string determine_operation(const std::string &method,
                                   const std::string &path);
   service::DataServiceOperation
@@ -35,6 +46,11 @@ private:
 
   std::shared_ptr<service::IDataServiceAdapter> m_adapter;
   astra::execution::IExecutor *m_response_executor{nullptr};
+
+  // One table per lane, only touched from that lane's thread
+  using Flights = astra::execution::SingleFlight<
+      std::shared_ptr<astra::router::IResponse>>;
+  std::vector<Flights> m_flights;
 };
 
 } // namespace uri_shortener
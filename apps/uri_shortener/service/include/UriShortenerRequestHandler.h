@@ -1,25 +1,29 @@
 #pragma once
 
 #include <Context.h>
-#include <IExecutor.h>
 #include <IMessageHandler.h>
 #include <IRequest.h>
 #include <IResponse.h>
+#include <cstdint>
 #include <memory>
 
 namespace uri_shortener {
 
+// Runs on an executor lane: the router offloads the shortener routes there,
+// so the request goes straight to the message handler without another hop.
 class UriShortenerRequestHandler {
 public:
-  explicit UriShortenerRequestHandler(astra::execution::IExecutor &executor);
+  explicit UriShortenerRequestHandler(
+      astra::execution::IMessageHandler &handler);
 
   void handle(std::shared_ptr<astra::router::IRequest> req,
               std::shared_ptr<astra::router::IResponse> res);
 
-private:
-  astra::execution::IExecutor &m_executor;
+  /// Lane key for a request; the offload and the handler must agree on it
+  static uint64_t affinity_key(const astra::router::IRequest &req);
 
-  uint64_t generate_session_id(astra::router::IRequest &req);
+private:
+  astra::execution::IMessageHandler &m_handler;
 };
 
 } // namespace uri_shortener
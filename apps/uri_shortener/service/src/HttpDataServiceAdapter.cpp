@@ -1,15 +1,65 @@
 #include "HttpDataServiceAdapter.h"
 
 #include <Log.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <optional>
 
 namespace uri_shortener::service {
 
+namespace {
+
+using ClientResult = astra::outcome::Result<astra::http2::Http2ClientResponse,
+                                            astra::http2::Http2ClientError>;
+
+/// Shared by the primary and hedged attempts of one FIND; guarded by mutex
+struct HedgeState {
+  std::mutex mutex;
+  bool settled{false};
+  std::array<bool, 2> in_flight{};                       // primary, hedge
+  std::array<astra::http2::RequestHandlePtr, 2> handles; // primary, hedge
+  astra::http2::ResponseHandler complete;
+};
+
+// Transport errors and server errors give way to an attempt still running
+bool failed(const ClientResult &result) {
+  return result.is_err() || result.value().status_code() >= 500;
+}
+
+} // namespace
+
 HttpDataServiceAdapter::HttpDataServiceAdapter(
     astra::http2::Http2Client &http2_client,
     astra::service_discovery::IServiceResolver &resolver,
     std::string service_name, Config config)
     : m_http2_client(http2_client), m_resolver(resolver),
-      m_service_name(std::move(service_name)), m_config(std::move(config)) {
+      m_service_name(std::move(service_name)), m_config(std::move(config)),
+      m_hedge_budget(m_config.hedging ? m_config.hedging->budget_ratio : 0.0) {
+  for (size_t i = 0; i < kDataServiceOperationCount; ++i) {
+    auto op = static_cast<DataServiceOperation>(i);
+    auto it = m_config.bulkhead_overrides.find(op);
+    const auto &limits = it != m_config.bulkhead_overrides.end()
+                             ? it->second
+                             : m_config.bulkhead;
+
+    m_bulkhead_names[i] = m_service_name + "." + to_string(op);
+    m_bulkheads[i] = std::make_unique<astra::resilience::Bulkhead>(
+        astra::resilience::BulkheadPolicy::create(
+            limits.max_concurrent, limits.max_queue, m_bulkhead_names[i]));
+  }
+
+  m_metrics.counter("rejected", "dataservice.bulkhead.rejected")
+      .counter("queued", "dataservice.bulkhead.queued")
+      .gauge("in_flight", "dataservice.bulkhead.in_flight")
+      .gauge("queue_depth", "dataservice.bulkhead.queue_depth")
+      .duration_histogram("queue_wait", "dataservice.bulkhead.queue_wait")
+      .counter("hedge_sent", "dataservice.hedge.sent")
+      .counter("hedge_won", "dataservice.hedge.won")
+      .counter("hedge_budget_exhausted", "dataservice.hedge.budget_exhausted")
+      .counter("hedge_bulkhead_full", "dataservice.hedge.bulkhead_full");
 }
 
 HttpDataServiceAdapter::HttpDataServiceAdapter(
@@ -20,73 +70,312 @@ HttpDataServiceAdapter::HttpDataServiceAdapter(
                              Config{}) {
 }
 
+const astra::resilience::Bulkhead &
+HttpDataServiceAdapter::bulkhead(DataServiceOperation op) const {
+  return *m_bulkheads[static_cast<size_t>(op)];
+}
+
 void HttpDataServiceAdapter::execute(DataServiceRequest request,
                                      DataServiceCallback callback) {
+  size_t index = static_cast<size_t>(request.op);
+  auto &bulkhead = *m_bulkheads[index];
+  const auto &name = m_bulkhead_names[index];
+
+  auto response = request.response;
+  auto span = request.span;
+  auto deadline = request.deadline;
+  auto enqueued_at = std::chrono::steady_clock::now();
+
+  // The budget ran out before a slot freed up
+  auto on_expired = [this, &name, response, span, callback, enqueued_at]() {
+    m_metrics.duration_histogram("queue_wait")
+        .record(std::chrono::steady_clock::now() - enqueued_at,
+                {{"bulkhead", name}});
+    auto ds_resp = to_response(
+        ClientResult::Err(astra::http2::Http2ClientError::RequestTimeout));
+    ds_resp.response = response;
+    ds_resp.span = span;
+    callback(std::move(ds_resp));
+  };
+
+  auto admission = bulkhead.submit(
+      [this, &bulkhead, &name, request = std::move(request), callback,
+       enqueued_at](astra::resilience::Bulkhead::Permit permit) mutable {
+        m_metrics.duration_histogram("queue_wait")
+            .record(std::chrono::steady_clock::now() - enqueued_at,
+                    {{"bulkhead", name}});
+        m_metrics.gauge("queue_depth")
+            .set(static_cast<int64_t>(bulkhead.queued()),
+                 {{"bulkhead", name}});
+        send(std::move(request), std::move(callback), std::move(permit));
+      },
+      deadline.when(), std::move(on_expired));
+
+  switch (admission) {
+  case astra::resilience::Bulkhead::Admission::Started:
+    break;
+  case astra::resilience::Bulkhead::Admission::Queued:
+    m_metrics.counter("queued").inc(1, {{"bulkhead", name}});
+    m_metrics.gauge("queue_depth")
+        .set(static_cast<int64_t>(bulkhead.queued()), {{"bulkhead", name}});
+    break;
+  case astra::resilience::Bulkhead::Admission::Rejected: {
+    m_metrics.counter("rejected").inc(1, {{"bulkhead", name}});
+
+    DataServiceResponse ds_resp;
+    ds_resp.response = std::move(response);
+    ds_resp.span = std::move(span);
+    ds_resp.success = false;
+    ds_resp.infra_error = InfraError::BULKHEAD_FULL;
+    ds_resp.error_message = "Bulkhead full: " + name;
+    callback(std::move(ds_resp));
+    break;
+  }
+  }
+}
+
+void HttpDataServiceAdapter::send(
+    DataServiceRequest request, DataServiceCallback callback,
+    astra::resilience::Bulkhead::Permit permit) {
+  size_t index = static_cast<size_t>(request.op);
+  const auto *bulkhead = m_bulkheads[index].get();
+  const auto *name = &m_bulkhead_names[index];
+  m_metrics.gauge("in_flight")
+      .set(static_cast<int64_t>(bulkhead->in_flight()), {{"bulkhead", *name}});
+
   std::string method = operation_to_method(request.op);
   std::string path = build_path(request.op, request.entity_id);
 
-  std::map<std::string, std::string> headers;
+  astra::utils::HeaderBlock headers;
   headers["Content-Type"] = "application/json";
 
   if (request.span) {
     // Span context for tracing
   }
 
+  if (request.deadline.is_set()) {
+    headers[astra::utils::Deadline::kHeader] =
+        request.deadline.to_grpc_timeout();
+  }
+
   auto response = request.response;
   auto span = request.span;
 
-  auto [host, port] = m_resolver.resolve(m_service_name);
+  // std::function needs a copyable callable, so the permit is shared
+  auto slot = std::make_shared<astra::resilience::Bulkhead::Permit>(
+      std::move(permit));
 
-  m_http2_client.submit(
-      host, port, method, path, request.payload, headers,
-      [callback, response,
-       span](astra::outcome::Result<astra::http2::Http2ClientResponse,
-                                    astra::http2::Http2ClientError>
-                 result) {
-        DataServiceResponse ds_resp;
+  astra::http2::ResponseHandler complete =
+      [this, bulkhead, name, slot, callback, response,
+       span](ClientResult result) mutable {
+        // Free the slot before running the caller's continuation
+        slot.reset();
+        m_metrics.gauge("in_flight")
+            .set(static_cast<int64_t>(bulkhead->in_flight()),
+                 {{"bulkhead", *name}});
+
+        auto ds_resp = to_response(std::move(result));
         ds_resp.response = response;
         ds_resp.span = span;
+        callback(std::move(ds_resp));
+      };
 
-        if (result.is_err()) {
-          ds_resp.success = false;
-          auto err = result.error();
-
-          switch (err) {
-          case astra::http2::Http2ClientError::ConnectionFailed:
-          case astra::http2::Http2ClientError::NotConnected:
-            ds_resp.infra_error = InfraError::CONNECTION_FAILED;
-            ds_resp.error_message = "Connection failed";
-            break;
-          case astra::http2::Http2ClientError::RequestTimeout:
-            ds_resp.infra_error = InfraError::TIMEOUT;
-            ds_resp.error_message = "Request timeout";
-            break;
-          case astra::http2::Http2ClientError::StreamClosed:
-          case astra::http2::Http2ClientError::SubmitFailed:
-            ds_resp.infra_error = InfraError::PROTOCOL_ERROR;
-            ds_resp.error_message = "Protocol error";
-            break;
-          }
-
-          callback(std::move(ds_resp));
-          return;
-        }
-
-        auto resp = result.value();
-        ds_resp.http_status = resp.status_code();
-        ds_resp.payload = resp.body();
-
-        if (resp.status_code() >= 200 && resp.status_code() < 300) {
-          ds_resp.success = true;
-        } else {
-          ds_resp.success = false;
-          ds_resp.domain_error_code =
-              map_http_status_to_error(resp.status_code());
-          ds_resp.error_message = resp.body();
-        }
+  // The budget may have run out while waiting for a bulkhead slot
+  if (request.deadline.expired()) {
+    complete(
+        ClientResult::Err(astra::http2::Http2ClientError::RequestTimeout));
+    return;
+  }
 
-        callback(std::move(ds_resp));
-      });
+  if (request.op == DataServiceOperation::FIND && m_config.hedging) {
+    send_hedged(method, path, request.payload, headers, request.deadline,
+                std::move(complete));
+    return;
+  }
+
+  auto [host, port] = m_resolver.resolve(m_service_name);
+  m_http2_client.submit(host, port, method, path, request.payload, headers,
+                        std::move(complete));
+}
+
+void HttpDataServiceAdapter::send_hedged(
+    const std::string &method, const std::string &path,
+    const std::string &body, const astra::utils::HeaderBlock &headers,
+    astra::utils::Deadline deadline, astra::http2::ResponseHandler complete) {
+  const auto &policy = *m_config.hedging;
+  auto endpoints = m_resolver.resolve_all(m_service_name);
+
+  auto state = std::make_shared<HedgeState>();
+  state->complete = std::move(complete);
+
+  // The first success wins and cancels the other attempt. A failure only
+  // settles the call once no other attempt is left that could still succeed.
+  auto settle = [this, state](size_t attempt, ClientResult result) {
+    astra::http2::RequestHandlePtr other;
+    astra::http2::ResponseHandler complete;
+    {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      state->in_flight[attempt] = false;
+      if (state->settled ||
+          (failed(result) && state->in_flight[1 - attempt])) {
+        return;
+      }
+      state->settled = true;
+      if (state->in_flight[1 - attempt]) {
+        other = state->handles[1 - attempt];
+      }
+      complete = std::move(state->complete);
+    }
+    if (other) {
+      other->cancel();
+    }
+
+    if (attempt == 1 && !failed(result)) {
+      m_metrics.counter("hedge_won").inc();
+    }
+    complete(std::move(result));
+  };
+
+  // Submit one attempt; it counts as in flight before its handler can run
+  auto launch = [this, state, settle, method, path, body](
+                    size_t attempt,
+                    const std::pair<std::string, uint16_t> &endpoint,
+                    const astra::utils::HeaderBlock &attempt_headers,
+                    std::function<void(const ClientResult &)> on_done) {
+    auto handle = m_http2_client.submit(
+        endpoint.first, endpoint.second, method, path, body, attempt_headers,
+        [settle, attempt, on_done](ClientResult result) {
+          on_done(result);
+          settle(attempt, std::move(result));
+        });
+
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->handles[attempt] = handle;
+    if (state->settled && state->in_flight[attempt]) {
+      handle->cancel(); // Lost before the handle was stored
+    }
+  };
+
+  // Only primaries feed the latency estimate, each timed from its own send.
+  // A primary cancelled because the hedge won is recorded at the time it was
+  // dropped: a lower bound, but leaving it out would hide exactly the slow
+  // calls that hedging reacts to.
+  auto primary_started = std::chrono::steady_clock::now();
+  auto record_primary = [this, primary_started](const ClientResult &result) {
+    if (result.is_err() &&
+        result.error() != astra::http2::Http2ClientError::Cancelled) {
+      return;
+    }
+    m_find_latency.record(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - primary_started));
+  };
+
+  m_hedge_budget.on_request();
+  state->in_flight[0] = true; // No callback holds the state yet
+  launch(0, endpoints.front(), headers, record_primary);
+
+  // Until enough samples exist the quantile is noise, so don't hedge
+  if (m_find_latency.sample_count() < policy.min_samples) {
+    return;
+  }
+
+  auto observed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      m_find_latency.quantile(policy.quantile));
+  auto delay = std::clamp(observed, policy.min_delay, policy.max_delay);
+  if (delay >= deadline.remaining()) {
+    return; // A hedge could not answer in time
+  }
+
+  auto hedge_endpoint = endpoints.size() > 1 ? endpoints[1] : endpoints[0];
+  auto *bulkhead =
+      m_bulkheads[static_cast<size_t>(DataServiceOperation::FIND)].get();
+  m_http2_client.schedule(delay, [this, state, launch, bulkhead,
+                                  hedge_endpoint, headers = headers,
+                                  deadline]() mutable {
+    if (deadline.expired()) {
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      if (state->settled) {
+        return;
+      }
+    }
+
+    // A hedge is optional load, so it takes a free FIND slot or none at all
+    auto permit = bulkhead->try_acquire();
+    if (!permit) {
+      m_metrics.counter("hedge_bulkhead_full").inc();
+      return;
+    }
+    if (!m_hedge_budget.try_spend()) {
+      m_metrics.counter("hedge_budget_exhausted").inc();
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      if (state->settled) {
+        return;
+      }
+      state->in_flight[1] = true;
+    }
+
+    m_metrics.counter("hedge_sent").inc();
+    if (deadline.is_set()) {
+      headers[astra::utils::Deadline::kHeader] = deadline.to_grpc_timeout();
+    }
+    // Shared so the slot frees on completion even while the client still
+    // holds copies of the handler
+    auto slot =
+        std::make_shared<std::optional<astra::resilience::Bulkhead::Permit>>(
+            std::move(permit));
+    launch(1, hedge_endpoint, headers, [slot](const ClientResult &) {
+      slot->reset();
+    });
+  });
+}
+
+DataServiceResponse HttpDataServiceAdapter::to_response(ClientResult result) {
+  DataServiceResponse ds_resp;
+
+  if (result.is_err()) {
+    ds_resp.success = false;
+
+    switch (result.error()) {
+    case astra::http2::Http2ClientError::ConnectionFailed:
+    case astra::http2::Http2ClientError::NotConnected:
+      ds_resp.infra_error = InfraError::CONNECTION_FAILED;
+      ds_resp.error_message = "Connection failed";
+      break;
+    case astra::http2::Http2ClientError::RequestTimeout:
+      ds_resp.infra_error = InfraError::TIMEOUT;
+      ds_resp.error_message = "Request timeout";
+      break;
+    case astra::http2::Http2ClientError::StreamClosed:
+    case astra::http2::Http2ClientError::SubmitFailed:
+      ds_resp.infra_error = InfraError::PROTOCOL_ERROR;
+      ds_resp.error_message = "Protocol error";
+      break;
+    case astra::http2::Http2ClientError::Cancelled:
+      ds_resp.infra_error = InfraError::PROTOCOL_ERROR;
+      ds_resp.error_message = "Request cancelled";
+      break;
+    }
+    return ds_resp;
+  }
+
+  const auto &resp = result.value();
+  ds_resp.http_status = resp.status_code();
+  ds_resp.payload = resp.body();
+
+  if (resp.status_code() >= 200 && resp.status_code() < 300) {
+    ds_resp.success = true;
+  } else {
+    ds_resp.success = false;
+    ds_resp.domain_error_code = map_http_status_to_error(resp.status_code());
+    ds_resp.error_message = resp.body();
+  }
+  return ds_resp;
 }
 
 std::string
@@ -5,6 +5,7 @@
 #include "IServiceResolver.h"
 #include "ObservableMessageHandler.h"
 #include "ObservableRequestHandler.h"
+#include "RuntimeConfigWatcher.h"
 #include "UriShortenerMessageHandler.h"
 #include "UriShortenerRequestHandler.h"
 
@@ -13,17 +14,84 @@
 #include <IRequest.h>
 #include <IResponse.h>
 #include <Log.h>
+#include <Message.h>
 #include <Metrics.h>
 #include <Provider.h>
-#include <resilience/impl/AtomicLoadShedder.h>
+#include <atomic>
+#include <csignal>
+#include <functional>
+#include <mutex>
+#include <pthread.h>
+#include <resilience/impl/CriticalityLoadShedder.h>
+#include <thread>
 
 namespace uri_shortener {
 
+namespace {
+
+sigset_t shutdown_set() {
+  sigset_t signals;
+  sigemptyset(&signals);
+  sigaddset(&signals, SIGINT);
+  sigaddset(&signals, SIGTERM);
+  return signals;
+}
+
+// Takes SIGINT and SIGTERM on a thread of its own with sigwait. That only
+// works if no other thread can receive them, so main() must call
+// UriShortenerApp::block_shutdown_signals() before any thread starts; the
+// mask set here covers this thread and the waiter alone. Once on_signal
+// reports a shutdown under way, later signals are swallowed while it drains.
+class ShutdownSignals {
+public:
+  explicit ShutdownSignals(std::function<bool(int)> on_signal)
+      : m_signals(shutdown_set()) {
+    pthread_sigmask(SIG_BLOCK, &m_signals, &m_previous);
+
+    m_thread = std::thread([this, on_signal = std::move(on_signal)] {
+      bool fired = false;
+      int signal = 0;
+      while (sigwait(&m_signals, &signal) == 0 &&
+             !m_done.load(std::memory_order_acquire)) {
+        if (!fired) {
+          fired = on_signal(signal);
+        }
+      }
+    });
+  }
+
+  ~ShutdownSignals() {
+    m_done.store(true, std::memory_order_release);
+    pthread_kill(m_thread.native_handle(), SIGTERM);
+    m_thread.join();
+    pthread_sigmask(SIG_SETMASK, &m_previous, nullptr);
+  }
+
+  ShutdownSignals(const ShutdownSignals &) = delete;
+  ShutdownSignals &operator=(const ShutdownSignals &) = delete;
+
+private:
+  sigset_t m_signals{};
+  sigset_t m_previous{};
+  std::atomic<bool> m_done{false};
+  std::thread m_thread;
+};
+
+} // namespace
+
+void UriShortenerApp::block_shutdown_signals() {
+  sigset_t signals = shutdown_set();
+  pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+}
+
 UriShortenerApp::UriShortenerApp(UriShortenerComponents components)
     : m_components(std::move(components)) {
 }
 
 UriShortenerApp::~UriShortenerApp() {
+  if (m_components.config_watcher) {
+    m_components.config_watcher->stop();
+  }
   if (m_components.executor) {
     m_components.executor->stop();
   }
@@ -34,64 +102,133 @@ UriShortenerApp &
 UriShortenerApp::operator=(UriShortenerApp &&) noexcept = default;
 
 int UriShortenerApp::run() {
+  using astra::resilience::Criticality;
+  using astra::router::PreparedResponse;
+
   auto accepted = obs::counter("load_shedder.accepted");
   auto rejected = obs::counter("load_shedder.rejected");
 
-  auto resilient = [this, accepted,
-                    rejected](std::shared_ptr<astra::router::IRequest> req,
-                              std::shared_ptr<astra::router::IResponse> res) {
-    auto guard = m_components.load_shedder->try_acquire();
-    if (!guard) {
-      rejected.inc();
-      obs::warn("Load shedder rejected request",
-                {{"current",
-                  std::to_string(m_components.load_shedder->current_count())},
-                 {"max", std::to_string(
-                             m_components.load_shedder->max_concurrent())}});
-      res->set_status(503);
-      res->set_header("Content-Type", "application/json");
-      res->set_header("Retry-After", "1");
-      res->write(R"({"error": "Service overloaded"})");
-      res->close();
-      return;
-    }
-
-    accepted.inc();
-
-    auto http_res = std::dynamic_pointer_cast<astra::http2::Http2Response>(res);
-    if (http_res) {
-      http_res->add_scoped_resource(
-          std::make_unique<astra::resilience::LoadShedderGuard>(
-              std::move(*guard)));
-    }
+  // Built once: shedding has to stay cheap when the server is overloaded
+  auto overloaded = PreparedResponse::create(
+      503, {{"content-type", "application/json"}, {"retry-after", "1"}},
+      R"({"error": "Service overloaded"})");
+  auto healthy = PreparedResponse::create(
+      200, {{"content-type", "application/json"}}, R"({"status": "ok"})");
+
+  auto &router = m_components.server->router();
+
+  router.set_admission(
+      [this, accepted, rejected,
+       overloaded](const astra::router::RouteOptions &options,
+                   const std::shared_ptr<astra::router::IRequest> &,
+                   const std::shared_ptr<astra::router::IResponse> &res) {
+        auto &shedder = *m_components.load_shedder;
+        const char *tier = astra::resilience::to_string(options.criticality);
+
+        auto guard = shedder.try_acquire(options.criticality);
+        if (!guard) {
+          rejected.inc(1, {{"tier", tier}});
+          obs::warn("Load shedder rejected request",
+                    {{"tier", tier},
+                     {"current", std::to_string(shedder.current_count())},
+                     {"limit", std::to_string(
+                                   shedder.tier_limit(options.criticality))}});
+          res->send_prepared(overloaded);
+          return false;
+        }
+
+        accepted.inc(1, {{"tier", tier}});
+
+        auto http_res =
+            std::dynamic_pointer_cast<astra::http2::Http2Response>(res);
+        if (http_res) {
+          http_res->add_guard(std::move(*guard));
+        }
+        return true;
+      });
 
+  auto handler = [this](std::shared_ptr<astra::router::IRequest> req,
+                        std::shared_ptr<astra::router::IResponse> res) {
     m_components.obs_req_handler->handle(req, res);
   };
 
-  m_components.server->router().post("/shorten", resilient);
-  m_components.server->router().get("/:code", resilient);
-  m_components.server->router().del("/:code", resilient);
-
-  m_components.server->router().get(
-      "/health", [](std::shared_ptr<astra::router::IRequest>,
-                    std::shared_ptr<astra::router::IResponse> res) {
-        res->set_status(200);
-        res->set_header("Content-Type", "application/json");
-        res->write(R"({"status": "ok"})");
-        res->close();
-      });
+  // Offloaded routes run on the AffinityExecutor, on the lane keyed by the
+  // request, so everything a request touches stays on one lane
+  router.set_offload([this](const std::shared_ptr<astra::router::IRequest> &req,
+                            std::function<void()> work) {
+    m_components.executor->submit(astra::execution::Message{
+        UriShortenerRequestHandler::affinity_key(*req), obs::Context::create(),
+        std::move(work), req->deadline()});
+  });
+
+  using astra::router::Execution;
+  router.post("/shorten", handler,
+              {Criticality::Sheddable, false, Execution::Offload});
+  router.get("/:code", handler,
+             {Criticality::Default, false, Execution::Offload});
+  router.del("/:code", handler,
+             {Criticality::Default, false, Execution::Offload});
+
+  // Answered on the io thread, with no hop to a worker and none back
+  router.get(
+      "/health",
+      [healthy](std::shared_ptr<astra::router::IRequest>,
+                std::shared_ptr<astra::router::IResponse> res) {
+        res->send_prepared(healthy);
+      },
+      {Criticality::Critical, false, Execution::Inline});
 
   obs::info("URI Shortener listening");
   obs::info("Using message-based architecture",
             {{"lanes", std::to_string(m_components.executor->lane_count())}});
-  obs::info("Load shedder enabled",
-            {{"max_concurrent",
-              std::to_string(m_components.load_shedder->max_concurrent())}});
-
-  auto start_result = m_components.server->start();
-  if (!start_result) {
-    obs::error("Failed to start server");
-    return 1;
+  const auto &shedder = *m_components.load_shedder;
+  obs::info(
+      "Load shedder enabled",
+      {{"max_concurrent", std::to_string(shedder.max_concurrent())},
+       {"default_limit",
+        std::to_string(shedder.tier_limit(Criticality::Default))},
+       {"sheddable_limit",
+        std::to_string(shedder.tier_limit(Criticality::Sheddable))}});
+
+  // A signal that lands before the server starts is remembered and the
+  // server is never started; one that lands after drains it
+  std::mutex lifecycle;
+  bool shutdown_requested = false;
+  bool started = false;
+  ShutdownSignals signals([&](int signal) {
+    obs::info("Shutdown signal received, draining",
+              {{"signal", signal == SIGINT ? "SIGINT" : "SIGTERM"}});
+    std::lock_guard<std::mutex> lock(lifecycle);
+    shutdown_requested = true;
+    if (!started) {
+      return true;
+    }
+    auto stop_result = m_components.server->stop();
+    if (stop_result) {
+      obs::info("Server drained",
+                {{"drained", std::to_string(stop_result.value().drained)},
+                 {"aborted", std::to_string(stop_result.value().aborted)}});
+    }
+    return true;
+  });
+
+  if (m_components.config_watcher && !m_components.config_watcher->start()) {
+    obs::error("Config watcher failed to start, hot reload disabled",
+               {{"path", m_components.config_watcher->path()}});
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(lifecycle);
+    if (shutdown_requested) {
+      obs::info("Shutdown requested before the server started");
+      return 0;
+    }
+    auto start_result = m_components.server->start();
+    if (!start_result) {
+      obs::error("Failed to start server");
+      return 1;
+    }
+    started = true;
   }
 
   m_components.server->join();
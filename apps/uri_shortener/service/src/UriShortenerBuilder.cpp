@@ -11,6 +11,7 @@
 #include "ProtoConfigLoader.h"
 #include "RandomCodeGenerator.h"
 #include "ResolveLink.h"
+#include "RuntimeConfigWatcher.h"
 #include "ShortenLink.h"
 #include "StaticServiceResolver.h"
 #include "UriShortenerApp.h"
@@ -20,22 +21,50 @@
 #include <AffinityExecutor.h>
 #include <Log.h>
 #include <Provider.h>
-#include <resilience/impl/AtomicLoadShedder.h>
+#include <algorithm>
+#include <exception>
+#include <resilience/impl/CriticalityLoadShedder.h>
+#include <resilience/policy/CriticalityPolicy.h>
+#include <resilience/policy/HedgingPolicy.h>
 #include <resilience/policy/LoadShedderPolicy.h>
 
 namespace uri_shortener {
 
+namespace {
+
+size_t max_concurrent_from(const ::resilience::LoadShedderPolicy &shedder) {
+  return shedder.max_concurrent_requests() > 0
+             ? shedder.max_concurrent_requests()
+             : 1000;
+}
+
+astra::resilience::CriticalityPolicy
+tiers_from(const ::resilience::LoadShedderPolicy &shedder) {
+  astra::resilience::CriticalityPolicy tiers;
+  if (shedder.default_share() > 0.0) {
+    tiers.default_share = shedder.default_share();
+  }
+  if (shedder.sheddable_share() > 0.0) {
+    tiers.sheddable_share = shedder.sheddable_share();
+  }
+  return astra::resilience::CriticalityPolicy::create(tiers.default_share,
+                                                      tiers.sheddable_share);
+}
+
+} // namespace
+
 astra::outcome::Result<UriShortenerApp, BuilderError>
-UriShortenerBuilder::bootstrap() {
+UriShortenerBuilder::bootstrap(const std::string &config_path) {
   ::observability::Config bootstrap_obs;
   bootstrap_obs.set_service_name("uri-shortener");
   bootstrap_obs.set_service_version("1.0.0");
   bootstrap_obs.set_environment("bootstrap");
   obs::init(bootstrap_obs);
 
-  auto load_result = ProtoConfigLoader::load();
+  auto load_result = ProtoConfigLoader::loadFromFile(config_path);
   if (load_result.is_err()) {
-    obs::error("Failed to load config", {{"error", load_result.error()}});
+    obs::error("Failed to load config",
+               {{"path", config_path}, {"error", load_result.error()}});
     return astra::outcome::Result<UriShortenerApp, BuilderError>::Err(
         BuilderError::InvalidConfig);
   }
@@ -45,6 +74,7 @@ UriShortenerBuilder::bootstrap() {
       .backend()
       .messaging()
       .resilience()
+      .hotReload(config_path)
       .build();
 }
 
@@ -110,8 +140,49 @@ UriShortenerBuilder &UriShortenerBuilder::serviceResolver() {
 }
 
 UriShortenerBuilder &UriShortenerBuilder::dataAdapter() {
+  service::HttpDataServiceAdapter::Config adapter_config;
+
+  // Bulkheads are keyed by operation name, with "default" for the rest
+  const auto &bulkheads =
+      m_config.bootstrap().dataservice().resilience().bulkheads();
+  for (const auto &[key, policy] : bulkheads) {
+    service::HttpDataServiceAdapter::BulkheadLimits limits{
+        policy.max_concurrent(), policy.max_queue()};
+    if (key == "default") {
+      adapter_config.bulkhead = limits;
+      continue;
+    }
+    bool known = false;
+    for (size_t i = 0; i < service::kDataServiceOperationCount; ++i) {
+      auto op = static_cast<service::DataServiceOperation>(i);
+      if (key == service::to_string(op)) {
+        adapter_config.bulkhead_overrides[op] = limits;
+        known = true;
+      }
+    }
+    if (!known) {
+      obs::warn("Ignoring bulkhead for unknown operation", {{"key", key}});
+    }
+  }
+
+  const auto &hedging =
+      m_config.bootstrap().dataservice().resilience().hedging();
+  if (hedging.budget_ratio() > 0.0) {
+    // Unset (0) fields take HedgingPolicy's defaults, as the loader assumes
+    astra::resilience::HedgingPolicy defaults;
+    double quantile =
+        hedging.quantile() > 0.0 ? hedging.quantile() : defaults.quantile;
+    auto max_delay = hedging.max_delay_ms() > 0
+                         ? std::chrono::milliseconds(hedging.max_delay_ms())
+                         : defaults.max_delay;
+    adapter_config.hedging = astra::resilience::HedgingPolicy::create(
+        quantile, hedging.budget_ratio(),
+        std::chrono::milliseconds(hedging.min_delay_ms()), max_delay);
+  }
+
   m_components.data_adapter = std::make_shared<service::HttpDataServiceAdapter>(
-      *m_components.http_client, *m_components.resolver, "dataservice");
+      *m_components.http_client, *m_components.resolver, "dataservice",
+      std::move(adapter_config));
   return *this;
 }
 
@@ -134,13 +205,14 @@ UriShortenerBuilder &UriShortenerBuilder::executor() {
       num_lanes, *m_components.obs_msg_handler);
 
   m_components.msg_handler->setResponseExecutor(*m_components.executor);
+  m_components.msg_handler->enableCoalescing(num_lanes);
 
   return *this;
 }
 
 UriShortenerBuilder &UriShortenerBuilder::reqHandler() {
   m_components.req_handler =
-      std::make_unique<UriShortenerRequestHandler>(*m_components.executor);
+      std::make_unique<UriShortenerRequestHandler>(*m_components.msg_handler);
   return *this;
 }
 
@@ -151,16 +223,38 @@ UriShortenerBuilder &UriShortenerBuilder::wrapObservable() {
 }
 
 UriShortenerBuilder &UriShortenerBuilder::loadShedder() {
-  size_t max_concurrent = 1000;
-  if (m_config.has_runtime() && m_config.runtime().has_load_shedder() &&
-      m_config.runtime().load_shedder().max_concurrent_requests() > 0) {
-    max_concurrent =
-        m_config.runtime().load_shedder().max_concurrent_requests();
-  }
-  auto policy = astra::resilience::LoadShedderPolicy::create(max_concurrent,
-                                                             "uri_shortener");
+  const auto &shedder = m_config.runtime().load_shedder();
+  auto policy = astra::resilience::LoadShedderPolicy::create(
+      max_concurrent_from(shedder), "uri_shortener");
   m_components.load_shedder =
-      std::make_unique<astra::resilience::AtomicLoadShedder>(std::move(policy));
+      std::make_unique<astra::resilience::CriticalityLoadShedder>(
+          std::move(policy), tiers_from(shedder));
+  return *this;
+}
+
+UriShortenerBuilder &UriShortenerBuilder::hotReload(const std::string &path) {
+  m_components.config_watcher =
+      std::make_unique<RuntimeConfigWatcher>(path, m_config.runtime());
+
+  auto *load_shedder = m_components.load_shedder.get();
+  m_components.config_watcher->subscribe(
+      [load_shedder](const RuntimeConfigChange &change) {
+        if (!load_shedder || !change.changed("load_shedder")) {
+          return;
+        }
+        // Runs on the watcher thread; a bad value must not take it down
+        try {
+          const auto &shedder = change.current.load_shedder();
+          auto policy = astra::resilience::LoadShedderPolicy::create(
+              max_concurrent_from(shedder), "uri_shortener");
+          load_shedder->update(policy, tiers_from(shedder));
+          obs::info("Load shedder reconfigured",
+                    {{"max_concurrent",
+                      std::to_string(load_shedder->max_concurrent())}});
+        } catch (const std::exception &e) {
+          obs::error("Load shedder reload rejected", {{"error", e.what()}});
+        }
+      });
   return *this;
 }
 
@@ -2,12 +2,13 @@
 
 // Include complete type definitions for unique_ptr members
 #include "AffinityExecutor.h"
-#include "AtomicLoadShedder.h"
+#include "CriticalityLoadShedder.h"
 #include "Http2Client.h"
 #include "Http2Server.h"
 #include "IServiceResolver.h"
 #include "ObservableMessageHandler.h"
 #include "ObservableRequestHandler.h"
+#include "RuntimeConfigWatcher.h"
 #include "UriShortenerMessageHandler.h"
 #include "UriShortenerRequestHandler.h"
 
@@ -1,12 +1,15 @@
 #include "UriShortenerMessageHandler.h"
 
+#include <AffinityExecutor.h>
 #include <IRequest.h>
 #include <IResponse.h>
 #include <Log.h>
 #include <Message.h>
+#include <Metrics.h>
 #include <Span.h>
 #include <any>
 #include <functional>
+#include <string_view>
 #include <utility>
 
 namespace uri_shortener {
@@ -16,6 +19,19 @@ using RequestResponsePair =
     std::pair<std::shared_ptr<astra::router::IRequest>,
               std::shared_ptr<astra::router::IResponse>>;
 
+// Handler call queued by the router for an Execution::Offload route
+using OffloadedWork = std::function<void()>;
+
+namespace {
+
+/// Adapter response for a coalesced FIND, fanned out to every waiter
+struct CoalescedResponse {
+  std::string key;
+  service::DataServiceResponse response;
+};
+
+} // namespace
+
 UriShortenerMessageHandler::UriShortenerMessageHandler(
     std::shared_ptr<service::IDataServiceAdapter> adapter)
     : m_adapter(std::move(adapter)) {
@@ -26,30 +42,48 @@ void UriShortenerMessageHandler::setResponseExecutor(
   m_response_executor = &executor;
 }
 
+void UriShortenerMessageHandler::enableCoalescing(size_t lane_count) {
+  m_flights.assign(lane_count, Flights{});
+}
+
 void UriShortenerMessageHandler::handle(astra::execution::Message &msg) {
-  try {
-    // Try pair payload first (new format - HTTP request)
-    auto &pair = std::any_cast<RequestResponsePair &>(msg.payload);
-    processHttpRequest(pair.first, pair.second, msg.affinity_key,
-                       msg.trace_ctx);
-  } catch (const std::bad_any_cast &) {
-    try {
-      // Try DataServiceResponse (callback from adapter)
-      auto &resp = std::any_cast<service::DataServiceResponse &>(msg.payload);
-      processDataServiceResponse(resp);
-    } catch (const std::bad_any_cast &) {
-      obs::error("Unknown message payload type");
-    }
+  if (auto *work = std::any_cast<OffloadedWork>(&msg.payload)) {
+    // Route handler the router offloaded to this lane
+    (*work)();
+  } else if (auto *pair = std::any_cast<RequestResponsePair>(&msg.payload)) {
+    // HTTP request from the server
+    processHttpRequest(pair->first, pair->second, msg.affinity_key,
+                       msg.trace_ctx, msg.deadline);
+  } else if (auto *resp =
+                 std::any_cast<service::DataServiceResponse>(&msg.payload)) {
+    // Callback from adapter
+    processDataServiceResponse(*resp);
+  } else if (auto *coalesced =
+                 std::any_cast<CoalescedResponse>(&msg.payload)) {
+    processCoalescedResponse(coalesced->key, coalesced->response);
+  } else {
+    obs::error("Unknown message payload type");
   }
 }
 
 void UriShortenerMessageHandler::processHttpRequest(
     std::shared_ptr<astra::router::IRequest> req,
     std::shared_ptr<astra::router::IResponse> res, uint64_t affinity_key,
-    obs::Context &trace_ctx) {
+    obs::Context &trace_ctx, astra::utils::Deadline deadline) {
+  // The caller has given up while the request sat in the lane
+  if (deadline.expired()) {
+    obs::counter("request.deadline.expired").inc(1, {{"stage", "queue"}});
+    res->set_status(504);
+    res->set_header("Content-Type", "application/json");
+    res->write(R"({"error": "Deadline exceeded"})");
+    res->close();
+    return;
+  }
+
   std::string method(req->method());
   std::string path(req->path());
-  std::string body(req->body());
+  // Views the request's own buffer; the body is never copied here
+  std::string_view body = req->body_view();
 
   std::string operation = determine_operation(method, path);
 
@@ -68,12 +102,14 @@ void UriShortenerMessageHandler::processHttpRequest(
   if (operation == "shorten") {
     // Parse JSON body for URL
     auto url_start = body.find("\"url\"");
-    if (url_start != std::string::npos) {
+    if (url_start != std::string_view::npos) {
       auto value_start = body.find(':', url_start);
       auto quote_start = body.find('"', value_start);
       auto quote_end = body.find('"', quote_start + 1);
-      if (quote_start != std::string::npos && quote_end != std::string::npos) {
-        payload = body.substr(quote_start + 1, quote_end - quote_start - 1);
+      if (quote_start != std::string_view::npos &&
+          quote_end != std::string_view::npos) {
+        payload = std::string(
+            body.substr(quote_start + 1, quote_end - quote_start - 1));
       }
     }
     if (payload.empty()) {
@@ -93,8 +129,9 @@ void UriShortenerMessageHandler::processHttpRequest(
   // Create DataServiceRequest
   service::DataServiceRequest ds_req{
       to_data_service_op(operation), entity_id, payload,
-      res,    // Pass shared_ptr<IResponse>
-      nullptr // No span for now
+      res,      // Pass shared_ptr<IResponse>
+      nullptr, // No span for now
+      deadline // Remaining budget goes downstream
   };
 
   // If no adapter configured, respond with error
@@ -107,25 +144,43 @@ void UriShortenerMessageHandler::processHttpRequest(
     return;
   }
 
+  // Identical lookups in flight share one downstream FIND. The affinity key
+  // is derived from the path, so they all run on this lane and the lane's
+  // table needs no lock.
+  std::string flight_key;
+  size_t lane = astra::execution::AffinityExecutor::current_lane();
+  if (ds_req.op == service::DataServiceOperation::FIND &&
+      lane < m_flights.size()) {
+    flight_key = std::string(service::to_string(ds_req.op)) + ":" + entity_id;
+    if (!m_flights[lane].join(flight_key, res)) {
+      obs::counter("dataservice.coalesced").inc();
+      return;
+    }
+  }
+
   // Capture affinity_key and trace_ctx for callback
   auto captured_affinity_key = affinity_key;
   auto captured_trace_ctx = trace_ctx;
   auto response_executor = m_response_executor;
 
   // Call adapter with callback that submits response to executor
-  m_adapter->execute(ds_req,
-                     [response_executor, captured_affinity_key,
-                      captured_trace_ctx](service::DataServiceResponse resp) {
-                       // Submit response back to executor for processing
-                       astra::execution::Message response_msg;
-                       response_msg.affinity_key = captured_affinity_key;
-                       response_msg.trace_ctx = captured_trace_ctx;
-                       response_msg.payload = std::move(resp);
-
-                       if (response_executor) {
-                         response_executor->submit(std::move(response_msg));
-                       }
-                     });
+  m_adapter->execute(ds_req, [response_executor, captured_affinity_key,
+                              captured_trace_ctx, flight_key](
+                                 service::DataServiceResponse resp) {
+    // Submit response back to executor for processing
+    astra::execution::Message response_msg;
+    response_msg.affinity_key = captured_affinity_key;
+    response_msg.trace_ctx = captured_trace_ctx;
+    if (flight_key.empty()) {
+      response_msg.payload = std::move(resp);
+    } else {
+      response_msg.payload = CoalescedResponse{flight_key, std::move(resp)};
+    }
+
+    if (response_executor) {
+      response_executor->submit(std::move(response_msg));
+    }
+  });
 }
 
 void UriShortenerMessageHandler::processDataServiceResponse(
@@ -183,6 +238,27 @@ void UriShortenerMessageHandler::processDataServiceResponse(
   response.close();
 }
 
+void UriShortenerMessageHandler::processCoalescedResponse(
+    const std::string &key, service::DataServiceResponse &resp) {
+  std::vector<std::shared_ptr<astra::router::IResponse>> waiters;
+  size_t lane = astra::execution::AffinityExecutor::current_lane();
+  if (lane < m_flights.size()) {
+    waiters = m_flights[lane].complete(key);
+  }
+  if (waiters.empty()) {
+    // Delivered off the flight's lane; only the leader can be answered
+    obs::warn("Coalesced response outside its lane", {{"key", key}});
+    processDataServiceResponse(resp);
+    return;
+  }
+
+  for (auto &waiter : waiters) {
+    service::DataServiceResponse copy = resp;
+    copy.response = std::move(waiter);
+    processDataServiceResponse(copy);
+  }
+}
+
 std::string
 UriShortenerMessageHandler::determine_operation(const std::string &method,
                                                 const std::string &path) {
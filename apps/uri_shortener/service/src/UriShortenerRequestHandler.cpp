@@ -2,33 +2,32 @@
 
 #include <Message.h>
 #include <functional>
+#include <string>
 #include <utility>
 
 namespace uri_shortener {
 
 UriShortenerRequestHandler::UriShortenerRequestHandler(
-    astra::execution::IExecutor &executor)
-    : m_executor(executor) {
+    astra::execution::IMessageHandler &handler)
+    : m_handler(handler) {
 }
 
 void UriShortenerRequestHandler::handle(
     std::shared_ptr<astra::router::IRequest> req,
     std::shared_ptr<astra::router::IResponse> res) {
-  // Generate affinity key for session affinity
-  uint64_t affinity_key = generate_session_id(*req);
-
   // Capture current trace context
   obs::Context trace_ctx = obs::Context::create();
 
-  // Submit to executor with request/response pair as payload
-  astra::execution::Message msg{affinity_key, trace_ctx,
-                                std::make_pair(req, res)};
+  // Already on the request's lane; the deadline travels with the message so
+  // a request that expired while queued is answered with 504
+  astra::execution::Message msg{affinity_key(*req), trace_ctx,
+                                std::make_pair(req, res), req->deadline()};
 
-  m_executor.submit(std::move(msg));
+  m_handler.handle(msg);
 }
 
 uint64_t
-UriShortenerRequestHandler::generate_session_id(astra::router::IRequest &req) {
+UriShortenerRequestHandler::affinity_key(const astra::router::IRequest &req) {
   // Use path + method hash for session affinity
   std::string key = std::string(req.method()) + ":" + std::string(req.path());
   return std::hash<std::string>{}(key);
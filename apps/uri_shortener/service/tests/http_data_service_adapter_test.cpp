@@ -3,13 +3,18 @@
 #include "StaticServiceResolver.h"
 
 #include <atomic>
+#include <boost/asio/steady_timer.hpp>
 #include <chrono>
 #include <condition_variable>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <memory>
 #include <mutex>
+#include <nghttp2/asio_http2_server.h>
+#include <nghttp2/nghttp2.h>
+#include <optional>
 #include <thread>
+#include <vector>
 
 using namespace uri_shortener::service;
 using namespace astra::http2;
@@ -19,6 +24,131 @@ using ::testing::Invoke;
 
 namespace uri_shortener::service::test {
 
+// Data service on a loopback port that answers every request with `status`
+// after a fixed delay, and records how each stream ended.
+class StubDataService {
+public:
+  explicit StubDataService(std::chrono::milliseconds delay, int status = 200) {
+    m_server.num_threads(1);
+    m_server.handle("/", [this, delay, status](
+                             const nghttp2::asio_http2::server::request &,
+                             const nghttp2::asio_http2::server::response
+                                 &res) {
+      m_requests++;
+      auto timer =
+          std::make_shared<boost::asio::steady_timer>(res.io_service(), delay);
+      timer->async_wait(
+          [&res, timer, status](const boost::system::error_code &ec) {
+            if (!ec) {
+              res.write_head(status);
+              res.end("{}");
+            }
+          });
+      res.on_close([this, timer](uint32_t error_code) {
+        timer->cancel();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_close_codes.push_back(error_code);
+      });
+    });
+
+    boost::system::error_code ec;
+    m_server.listen_and_serve(ec, "127.0.0.1", "0", true);
+    if (ec) {
+      throw std::runtime_error("stub listen failed: " + ec.message());
+    }
+  }
+
+  ~StubDataService() {
+    m_server.stop();
+    m_server.join();
+  }
+
+  [[nodiscard]] uint16_t port() const {
+    return static_cast<uint16_t>(m_server.ports().front());
+  }
+
+  [[nodiscard]] int requests() const {
+    return m_requests.load();
+  }
+
+  [[nodiscard]] std::vector<uint32_t> close_codes() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_close_codes;
+  }
+
+private:
+  nghttp2::asio_http2::server::http2 m_server;
+  std::atomic<int> m_requests{0};
+  mutable std::mutex m_mutex;
+  std::vector<uint32_t> m_close_codes;
+};
+
+// Resolves every service to a fixed list of endpoints
+class FixedResolver : public IServiceResolver {
+public:
+  explicit FixedResolver(std::vector<std::pair<std::string, uint16_t>> all)
+      : m_all(std::move(all)) {
+  }
+
+  std::pair<std::string, uint16_t> resolve(const std::string &) override {
+    return m_all.front();
+  }
+
+  std::vector<std::pair<std::string, uint16_t>>
+  resolve_all(const std::string &) override {
+    return m_all;
+  }
+
+  bool has_service(const std::string &) const override {
+    return true;
+  }
+
+private:
+  std::vector<std::pair<std::string, uint16_t>> m_all;
+};
+
+template <typename Predicate>
+bool eventually(Predicate predicate, std::chrono::milliseconds wait =
+                                         std::chrono::milliseconds(1000)) {
+  auto until = std::chrono::steady_clock::now() + wait;
+  while (!predicate()) {
+    if (std::chrono::steady_clock::now() >= until) {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  return true;
+}
+
+// Blocks until `count` callbacks have arrived or `wait` runs out
+class Completions {
+public:
+  DataServiceCallback callback() {
+    return [this](DataServiceResponse resp) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_responses.push_back(std::move(resp));
+      m_cv.notify_all();
+    };
+  }
+
+  bool wait_for(size_t count, std::chrono::milliseconds wait =
+                                  std::chrono::milliseconds(2000)) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return m_cv.wait_for(lock, wait,
+                         [&] { return m_responses.size() >= count; });
+  }
+
+  std::vector<DataServiceResponse> responses() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_responses;
+  }
+
+private:
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::vector<DataServiceResponse> m_responses;
+};
+
 class HttpDataServiceAdapterTest : public ::testing::Test {
 protected:
   void SetUp() override {
@@ -233,4 +363,288 @@ TEST_F(HttpDataServiceAdapterTest, MultipleServicesCanBeRegistered) {
   EXPECT_EQ(callback_count, 2);
 }
 
+// ===========================================================================
+// Bulkhead Tests
+// ===========================================================================
+
+TEST_F(HttpDataServiceAdapterTest, BulkheadOverflowFailsFast) {
+  Http2Client client(m_config);
+  HttpDataServiceAdapter::Config config;
+  config.bulkhead_overrides[DataServiceOperation::FIND] = {1, 0};
+  HttpDataServiceAdapter adapter(client, m_resolver, "dataservice", config);
+
+  std::atomic<int> callback_count{0};
+  std::atomic<int> bulkhead_full{0};
+  const int num_requests = 5;
+
+  for (int i = 0; i < num_requests; ++i) {
+    DataServiceRequest req{DataServiceOperation::FIND, "abc123", "", nullptr,
+                           nullptr};
+    adapter.execute(req, [&](DataServiceResponse resp) {
+      if (resp.infra_error == InfraError::BULKHEAD_FULL) {
+        bulkhead_full++;
+      }
+      callback_count++;
+    });
+  }
+
+  // Rejections are reported synchronously, before the first call completes
+  EXPECT_GE(bulkhead_full, 1);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+  EXPECT_EQ(callback_count, num_requests);
+  EXPECT_EQ(adapter.bulkhead(DataServiceOperation::FIND).in_flight(), 0);
+}
+
+TEST_F(HttpDataServiceAdapterTest, BulkheadsIsolateOperations) {
+  StubDataService backend(std::chrono::milliseconds(200));
+  m_resolver.register_service("slow-dataservice", "127.0.0.1",
+                              backend.port());
+  m_config.set_request_timeout_ms(2000);
+  Http2Client client(m_config);
+  HttpDataServiceAdapter::Config config;
+  config.bulkhead_overrides[DataServiceOperation::FIND] = {2, 0};
+  HttpDataServiceAdapter adapter(client, m_resolver, "slow-dataservice",
+                                 config);
+
+  // Two slow FINDs hold every FIND slot; the third bounces off the bulkhead
+  Completions finds;
+  for (int i = 0; i < 3; ++i) {
+    adapter.execute(DataServiceRequest{DataServiceOperation::FIND, "abc123",
+                                       "", nullptr, nullptr},
+                    finds.callback());
+  }
+  ASSERT_TRUE(finds.wait_for(1, std::chrono::milliseconds(0)));
+  EXPECT_EQ(finds.responses().front().infra_error, InfraError::BULKHEAD_FULL);
+  EXPECT_EQ(adapter.bulkhead(DataServiceOperation::FIND).in_flight(), 2);
+
+  // SAVE draws on its own slots and still reaches the backend
+  Completions save;
+  adapter.execute(DataServiceRequest{DataServiceOperation::SAVE, "", "{}",
+                                     nullptr, nullptr},
+                  save.callback());
+  EXPECT_EQ(adapter.bulkhead(DataServiceOperation::SAVE).in_flight(), 1);
+
+  ASSERT_TRUE(save.wait_for(1));
+  EXPECT_TRUE(save.responses().front().success);
+  EXPECT_FALSE(save.responses().front().infra_error.has_value());
+
+  ASSERT_TRUE(finds.wait_for(3));
+  EXPECT_EQ(backend.requests(), 3);
+  EXPECT_EQ(adapter.bulkhead(DataServiceOperation::FIND).in_flight(), 0);
+}
+
+// ===========================================================================
+// Hedging Tests
+// ===========================================================================
+
+TEST_F(HttpDataServiceAdapterTest, HedgedFindCompletesExactlyOnce) {
+  Http2Client client(m_config);
+  HttpDataServiceAdapter::Config config;
+  config.hedging = astra::resilience::HedgingPolicy::create(
+      0.95, 1.0, std::chrono::milliseconds(1), std::chrono::milliseconds(5));
+  config.hedging->min_samples = 0; // Hedge from the first call
+  HttpDataServiceAdapter adapter(client, m_resolver, "dataservice", config);
+
+  std::atomic<int> callback_count{0};
+  std::atomic<int> connection_failed{0};
+  const int num_requests = 10;
+
+  for (int i = 0; i < num_requests; ++i) {
+    DataServiceRequest req{DataServiceOperation::FIND, "abc123", "", nullptr,
+                           nullptr};
+    adapter.execute(req, [&](DataServiceResponse resp) {
+      if (resp.infra_error == InfraError::CONNECTION_FAILED) {
+        connection_failed++;
+      }
+      callback_count++;
+    });
+  }
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+  EXPECT_EQ(callback_count, num_requests);
+  EXPECT_EQ(connection_failed, num_requests);
+  EXPECT_EQ(adapter.bulkhead(DataServiceOperation::FIND).in_flight(), 0);
+}
+
+TEST_F(HttpDataServiceAdapterTest, NonFindIsNeverHedged) {
+  Http2Client client(m_config);
+  HttpDataServiceAdapter::Config config;
+  config.hedging = astra::resilience::HedgingPolicy::create(
+      0.95, 1.0, std::chrono::milliseconds(1), std::chrono::milliseconds(5));
+  HttpDataServiceAdapter adapter(client, m_resolver, "dataservice", config);
+
+  std::atomic<int> callback_count{0};
+  DataServiceRequest req{DataServiceOperation::DELETE, "abc123", "", nullptr,
+                         nullptr};
+  adapter.execute(req, [&](DataServiceResponse) {
+    callback_count++;
+  });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+  EXPECT_EQ(callback_count, 1);
+  EXPECT_EQ(adapter.find_latency().sample_count(), 0);
+}
+
+class HttpDataServiceHedgingTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    m_config.set_request_timeout_ms(2000);
+  }
+
+  // Hedge 50ms after the primary, from the first call on
+  static HttpDataServiceAdapter::Config hedging(double budget_ratio = 1.0) {
+    HttpDataServiceAdapter::Config config;
+    config.hedging = astra::resilience::HedgingPolicy::create(
+        0.95, budget_ratio, std::chrono::milliseconds(50),
+        std::chrono::milliseconds(50));
+    config.hedging->min_samples = 0;
+    return config;
+  }
+
+  static DataServiceRequest find() {
+    return DataServiceRequest{DataServiceOperation::FIND, "abc123", "",
+                              nullptr, nullptr};
+  }
+
+  astra::http2::ClientConfig m_config;
+};
+
+TEST_F(HttpDataServiceHedgingTest, HedgeFiresAfterThresholdAndWins) {
+  StubDataService slow(std::chrono::milliseconds(500));
+  StubDataService fast(std::chrono::milliseconds(0));
+  FixedResolver resolver({{"127.0.0.1", slow.port()},
+                          {"127.0.0.1", fast.port()}});
+  Http2Client client(m_config);
+  HttpDataServiceAdapter adapter(client, resolver, "dataservice", hedging());
+
+  Completions done;
+  auto started = std::chrono::steady_clock::now();
+  adapter.execute(find(), done.callback());
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  EXPECT_EQ(fast.requests(), 0); // Still under the hedge threshold
+
+  ASSERT_TRUE(done.wait_for(1));
+  auto elapsed = std::chrono::steady_clock::now() - started;
+  EXPECT_GE(elapsed, std::chrono::milliseconds(50));
+  EXPECT_LT(elapsed, std::chrono::milliseconds(500));
+  EXPECT_TRUE(done.responses().front().success);
+  EXPECT_EQ(slow.requests(), 1);
+  EXPECT_EQ(fast.requests(), 1);
+
+  // The losing primary is reset rather than left to finish
+  EXPECT_TRUE(eventually([&] {
+    return slow.close_codes() == std::vector<uint32_t>{NGHTTP2_CANCEL};
+  }));
+  EXPECT_TRUE(eventually([&] {
+    return adapter.bulkhead(DataServiceOperation::FIND).in_flight() == 0;
+  }));
+}
+
+TEST_F(HttpDataServiceHedgingTest, FailedPrimaryGivesWayToHedge) {
+  StubDataService failing(std::chrono::milliseconds(100), 503);
+  StubDataService healthy(std::chrono::milliseconds(100));
+  FixedResolver resolver({{"127.0.0.1", failing.port()},
+                          {"127.0.0.1", healthy.port()}});
+  Http2Client client(m_config);
+  HttpDataServiceAdapter adapter(client, resolver, "dataservice", hedging());
+
+  Completions done;
+  adapter.execute(find(), done.callback());
+
+  ASSERT_TRUE(done.wait_for(1));
+  EXPECT_TRUE(done.responses().front().success);
+  EXPECT_EQ(done.responses().front().http_status, 200);
+  EXPECT_TRUE(eventually([&] {
+    return healthy.close_codes() == std::vector<uint32_t>{NGHTTP2_NO_ERROR};
+  }));
+}
+
+TEST_F(HttpDataServiceHedgingTest, BudgetStopsHedgingOnceSpent) {
+  StubDataService slow(std::chrono::milliseconds(200));
+  StubDataService fast(std::chrono::milliseconds(0));
+  FixedResolver resolver({{"127.0.0.1", slow.port()},
+                          {"127.0.0.1", fast.port()}});
+  Http2Client client(m_config);
+  HttpDataServiceAdapter adapter(client, resolver, "dataservice",
+                                 hedging(0.5));
+
+  // Each primary earns half a hedge, so only every second call hedges
+  for (size_t i = 1; i <= 4; ++i) {
+    Completions done;
+    adapter.execute(find(), done.callback());
+    ASSERT_TRUE(done.wait_for(1));
+    EXPECT_TRUE(done.responses().front().success);
+  }
+
+  EXPECT_EQ(slow.requests(), 4);
+  EXPECT_EQ(fast.requests(), 2);
+}
+
+TEST_F(HttpDataServiceHedgingTest, HedgeNeedsFreeBulkheadSlot) {
+  StubDataService slow(std::chrono::milliseconds(200));
+  StubDataService fast(std::chrono::milliseconds(0));
+  FixedResolver resolver({{"127.0.0.1", slow.port()},
+                          {"127.0.0.1", fast.port()}});
+  Http2Client client(m_config);
+  auto config = hedging();
+  config.bulkhead_overrides[DataServiceOperation::FIND] = {1, 0};
+  HttpDataServiceAdapter adapter(client, resolver, "dataservice", config);
+
+  Completions done;
+  adapter.execute(find(), done.callback());
+
+  ASSERT_TRUE(done.wait_for(1));
+  EXPECT_TRUE(done.responses().front().success);
+  EXPECT_EQ(fast.requests(), 0);
+  EXPECT_EQ(adapter.bulkhead(DataServiceOperation::FIND).in_flight(), 0);
+}
+
+// ===========================================================================
+// Deadline Tests
+// ===========================================================================
+
+TEST_F(HttpDataServiceAdapterTest, ExpiredDeadlineIsNotSent) {
+  Http2Client client(m_config);
+  HttpDataServiceAdapter adapter(client, m_resolver, "dataservice");
+
+  DataServiceRequest req{DataServiceOperation::FIND, "abc123", "", nullptr,
+                         nullptr,
+                         astra::utils::Deadline::at(
+                             astra::utils::Deadline::Clock::now() -
+                             std::chrono::milliseconds(1))};
+
+  std::optional<InfraError> error;
+  adapter.execute(req, [&error](DataServiceResponse resp) {
+    error = resp.infra_error;
+  });
+
+  // Answered synchronously, without a round trip to the backend
+  ASSERT_TRUE(error.has_value());
+  EXPECT_EQ(*error, InfraError::TIMEOUT);
+  EXPECT_EQ(adapter.bulkhead(DataServiceOperation::FIND).in_flight(), 0);
+}
+
+TEST_F(HttpDataServiceAdapterTest, DeadlineCapsClientTimeout) {
+  m_config.set_request_timeout_ms(5000);
+  Http2Client client(m_config);
+  HttpDataServiceAdapter adapter(client, m_resolver, "dataservice");
+
+  DataServiceRequest req{DataServiceOperation::FIND, "abc123", "", nullptr,
+                         nullptr,
+                         astra::utils::Deadline::after(
+                             std::chrono::milliseconds(200))};
+
+  std::atomic<bool> callback_called{false};
+  adapter.execute(req, [&callback_called](DataServiceResponse) {
+    callback_called = true;
+  });
+
+  // Either the connection fails or the 200ms budget runs out, long before
+  // the configured 5s client timeout
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+  EXPECT_TRUE(callback_called);
+}
+
 } // namespace uri_shortener::service::test
@@ -0,0 +1,213 @@
+#include "UriShortenerMessageHandler.h"
+
+#include <AffinityExecutor.h>
+#include <Message.h>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace uri_shortener;
+using namespace uri_shortener::service;
+using namespace std::chrono_literals;
+
+namespace uri_shortener::test {
+
+namespace {
+
+class FakeRequest : public astra::router::IRequest {
+public:
+  FakeRequest(std::string method, std::string path)
+      : m_method(std::move(method)), m_path(std::move(path)) {
+  }
+
+  const std::string &method() const override {
+    return m_method;
+  }
+  const std::string &path() const override {
+    return m_path;
+  }
+  std::string header(const std::string &) const override {
+    return {};
+  }
+  const std::string &body() const override {
+    return m_body;
+  }
+  std::string path_param(const std::string &) const override {
+    return {};
+  }
+  std::string query_param(const std::string &) const override {
+    return {};
+  }
+  void set_path_params(std::unordered_map<std::string, std::string>) override {
+  }
+
+private:
+  std::string m_method;
+  std::string m_path;
+  std::string m_body;
+};
+
+class RecordingResponse : public astra::router::IResponse {
+public:
+  void set_status(int code) noexcept override {
+    m_status = code;
+  }
+  void set_header(const std::string &, const std::string &) override {
+  }
+  void write(const std::string &data) override {
+    m_body += data;
+  }
+  void close() override {
+    m_closed = true;
+  }
+  bool is_alive() const noexcept override {
+    return true;
+  }
+
+  std::atomic<int> m_status{0};
+  std::string m_body;
+  std::atomic<bool> m_closed{false};
+};
+
+/// Holds callbacks so the test decides when the data service answers
+class DeferredAdapter : public IDataServiceAdapter {
+public:
+  void execute(DataServiceRequest, DataServiceCallback callback) override {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_callbacks.push_back(std::move(callback));
+  }
+
+  size_t calls() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_callbacks.size();
+  }
+
+  void answer_all(const std::string &payload) {
+    std::vector<DataServiceCallback> callbacks;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      callbacks.swap(m_callbacks);
+    }
+    for (auto &callback : callbacks) {
+      DataServiceResponse resp;
+      resp.success = true;
+      resp.http_status = 200;
+      resp.payload = payload;
+      callback(std::move(resp));
+    }
+  }
+
+private:
+  std::mutex m_mutex;
+  std::vector<DataServiceCallback> m_callbacks;
+};
+
+} // namespace
+
+class UriShortenerMessageHandlerTest : public ::testing::Test {
+protected:
+  void submitGet(astra::execution::IExecutor &executor,
+                 const std::string &path) {
+    auto req = std::make_shared<FakeRequest>("GET", path);
+    auto res = std::make_shared<RecordingResponse>();
+    m_responses.push_back(res);
+
+    astra::execution::Message msg;
+    msg.affinity_key = std::hash<std::string>{}("GET:" + path);
+    msg.payload = std::make_pair(
+        std::static_pointer_cast<astra::router::IRequest>(req),
+        std::static_pointer_cast<astra::router::IResponse>(res));
+    executor.submit(std::move(msg));
+  }
+
+  std::shared_ptr<DeferredAdapter> m_adapter =
+      std::make_shared<DeferredAdapter>();
+  std::vector<std::shared_ptr<RecordingResponse>> m_responses;
+};
+
+TEST_F(UriShortenerMessageHandlerTest, ConcurrentFindsShareOneCall) {
+  UriShortenerMessageHandler handler(m_adapter);
+  astra::execution::AffinityExecutor executor(2, handler);
+  handler.setResponseExecutor(executor);
+  handler.enableCoalescing(executor.lane_count());
+  executor.start();
+
+  for (int i = 0; i < 5; ++i) {
+    submitGet(executor, "/abc123");
+  }
+  std::this_thread::sleep_for(100ms);
+  EXPECT_EQ(m_adapter->calls(), 1);
+
+  m_adapter->answer_all(R"({"url":"https://example.com"})");
+  std::this_thread::sleep_for(100ms);
+  executor.stop();
+
+  for (const auto &res : m_responses) {
+    EXPECT_TRUE(res->m_closed);
+    EXPECT_EQ(res->m_status, 200);
+    EXPECT_EQ(res->m_body, R"({"url":"https://example.com"})");
+  }
+}
+
+TEST_F(UriShortenerMessageHandlerTest, NewFlightAfterResponse) {
+  UriShortenerMessageHandler handler(m_adapter);
+  astra::execution::AffinityExecutor executor(1, handler);
+  handler.setResponseExecutor(executor);
+  handler.enableCoalescing(executor.lane_count());
+  executor.start();
+
+  submitGet(executor, "/abc123");
+  std::this_thread::sleep_for(50ms);
+  m_adapter->answer_all("{}");
+  std::this_thread::sleep_for(50ms);
+
+  submitGet(executor, "/abc123");
+  std::this_thread::sleep_for(50ms);
+  EXPECT_EQ(m_adapter->calls(), 1);
+
+  m_adapter->answer_all("{}");
+  std::this_thread::sleep_for(50ms);
+  executor.stop();
+
+  EXPECT_TRUE(m_responses[0]->m_closed);
+  EXPECT_TRUE(m_responses[1]->m_closed);
+}
+
+TEST_F(UriShortenerMessageHandlerTest, DifferentCodesAreNotCoalesced) {
+  UriShortenerMessageHandler handler(m_adapter);
+  astra::execution::AffinityExecutor executor(2, handler);
+  handler.setResponseExecutor(executor);
+  handler.enableCoalescing(executor.lane_count());
+  executor.start();
+
+  submitGet(executor, "/abc123");
+  submitGet(executor, "/xyz789");
+  std::this_thread::sleep_for(100ms);
+  EXPECT_EQ(m_adapter->calls(), 2);
+
+  m_adapter->answer_all("{}");
+  std::this_thread::sleep_for(100ms);
+  executor.stop();
+}
+
+TEST_F(UriShortenerMessageHandlerTest, WithoutCoalescingEveryFindIsSent) {
+  UriShortenerMessageHandler handler(m_adapter);
+  astra::execution::AffinityExecutor executor(1, handler);
+  handler.setResponseExecutor(executor);
+  executor.start();
+
+  for (int i = 0; i < 3; ++i) {
+    submitGet(executor, "/abc123");
+  }
+  std::this_thread::sleep_for(100ms);
+  EXPECT_EQ(m_adapter->calls(), 3);
+
+  m_adapter->answer_all("{}");
+  std::this_thread::sleep_for(100ms);
+  executor.stop();
+}
+
+} // namespace uri_shortener::test
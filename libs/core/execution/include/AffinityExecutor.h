@@ -5,6 +5,7 @@
 #include "MessageQueue.h"
 
 #include <atomic>
+#include <limits>
 #include <memory>
 #include <thread>
 #include <vector>
@@ -13,6 +14,8 @@ namespace astra::execution {
 
 class AffinityExecutor : public IExecutor {
 public:
+  static constexpr size_t kNoLane = std::numeric_limits<size_t>::max();
+
   AffinityExecutor(size_t num_lanes, IMessageHandler &handler);
   ~AffinityExecutor() override;
 
@@ -28,6 +31,10 @@ public:
     return m_lanes.size();
   }
 
+  /// Index of the lane running the calling thread, kNoLane off-lane.
+  /// Lets handlers keep lock-free per-lane state.
+  [[nodiscard]] static size_t current_lane() noexcept;
+
 private:
   struct Lane {
     MessageQueue queue;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Context.h>
+#include <Deadline.h>
 #include <any>
 #include <cstdint>
 
@@ -10,6 +11,7 @@ struct Message {
   uint64_t affinity_key;
   astra::observability::Context trace_ctx;
   std::any payload;
+  astra::utils::Deadline deadline{}; // Unset unless the request carries one
 };
 
 } // namespace astra::execution
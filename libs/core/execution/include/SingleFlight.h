@@ -0,0 +1,53 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace astra::execution {
+
+/// Collapses concurrent calls for the same key into one.
+///
+/// The first caller for a key becomes the leader and runs the call; later
+/// callers only register a waiter. When the leader's result arrives,
+/// complete() hands back every waiter (leader first) to fan it out to.
+///
+/// Not thread-safe by design: it is meant to live on one AffinityExecutor
+/// lane, where every message for a key is handled by the same thread, so
+/// coalescing needs no lock. Keep one instance per lane.
+template <typename Waiter, typename Key = std::string>
+class SingleFlight {
+public:
+  /// Returns true if the caller is the leader and must start the call
+  bool join(const Key &key, Waiter waiter) {
+    auto [it, leader] = m_flights.try_emplace(key);
+    it->second.push_back(std::move(waiter));
+    return leader;
+  }
+
+  /// Ends the flight for key and returns its waiters
+  std::vector<Waiter> complete(const Key &key) {
+    auto it = m_flights.find(key);
+    if (it == m_flights.end()) {
+      return {};
+    }
+    auto waiters = std::move(it->second);
+    m_flights.erase(it);
+    return waiters;
+  }
+
+  [[nodiscard]] size_t in_flight() const noexcept {
+    return m_flights.size();
+  }
+
+  [[nodiscard]] size_t waiters(const Key &key) const {
+    auto it = m_flights.find(key);
+    return it == m_flights.end() ? 0 : it->second.size();
+  }
+
+private:
+  std::unordered_map<Key, std::vector<Waiter>> m_flights;
+};
+
+} // namespace astra::execution
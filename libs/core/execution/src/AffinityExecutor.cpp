@@ -2,6 +2,10 @@
 
 namespace astra::execution {
 
+namespace {
+thread_local size_t t_current_lane = AffinityExecutor::kNoLane;
+} // namespace
+
 AffinityExecutor::AffinityExecutor(size_t num_lanes, IMessageHandler &handler)
     : m_handler(handler) {
   m_lanes.reserve(num_lanes);
@@ -22,9 +26,10 @@ void AffinityExecutor::start() {
   }
   m_running.store(true);
 
-  for (auto &lane_ptr : m_lanes) {
-    Lane *lane = lane_ptr.get();
-    lane_ptr->thread = std::thread([this, lane]() {
+  for (size_t i = 0; i < m_lanes.size(); ++i) {
+    Lane *lane = m_lanes[i].get();
+    lane->thread = std::thread([this, lane, i]() {
+      t_current_lane = i;
       while (auto msg = lane->queue.pop()) {
         m_handler.handle(*msg);
       }
@@ -49,6 +54,10 @@ void AffinityExecutor::stop() {
   }
 }
 
+size_t AffinityExecutor::current_lane() noexcept {
+  return t_current_lane;
+}
+
 void AffinityExecutor::submit(Message msg) {
   size_t lane_idx = msg.affinity_key % m_lanes.size();
   m_lanes[lane_idx]->queue.push(std::move(msg));
@@ -3,6 +3,7 @@
 #include <atomic>
 #include <gtest/gtest.h>
 #include <latch>
+#include <map>
 #include <mutex>
 #include <set>
 #include <thread>
@@ -321,4 +322,49 @@ TEST_F(AffinityExecutorTest, LongRunningHandler) {
   EXPECT_EQ(handler.processed_count(), 4);
 }
 
+// =============================================================================
+// Lane Identity Tests
+// =============================================================================
+
+class LaneRecordingHandler : public IMessageHandler {
+public:
+  void handle(Message &msg) override {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_lanes[msg.affinity_key] = AffinityExecutor::current_lane();
+  }
+
+  std::map<uint64_t, size_t> lanes() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_lanes;
+  }
+
+private:
+  mutable std::mutex m_mutex;
+  std::map<uint64_t, size_t> m_lanes;
+};
+
+TEST(AffinityExecutorLaneTest, CurrentLaneMatchesAffinityKey) {
+  LaneRecordingHandler lane_handler;
+  AffinityExecutor executor(4, lane_handler);
+  executor.start();
+
+  for (uint64_t key = 0; key < 8; ++key) {
+    Message msg{.affinity_key = key, .trace_ctx = {}, .payload = {}};
+    executor.submit(std::move(msg));
+  }
+
+  std::this_thread::sleep_for(100ms);
+  executor.stop();
+
+  auto lanes = lane_handler.lanes();
+  ASSERT_EQ(lanes.size(), 8);
+  for (const auto &[key, lane] : lanes) {
+    EXPECT_EQ(lane, key % 4);
+  }
+}
+
+TEST(AffinityExecutorLaneTest, NoLaneOutsideExecutor) {
+  EXPECT_EQ(AffinityExecutor::current_lane(), AffinityExecutor::kNoLane);
+}
+
 } // namespace astra::execution
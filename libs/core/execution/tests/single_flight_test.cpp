@@ -0,0 +1,51 @@
+#include "SingleFlight.h"
+
+#include <gtest/gtest.h>
+
+using namespace astra::execution;
+
+TEST(SingleFlightTest, FirstCallerLeads) {
+  SingleFlight<int> flights;
+
+  EXPECT_TRUE(flights.join("find:abc", 1));
+  EXPECT_FALSE(flights.join("find:abc", 2));
+  EXPECT_FALSE(flights.join("find:abc", 3));
+
+  EXPECT_EQ(flights.in_flight(), 1);
+  EXPECT_EQ(flights.waiters("find:abc"), 3);
+}
+
+TEST(SingleFlightTest, KeysAreIndependent) {
+  SingleFlight<int> flights;
+
+  EXPECT_TRUE(flights.join("find:abc", 1));
+  EXPECT_TRUE(flights.join("find:xyz", 2));
+
+  EXPECT_EQ(flights.in_flight(), 2);
+}
+
+TEST(SingleFlightTest, CompleteReturnsWaitersLeaderFirst) {
+  SingleFlight<int> flights;
+  flights.join("find:abc", 1);
+  flights.join("find:abc", 2);
+  flights.join("find:abc", 3);
+
+  auto waiters = flights.complete("find:abc");
+
+  EXPECT_EQ(waiters, (std::vector<int>{1, 2, 3}));
+  EXPECT_EQ(flights.in_flight(), 0);
+}
+
+TEST(SingleFlightTest, NewFlightAfterComplete) {
+  SingleFlight<int> flights;
+  flights.join("find:abc", 1);
+  flights.complete("find:abc");
+
+  EXPECT_TRUE(flights.join("find:abc", 2));
+}
+
+TEST(SingleFlightTest, CompleteUnknownKeyIsEmpty) {
+  SingleFlight<int> flights;
+
+  EXPECT_TRUE(flights.complete("find:abc").empty());
+}
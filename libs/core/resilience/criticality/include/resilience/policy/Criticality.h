@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+
+namespace astra::resilience {
+
+// Request criticality tiers, highest first. Lower tiers are shed earlier so
+// that capacity stays available for the tiers above them.
+enum class Criticality { Critical, Default, Sheddable };
+
+inline constexpr size_t kCriticalityTiers = 3;
+
+[[nodiscard]] constexpr size_t to_index(Criticality criticality) noexcept {
+  return static_cast<size_t>(criticality);
+}
+
+[[nodiscard]] constexpr const char *
+to_string(Criticality criticality) noexcept {
+  switch (criticality) {
+  case Criticality::Critical:
+    return "critical";
+  case Criticality::Default:
+    return "default";
+  case Criticality::Sheddable:
+    return "sheddable";
+  }
+  return "unknown";
+}
+
+} // namespace astra::resilience
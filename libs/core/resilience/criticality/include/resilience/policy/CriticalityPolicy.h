@@ -0,0 +1,26 @@
+#pragma once
+
+#include <stdexcept>
+
+namespace astra::resilience {
+
+// Share of max_concurrent each tier may occupy before it starts shedding.
+// Critical traffic is never shed, so it has no share.
+struct CriticalityPolicy {
+  double default_share{1.0};
+  double sheddable_share{0.8};
+
+  static CriticalityPolicy create(double default_share,
+                                  double sheddable_share) {
+    if (default_share <= 0.0 || default_share > 1.0) {
+      throw std::invalid_argument("default_share must be in (0, 1]");
+    }
+    if (sheddable_share <= 0.0 || sheddable_share > default_share) {
+      throw std::invalid_argument(
+          "sheddable_share must be in (0, default_share]");
+    }
+    return CriticalityPolicy{default_share, sheddable_share};
+  }
+};
+
+} // namespace astra::resilience
@@ -1,35 +1,44 @@
 #pragma once
 
 #include <IScopedResource.h>
-#include <functional>
+#include <cstdint>
 #include <utility>
 
 namespace astra::resilience {
 
+// Holds one admitted slot until destroyed. Besides the IScopedResource
+// vptr the guard holds an owner pointer and an owner-defined token (a
+// stripe index, say), three words in all, so acquiring and moving it never
+// allocates. A default-constructed or moved-from guard holds nothing.
 class LoadShedderGuard : public astra::execution::IScopedResource {
 public:
-  using ReleaseFn = std::function<void()>;
+  class Owner {
+  public:
+    virtual void release(uint32_t token) noexcept = 0;
 
-  static LoadShedderGuard create(ReleaseFn release_fn) {
-    return LoadShedderGuard(std::move(release_fn));
+  protected:
+    ~Owner() = default;
+  };
+
+  static LoadShedderGuard create(Owner &owner, uint32_t token = 0) noexcept {
+    return LoadShedderGuard(&owner, token);
   }
 
+  LoadShedderGuard() noexcept = default;
+
   ~LoadShedderGuard() override {
-    if (m_release_fn) {
-      m_release_fn();
-    }
+    reset();
   }
 
   LoadShedderGuard(LoadShedderGuard &&other) noexcept
-      : m_release_fn(std::exchange(other.m_release_fn, nullptr)) {
+      : m_owner(std::exchange(other.m_owner, nullptr)), m_token(other.m_token) {
   }
 
   LoadShedderGuard &operator=(LoadShedderGuard &&other) noexcept {
     if (this != &other) {
-      if (m_release_fn) {
-        m_release_fn();
-      }
-      m_release_fn = std::exchange(other.m_release_fn, nullptr);
+      reset();
+      m_owner = std::exchange(other.m_owner, nullptr);
+      m_token = other.m_token;
     }
     return *this;
   }
@@ -37,12 +46,23 @@ public:
   LoadShedderGuard(const LoadShedderGuard &) = delete;
   LoadShedderGuard &operator=(const LoadShedderGuard &) = delete;
 
+  [[nodiscard]] bool holds() const noexcept {
+    return m_owner != nullptr;
+  }
+
+  void reset() noexcept {
+    if (auto *owner = std::exchange(m_owner, nullptr)) {
+      owner->release(m_token);
+    }
+  }
+
 private:
-  explicit LoadShedderGuard(ReleaseFn release_fn)
-      : m_release_fn(std::move(release_fn)) {
+  LoadShedderGuard(Owner *owner, uint32_t token) noexcept
+      : m_owner(owner), m_token(token) {
   }
 
-  ReleaseFn m_release_fn;
+  Owner *m_owner{};
+  uint32_t m_token{};
 };
 
 } // namespace astra::resilience
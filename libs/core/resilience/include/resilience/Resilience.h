@@ -2,4 +2,6 @@
 
 #include "resilience/ILoadShedder.h"
 #include "resilience/LoadShedderGuard.h"
+#include "resilience/policy/Criticality.h"
+#include "resilience/policy/CriticalityPolicy.h"
 #include "resilience/policy/LoadShedderPolicy.h"
@@ -7,7 +7,8 @@
 
 namespace astra::resilience {
 
-class AtomicLoadShedder : public ILoadShedder {
+class AtomicLoadShedder : public ILoadShedder,
+                         private LoadShedderGuard::Owner {
 public:
   explicit AtomicLoadShedder(LoadShedderPolicy policy);
 
@@ -17,7 +18,7 @@ public:
   [[nodiscard]] size_t max_concurrent() const override;
 
 private:
-  void release();
+  void release(uint32_t token) noexcept override;
 
   std::atomic<size_t> m_in_flight{0};
   std::atomic<size_t> m_max_concurrent;
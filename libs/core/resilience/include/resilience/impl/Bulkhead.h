@@ -0,0 +1,74 @@
+#pragma once
+
+#include "resilience/LoadShedderGuard.h"
+#include "resilience/policy/BulkheadPolicy.h"
+
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace astra::resilience {
+
+// Concurrency pool with a bounded wait queue, used to isolate one class of
+// outbound calls from another. A submitted task runs immediately if a slot
+// is free, waits in the queue if not, and is rejected once the queue is
+// full. The task receives a permit that holds the slot until it is
+// destroyed; releasing a permit starts the next queued task on the
+// releasing thread. Tasks that finish synchronously hand their slot back to
+// the same loop, so a long queue drains without growing the stack.
+class Bulkhead : private LoadShedderGuard::Owner {
+public:
+  using Clock = std::chrono::steady_clock;
+  using Permit = LoadShedderGuard;
+  using Task = std::function<void(Permit)>;
+  using Expired = std::function<void()>;
+
+  enum class Admission { Started, Queued, Rejected };
+
+  explicit Bulkhead(BulkheadPolicy policy);
+
+  // Rejected tasks are dropped without being invoked.
+  Admission submit(Task task);
+
+  // A queued task whose deadline passes before a slot frees up is dropped
+  // and on_expired runs instead. Expired entries are swept whenever a slot
+  // is released or the queue is full, so they never hold queue space that
+  // a live caller could use.
+  Admission submit(Task task, Clock::time_point deadline, Expired on_expired);
+
+  // Take a free slot without queuing, for optional work such as a hedged
+  // call that is only worth sending if it does not wait.
+  std::optional<Permit> try_acquire();
+
+  // Lowering max_concurrent does not cancel running tasks; queued tasks
+  // start only once in-flight is back under the new limit.
+  void update_policy(const BulkheadPolicy &policy);
+
+  [[nodiscard]] size_t in_flight() const;
+  [[nodiscard]] size_t queued() const;
+  [[nodiscard]] BulkheadPolicy policy() const;
+
+private:
+  struct Waiter {
+    Task task;
+    Clock::time_point deadline;
+    Expired on_expired;
+  };
+
+  Permit make_permit();
+  void release(uint32_t token) noexcept override;
+  // Pass one freed slot to the next live waiter, or give it back
+  void hand_off();
+  // Caller holds m_mutex
+  void take_expired(Clock::time_point now, std::vector<Expired> &expired);
+
+  mutable std::mutex m_mutex;
+  BulkheadPolicy m_policy;
+  size_t m_in_flight{0};
+  std::deque<Waiter> m_queue;
+};
+
+} // namespace astra::resilience
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "resilience/ILoadShedder.h"
+#include "resilience/policy/Criticality.h"
+#include "resilience/policy/CriticalityPolicy.h"
+#include "resilience/policy/LoadShedderPolicy.h"
+
+#include <array>
+#include <atomic>
+
+namespace astra::resilience {
+
+// Load shedder with criticality tiers sharing one in-flight budget.
+// Each tier is admitted only while in-flight is below its share of
+// max_concurrent, so sheddable traffic is rejected first and the headroom
+// above its share stays reserved for higher tiers. Critical requests are
+// counted but never rejected.
+class CriticalityLoadShedder : public ILoadShedder,
+                              private LoadShedderGuard::Owner {
+public:
+  explicit CriticalityLoadShedder(LoadShedderPolicy policy,
+                                  CriticalityPolicy tiers = {});
+
+  // Acquires at Criticality::Default.
+  std::optional<LoadShedderGuard> try_acquire() override;
+  [[nodiscard]] std::optional<LoadShedderGuard>
+  try_acquire(Criticality criticality);
+
+  // Policy updates are expected from a single control thread.
+  void update_policy(const LoadShedderPolicy &policy) override;
+  void update_tiers(const CriticalityPolicy &tiers);
+  // Applies both at once so the limits are recomputed a single time.
+  void update(const LoadShedderPolicy &policy, const CriticalityPolicy &tiers);
+
+  [[nodiscard]] size_t current_count() const override;
+  [[nodiscard]] size_t max_concurrent() const override;
+  [[nodiscard]] size_t tier_limit(Criticality criticality) const;
+
+private:
+  void release(uint32_t token) noexcept override;
+  void recompute_limits();
+
+  std::atomic<size_t> m_in_flight{0};
+  std::atomic<size_t> m_max_concurrent;
+  std::array<std::atomic<size_t>, kCriticalityTiers> m_tier_limits{};
+  CriticalityPolicy m_tiers;
+  std::string m_name;
+};
+
+} // namespace astra::resilience
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace astra::resilience {
+
+// Token bucket that caps hedged calls at a fraction of primary calls.
+// Every primary call deposits `ratio` tokens, every hedge spends one, and
+// the balance is capped so an idle period cannot bank a hedge burst.
+class HedgeBudget {
+public:
+  explicit HedgeBudget(double ratio, double max_tokens = 10.0);
+
+  void on_request() noexcept;
+  [[nodiscard]] bool try_spend() noexcept;
+
+  void set_ratio(double ratio) noexcept;
+  [[nodiscard]] double tokens() const noexcept;
+
+private:
+  static constexpr int64_t kScale = 1000; // Fixed point, 1 token = 1000
+
+  std::atomic<int64_t> m_deposit;
+  const int64_t m_max;
+  std::atomic<int64_t> m_balance{0};
+};
+
+} // namespace astra::resilience
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace astra::resilience {
+
+// Online latency quantile estimate over a rolling window of recent samples.
+// Samples land in log-spaced buckets (4 per power of two, so ~19% relative
+// error) and the window is two generations of `window` samples each, so the
+// estimate follows shifts in latency within a couple of windows. Recording
+// is lock-free; concurrent rotation may misplace a few samples, which is
+// fine for an estimate.
+class LatencyTracker {
+public:
+  static constexpr size_t kBuckets = 96; // 1us .. ~16s
+
+  explicit LatencyTracker(size_t window = 1000);
+
+  void record(std::chrono::microseconds latency) noexcept;
+
+  // Upper bound of the bucket holding quantile q; zero when no samples
+  [[nodiscard]] std::chrono::microseconds quantile(double q) const noexcept;
+  [[nodiscard]] size_t sample_count() const noexcept;
+
+private:
+  using Histogram = std::array<std::atomic<uint32_t>, kBuckets>;
+
+  static size_t bucket_for(std::chrono::microseconds latency) noexcept;
+  static std::chrono::microseconds bucket_upper(size_t bucket) noexcept;
+
+  const size_t m_window;
+  std::array<Histogram, 2> m_generations{};
+  std::atomic<size_t> m_generation{0};
+  std::atomic<size_t> m_in_generation{0};
+};
+
+} // namespace astra::resilience
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "resilience/ILoadShedder.h"
+#include "resilience/policy/LoadShedderPolicy.h"
+
+#include <atomic>
+#include <memory>
+
+namespace astra::resilience {
+
+// Load shedder that spreads the in-flight count over cache-line sized
+// stripes so concurrent acquires on many cores do not all bounce one line.
+// max_concurrent is split across the stripes and each thread acquires from
+// its home stripe, borrowing from at most kSpillStripes neighbours when that
+// one is full. A rejection therefore touches a bounded number of lines no
+// matter how many stripes there are. When max_concurrent is below the
+// stripe count only as many stripes are used as keep a share of at least
+// one, so tiny limits do not leave most stripes empty.
+//
+// Admission is approximate: an acquire can be rejected while capacity is
+// free on stripes outside its window, or on ones it already scanned, and
+// after max_concurrent is lowered the stripes converge to their new shares
+// only as in-flight requests drain. current_count() folds all stripes into
+// an exact total on demand for metrics.
+class StripedLoadShedder : public ILoadShedder,
+                           private LoadShedderGuard::Owner {
+public:
+  static constexpr size_t kMaxStripes = 64;
+  static constexpr size_t kSpillStripes = 2;
+
+  // stripes == 0 picks one per hardware thread, rounded up to a power of
+  // two and capped at kMaxStripes.
+  explicit StripedLoadShedder(LoadShedderPolicy policy, size_t stripes = 0);
+
+  std::optional<LoadShedderGuard> try_acquire() override;
+  void update_policy(const LoadShedderPolicy &policy) override;
+  [[nodiscard]] size_t current_count() const override;
+  [[nodiscard]] size_t max_concurrent() const override;
+
+  [[nodiscard]] size_t stripe_count() const noexcept {
+    return m_stripe_mask + 1;
+  }
+
+private:
+  struct alignas(64) Stripe {
+    std::atomic<size_t> in_flight{0};
+  };
+
+  bool try_acquire_stripe(Stripe &stripe, size_t limit);
+  void release(uint32_t stripe) noexcept override;
+
+  std::unique_ptr<Stripe[]> m_stripes;
+  size_t m_stripe_mask;
+  size_t m_stripe_shift;
+  std::atomic<size_t> m_max_concurrent;
+  std::string m_name;
+};
+
+} // namespace astra::resilience
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <stdexcept>
+#include <string>
+
+namespace astra::resilience {
+
+struct BulkheadPolicy {
+  size_t max_concurrent{0};
+  size_t max_queue{0}; // Calls waiting for a slot; 0 = fail fast when full
+  std::string name{};
+
+  static BulkheadPolicy create(size_t max_concurrent, size_t max_queue,
+                               std::string name) {
+    if (max_concurrent == 0) {
+      throw std::invalid_argument("max_concurrent must be greater than 0");
+    }
+    return BulkheadPolicy{max_concurrent, max_queue, std::move(name)};
+  }
+};
+
+} // namespace astra::resilience
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <chrono>
+#include <stdexcept>
+
+namespace astra::resilience {
+
+struct HedgingPolicy {
+  double quantile{0.95};     // Hedge once a call outlives this latency
+  double budget_ratio{0.05}; // Hedges allowed per primary call
+  std::chrono::milliseconds min_delay{1};
+  std::chrono::milliseconds max_delay{1000};
+  size_t min_samples{100}; // No hedging until the quantile is meaningful
+
+  static HedgingPolicy create(double quantile, double budget_ratio,
+                              std::chrono::milliseconds min_delay,
+                              std::chrono::milliseconds max_delay) {
+    if (quantile <= 0.0 || quantile >= 1.0) {
+      throw std::invalid_argument("quantile must be in (0, 1)");
+    }
+    if (budget_ratio < 0.0 || budget_ratio > 1.0) {
+      throw std::invalid_argument("budget_ratio must be in [0, 1]");
+    }
+    if (min_delay > max_delay) {
+      throw std::invalid_argument("min_delay must not exceed max_delay");
+    }
+    return HedgingPolicy{quantile, budget_ratio, min_delay, max_delay};
+  }
+};
+
+} // namespace astra::resilience
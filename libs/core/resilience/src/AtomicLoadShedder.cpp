@@ -19,14 +19,12 @@ std::optional<LoadShedderGuard> AtomicLoadShedder::try_acquire() {
     if (m_in_flight.compare_exchange_weak(current, current + 1,
                                           std::memory_order_acquire,
                                           std::memory_order_relaxed)) {
-      return LoadShedderGuard::create([this]() {
-        release();
-      });
+      return LoadShedderGuard::create(*this);
     }
   }
 }
 
-void AtomicLoadShedder::release() {
+void AtomicLoadShedder::release(uint32_t /*token*/) noexcept {
   m_in_flight.fetch_sub(1, std::memory_order_release);
 }
 
@@ -0,0 +1,147 @@
+#include "resilience/impl/Bulkhead.h"
+
+namespace astra::resilience {
+
+namespace {
+
+// Bulkhead whose release loop is running on this thread, and how many slots
+// were released back into it by tasks that finished synchronously.
+struct Drain {
+  const void *bulkhead{nullptr};
+  size_t pending{0};
+};
+thread_local Drain t_drain;
+
+void run_expired(std::vector<Bulkhead::Expired> &expired) {
+  for (auto &on_expired : expired) {
+    if (on_expired) {
+      on_expired();
+    }
+  }
+}
+
+} // namespace
+
+Bulkhead::Bulkhead(BulkheadPolicy policy) : m_policy(std::move(policy)) {
+}
+
+Bulkhead::Admission Bulkhead::submit(Task task) {
+  return submit(std::move(task), Clock::time_point::max(), nullptr);
+}
+
+Bulkhead::Admission Bulkhead::submit(Task task, Clock::time_point deadline,
+                                     Expired on_expired) {
+  std::vector<Expired> expired;
+  Admission admission = Admission::Started;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_in_flight >= m_policy.max_concurrent) {
+      if (m_queue.size() >= m_policy.max_queue) {
+        take_expired(Clock::now(), expired);
+      }
+      if (m_queue.size() >= m_policy.max_queue) {
+        admission = Admission::Rejected;
+      } else {
+        m_queue.push_back(
+            Waiter{std::move(task), deadline, std::move(on_expired)});
+        admission = Admission::Queued;
+      }
+    } else {
+      ++m_in_flight;
+    }
+  }
+
+  run_expired(expired);
+  if (admission == Admission::Started) {
+    task(make_permit());
+  }
+  return admission;
+}
+
+std::optional<Bulkhead::Permit> Bulkhead::try_acquire() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_in_flight >= m_policy.max_concurrent) {
+      return std::nullopt;
+    }
+    ++m_in_flight;
+  }
+  return make_permit();
+}
+
+Bulkhead::Permit Bulkhead::make_permit() {
+  return Permit::create(*this);
+}
+
+void Bulkhead::release(uint32_t /*token*/) noexcept {
+  // A task started below may finish before returning and release its permit
+  // again; count that slot for this loop instead of recursing into it.
+  if (t_drain.bulkhead == this) {
+    ++t_drain.pending;
+    return;
+  }
+
+  Drain outer = t_drain;
+  t_drain = Drain{this, 1};
+  while (t_drain.pending > 0) {
+    --t_drain.pending;
+    hand_off();
+  }
+  t_drain = outer;
+}
+
+void Bulkhead::hand_off() {
+  std::vector<Expired> expired;
+  Task next;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    take_expired(Clock::now(), expired);
+    // The slot passes straight to the next queued task, unless the limit
+    // was lowered below what is currently running.
+    if (m_queue.empty() || m_in_flight > m_policy.max_concurrent) {
+      --m_in_flight;
+    } else {
+      next = std::move(m_queue.front().task);
+      m_queue.pop_front();
+    }
+  }
+
+  run_expired(expired);
+  if (next) {
+    next(make_permit());
+  }
+}
+
+void Bulkhead::take_expired(Clock::time_point now,
+                            std::vector<Expired> &expired) {
+  for (auto it = m_queue.begin(); it != m_queue.end();) {
+    if (it->deadline <= now) {
+      expired.push_back(std::move(it->on_expired));
+      it = m_queue.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void Bulkhead::update_policy(const BulkheadPolicy &policy) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_policy = policy;
+}
+
+size_t Bulkhead::in_flight() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_in_flight;
+}
+
+size_t Bulkhead::queued() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_queue.size();
+}
+
+BulkheadPolicy Bulkhead::policy() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_policy;
+}
+
+} // namespace astra::resilience
@@ -0,0 +1,90 @@
+#include "resilience/impl/CriticalityLoadShedder.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace astra::resilience {
+
+namespace {
+
+size_t share_of(size_t max, double share) {
+  return std::max<size_t>(1, static_cast<size_t>(max * share));
+}
+
+} // namespace
+
+CriticalityLoadShedder::CriticalityLoadShedder(LoadShedderPolicy policy,
+                                               CriticalityPolicy tiers)
+    : m_max_concurrent(policy.max_concurrent), m_tiers(tiers),
+      m_name(std::move(policy.name)) {
+  recompute_limits();
+}
+
+std::optional<LoadShedderGuard> CriticalityLoadShedder::try_acquire() {
+  return try_acquire(Criticality::Default);
+}
+
+std::optional<LoadShedderGuard>
+CriticalityLoadShedder::try_acquire(Criticality criticality) {
+  size_t limit =
+      m_tier_limits[to_index(criticality)].load(std::memory_order_relaxed);
+  size_t current = m_in_flight.load(std::memory_order_relaxed);
+
+  while (true) {
+    if (current >= limit) {
+      return std::nullopt;
+    }
+
+    if (m_in_flight.compare_exchange_weak(current, current + 1,
+                                          std::memory_order_acquire,
+                                          std::memory_order_relaxed)) {
+      return LoadShedderGuard::create(*this);
+    }
+  }
+}
+
+void CriticalityLoadShedder::release(uint32_t /*token*/) noexcept {
+  m_in_flight.fetch_sub(1, std::memory_order_release);
+}
+
+void CriticalityLoadShedder::update_policy(const LoadShedderPolicy &policy) {
+  m_max_concurrent.store(policy.max_concurrent, std::memory_order_relaxed);
+  recompute_limits();
+}
+
+void CriticalityLoadShedder::update_tiers(const CriticalityPolicy &tiers) {
+  m_tiers = tiers;
+  recompute_limits();
+}
+
+void CriticalityLoadShedder::update(const LoadShedderPolicy &policy,
+                                    const CriticalityPolicy &tiers) {
+  m_max_concurrent.store(policy.max_concurrent, std::memory_order_relaxed);
+  m_tiers = tiers;
+  recompute_limits();
+}
+
+void CriticalityLoadShedder::recompute_limits() {
+  size_t max = m_max_concurrent.load(std::memory_order_relaxed);
+
+  m_tier_limits[to_index(Criticality::Critical)].store(
+      std::numeric_limits<size_t>::max(), std::memory_order_relaxed);
+  m_tier_limits[to_index(Criticality::Default)].store(
+      share_of(max, m_tiers.default_share), std::memory_order_relaxed);
+  m_tier_limits[to_index(Criticality::Sheddable)].store(
+      share_of(max, m_tiers.sheddable_share), std::memory_order_relaxed);
+}
+
+size_t CriticalityLoadShedder::current_count() const {
+  return m_in_flight.load(std::memory_order_relaxed);
+}
+
+size_t CriticalityLoadShedder::max_concurrent() const {
+  return m_max_concurrent.load(std::memory_order_relaxed);
+}
+
+size_t CriticalityLoadShedder::tier_limit(Criticality criticality) const {
+  return m_tier_limits[to_index(criticality)].load(std::memory_order_relaxed);
+}
+
+} // namespace astra::resilience
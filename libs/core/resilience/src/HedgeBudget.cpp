@@ -0,0 +1,45 @@
+#include "resilience/impl/HedgeBudget.h"
+
+#include <algorithm>
+
+namespace astra::resilience {
+
+HedgeBudget::HedgeBudget(double ratio, double max_tokens)
+    : m_deposit(static_cast<int64_t>(ratio * kScale)),
+      m_max(static_cast<int64_t>(max_tokens * kScale)) {
+}
+
+void HedgeBudget::on_request() noexcept {
+  int64_t deposit = m_deposit.load(std::memory_order_relaxed);
+  int64_t current = m_balance.load(std::memory_order_relaxed);
+  while (current < m_max) {
+    int64_t next = std::min(current + deposit, m_max);
+    if (m_balance.compare_exchange_weak(current, next,
+                                        std::memory_order_relaxed)) {
+      return;
+    }
+  }
+}
+
+bool HedgeBudget::try_spend() noexcept {
+  int64_t current = m_balance.load(std::memory_order_relaxed);
+  while (current >= kScale) {
+    if (m_balance.compare_exchange_weak(current, current - kScale,
+                                        std::memory_order_relaxed)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void HedgeBudget::set_ratio(double ratio) noexcept {
+  m_deposit.store(static_cast<int64_t>(ratio * kScale),
+                  std::memory_order_relaxed);
+}
+
+double HedgeBudget::tokens() const noexcept {
+  return static_cast<double>(m_balance.load(std::memory_order_relaxed)) /
+         kScale;
+}
+
+} // namespace astra::resilience
@@ -0,0 +1,79 @@
+#include "resilience/impl/LatencyTracker.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace astra::resilience {
+
+LatencyTracker::LatencyTracker(size_t window)
+    : m_window(std::max<size_t>(1, window)) {
+}
+
+size_t LatencyTracker::bucket_for(std::chrono::microseconds latency) noexcept {
+  auto us = latency.count();
+  if (us <= 1) {
+    return 0;
+  }
+  auto bucket = static_cast<size_t>(std::ceil(4.0 * std::log2(us)));
+  return std::min(bucket, kBuckets - 1);
+}
+
+std::chrono::microseconds
+LatencyTracker::bucket_upper(size_t bucket) noexcept {
+  return std::chrono::microseconds(
+      static_cast<int64_t>(std::ceil(std::exp2(bucket / 4.0))));
+}
+
+void LatencyTracker::record(std::chrono::microseconds latency) noexcept {
+  size_t generation = m_generation.load(std::memory_order_acquire);
+  m_generations[generation & 1][bucket_for(latency)].fetch_add(
+      1, std::memory_order_relaxed);
+
+  if (m_in_generation.fetch_add(1, std::memory_order_relaxed) + 1 ==
+      m_window) {
+    // The oldest generation is dropped and reused for new samples
+    auto &next = m_generations[(generation + 1) & 1];
+    for (auto &count : next) {
+      count.store(0, std::memory_order_relaxed);
+    }
+    m_in_generation.store(0, std::memory_order_relaxed);
+    m_generation.store(generation + 1, std::memory_order_release);
+  }
+}
+
+std::chrono::microseconds LatencyTracker::quantile(double q) const noexcept {
+  std::array<uint64_t, kBuckets> merged{};
+  uint64_t total = 0;
+  for (const auto &histogram : m_generations) {
+    for (size_t i = 0; i < kBuckets; ++i) {
+      auto count = histogram[i].load(std::memory_order_relaxed);
+      merged[i] += count;
+      total += count;
+    }
+  }
+  if (total == 0) {
+    return std::chrono::microseconds::zero();
+  }
+
+  auto rank = static_cast<uint64_t>(std::ceil(q * static_cast<double>(total)));
+  uint64_t seen = 0;
+  for (size_t i = 0; i < kBuckets; ++i) {
+    seen += merged[i];
+    if (seen >= rank) {
+      return bucket_upper(i);
+    }
+  }
+  return bucket_upper(kBuckets - 1);
+}
+
+size_t LatencyTracker::sample_count() const noexcept {
+  size_t total = 0;
+  for (const auto &histogram : m_generations) {
+    for (const auto &count : histogram) {
+      total += count.load(std::memory_order_relaxed);
+    }
+  }
+  return total;
+}
+
+} // namespace astra::resilience
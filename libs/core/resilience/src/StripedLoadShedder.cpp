@@ -0,0 +1,103 @@
+#include "resilience/impl/StripedLoadShedder.h"
+
+#include <algorithm>
+#include <thread>
+
+namespace astra::resilience {
+
+namespace {
+
+size_t log2_ceil(size_t n) {
+  size_t shift = 0;
+  while ((size_t{1} << shift) < n) {
+    ++shift;
+  }
+  return shift;
+}
+
+size_t log2_floor(size_t n) {
+  size_t shift = 0;
+  while ((n >> (shift + 1)) != 0) {
+    ++shift;
+  }
+  return shift;
+}
+
+// Threads are assigned home stripes round-robin on first use, which spreads
+// pool threads evenly without needing the current CPU id.
+size_t thread_slot() {
+  static std::atomic<size_t> next{0};
+  thread_local const size_t slot = next.fetch_add(1, std::memory_order_relaxed);
+  return slot;
+}
+
+} // namespace
+
+StripedLoadShedder::StripedLoadShedder(LoadShedderPolicy policy,
+                                       size_t stripes)
+    : m_max_concurrent(policy.max_concurrent), m_name(std::move(policy.name)) {
+  if (stripes == 0) {
+    stripes = std::max<size_t>(1, std::thread::hardware_concurrency());
+  }
+  m_stripe_shift = log2_ceil(std::min(stripes, kMaxStripes));
+  m_stripe_mask = (size_t{1} << m_stripe_shift) - 1;
+  m_stripes = std::make_unique<Stripe[]>(m_stripe_mask + 1);
+}
+
+std::optional<LoadShedderGuard> StripedLoadShedder::try_acquire() {
+  // Use the largest power-of-two prefix of stripes that still gives every
+  // stripe a share. Stripe i owns max / stripes slots, plus one of the
+  // remainder if i is below it, so the stripe limits sum to exactly
+  // max_concurrent.
+  size_t max = m_max_concurrent.load(std::memory_order_relaxed);
+  size_t shift = std::min(m_stripe_shift, log2_floor(max));
+  size_t mask = (size_t{1} << shift) - 1;
+  size_t base = max >> shift;
+  size_t remainder = max & mask;
+  size_t home = thread_slot() & mask;
+  size_t probes = std::min(mask, kSpillStripes);
+
+  for (size_t i = 0; i <= probes; ++i) {
+    size_t index = (home + i) & mask;
+    size_t limit = base + (index < remainder ? 1 : 0);
+    if (try_acquire_stripe(m_stripes[index], limit)) {
+      return LoadShedderGuard::create(*this, static_cast<uint32_t>(index));
+    }
+  }
+  return std::nullopt;
+}
+
+bool StripedLoadShedder::try_acquire_stripe(Stripe &stripe, size_t limit) {
+  size_t current = stripe.in_flight.load(std::memory_order_relaxed);
+
+  while (current < limit) {
+    if (stripe.in_flight.compare_exchange_weak(current, current + 1,
+                                               std::memory_order_acquire,
+                                               std::memory_order_relaxed)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void StripedLoadShedder::release(uint32_t stripe) noexcept {
+  m_stripes[stripe].in_flight.fetch_sub(1, std::memory_order_release);
+}
+
+void StripedLoadShedder::update_policy(const LoadShedderPolicy &policy) {
+  m_max_concurrent.store(policy.max_concurrent, std::memory_order_relaxed);
+}
+
+size_t StripedLoadShedder::current_count() const {
+  size_t total = 0;
+  for (size_t i = 0; i <= m_stripe_mask; ++i) {
+    total += m_stripes[i].in_flight.load(std::memory_order_relaxed);
+  }
+  return total;
+}
+
+size_t StripedLoadShedder::max_concurrent() const {
+  return m_max_concurrent.load(std::memory_order_relaxed);
+}
+
+} // namespace astra::resilience
@@ -0,0 +1,236 @@
+#include "resilience/impl/Bulkhead.h"
+#include "resilience/policy/BulkheadPolicy.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <gtest/gtest.h>
+#include <optional>
+#include <thread>
+#include <vector>
+
+using namespace astra::resilience;
+
+using Permits = std::deque<Bulkhead::Permit>;
+
+class BulkheadTest : public ::testing::Test {
+protected:
+  BulkheadPolicy policy = BulkheadPolicy::create(2, 1, "test");
+
+  // Task that parks its permit in `permits` so the slot stays held
+  Bulkhead::Task hold(Permits &permits) {
+    return [&permits](Bulkhead::Permit permit) {
+      permits.emplace_back(std::move(permit));
+    };
+  }
+
+  // Releasing a permit may start a queued task that appends to `permits`,
+  // so take each one out of the container before dropping it.
+  void drain(Permits &permits) {
+    while (!permits.empty()) {
+      auto permit = std::move(permits.front());
+      permits.pop_front();
+    }
+  }
+};
+
+TEST_F(BulkheadTest, StartsImmediatelyWhenSlotFree) {
+  Bulkhead bulkhead(policy);
+  bool ran = false;
+
+  auto admission = bulkhead.submit([&ran](Bulkhead::Permit) {
+    ran = true;
+  });
+
+  EXPECT_EQ(admission, Bulkhead::Admission::Started);
+  EXPECT_TRUE(ran);
+  EXPECT_EQ(bulkhead.in_flight(), 0);
+}
+
+TEST_F(BulkheadTest, QueuesWhenFullThenRejects) {
+  Bulkhead bulkhead(policy);
+  Permits permits;
+
+  EXPECT_EQ(bulkhead.submit(hold(permits)), Bulkhead::Admission::Started);
+  EXPECT_EQ(bulkhead.submit(hold(permits)), Bulkhead::Admission::Started);
+  EXPECT_EQ(bulkhead.submit(hold(permits)), Bulkhead::Admission::Queued);
+  EXPECT_EQ(bulkhead.submit(hold(permits)), Bulkhead::Admission::Rejected);
+
+  EXPECT_EQ(bulkhead.in_flight(), 2);
+  EXPECT_EQ(bulkhead.queued(), 1);
+  EXPECT_EQ(permits.size(), 2);
+
+  drain(permits);
+  EXPECT_EQ(bulkhead.in_flight(), 0);
+}
+
+TEST_F(BulkheadTest, ZeroQueueFailsFast) {
+  Bulkhead bulkhead(BulkheadPolicy::create(1, 0, "no-queue"));
+  Permits permits;
+
+  EXPECT_EQ(bulkhead.submit(hold(permits)), Bulkhead::Admission::Started);
+  EXPECT_EQ(bulkhead.submit(hold(permits)), Bulkhead::Admission::Rejected);
+}
+
+TEST_F(BulkheadTest, ReleaseStartsNextQueuedTask) {
+  Bulkhead bulkhead(policy);
+  Permits permits;
+
+  bulkhead.submit(hold(permits));
+  bulkhead.submit(hold(permits));
+  bulkhead.submit(hold(permits));
+  ASSERT_EQ(permits.size(), 2);
+
+  permits[0].reset();
+
+  EXPECT_EQ(permits.size(), 3);
+  EXPECT_EQ(bulkhead.in_flight(), 2);
+  EXPECT_EQ(bulkhead.queued(), 0);
+
+  drain(permits);
+  EXPECT_EQ(bulkhead.in_flight(), 0);
+}
+
+TEST_F(BulkheadTest, LoweredLimitDrainsBeforeDequeuing) {
+  Bulkhead bulkhead(BulkheadPolicy::create(3, 4, "shrink"));
+  Permits permits;
+
+  for (int i = 0; i < 4; ++i) {
+    bulkhead.submit(hold(permits));
+  }
+  ASSERT_EQ(permits.size(), 3);
+  bulkhead.update_policy(BulkheadPolicy::create(1, 4, "shrink"));
+
+  permits[0].reset();
+  EXPECT_EQ(bulkhead.queued(), 1);
+  permits[1].reset();
+  EXPECT_EQ(bulkhead.queued(), 1);
+
+  permits[2].reset();
+  EXPECT_EQ(bulkhead.queued(), 0);
+  EXPECT_EQ(bulkhead.in_flight(), 1);
+
+  drain(permits);
+}
+
+TEST_F(BulkheadTest, SynchronousTasksDrainQueueWithoutRecursion) {
+  Bulkhead bulkhead(BulkheadPolicy::create(1, 1000, "chain"));
+  Permits permits;
+  int depth = 0;
+  int max_depth = 0;
+  int completed = 0;
+
+  bulkhead.submit(hold(permits));
+  for (int i = 0; i < 1000; ++i) {
+    bulkhead.submit([&](Bulkhead::Permit) {
+      max_depth = std::max(max_depth, ++depth);
+      ++completed;
+      --depth;
+    });
+  }
+  ASSERT_EQ(bulkhead.queued(), 1000);
+
+  drain(permits);
+
+  EXPECT_EQ(completed, 1000);
+  EXPECT_EQ(max_depth, 1);
+  EXPECT_EQ(bulkhead.in_flight(), 0);
+  EXPECT_EQ(bulkhead.queued(), 0);
+}
+
+TEST_F(BulkheadTest, ExpiredWaiterIsRejectedInsteadOfRun) {
+  Bulkhead bulkhead(BulkheadPolicy::create(1, 2, "deadline"));
+  Permits permits;
+  bool ran = false;
+  bool expired = false;
+  bool live_ran = false;
+
+  bulkhead.submit(hold(permits));
+  auto past = Bulkhead::Clock::now() - std::chrono::milliseconds(1);
+  EXPECT_EQ(bulkhead.submit([&ran](Bulkhead::Permit) { ran = true; }, past,
+                            [&expired]() { expired = true; }),
+            Bulkhead::Admission::Queued);
+  bulkhead.submit([&live_ran](Bulkhead::Permit) { live_ran = true; });
+
+  drain(permits);
+
+  EXPECT_TRUE(expired);
+  EXPECT_FALSE(ran);
+  EXPECT_TRUE(live_ran);
+  EXPECT_EQ(bulkhead.in_flight(), 0);
+}
+
+TEST_F(BulkheadTest, FullQueueSweepsExpiredWaiters) {
+  Bulkhead bulkhead(BulkheadPolicy::create(1, 1, "sweep"));
+  Permits permits;
+  bool expired = false;
+
+  bulkhead.submit(hold(permits));
+  bulkhead.submit(hold(permits),
+                  Bulkhead::Clock::now() - std::chrono::milliseconds(1),
+                  [&expired]() { expired = true; });
+
+  EXPECT_EQ(bulkhead.submit(hold(permits)), Bulkhead::Admission::Queued);
+  EXPECT_TRUE(expired);
+  EXPECT_EQ(bulkhead.queued(), 1);
+
+  drain(permits);
+  EXPECT_EQ(bulkhead.in_flight(), 0);
+}
+
+TEST_F(BulkheadTest, TryAcquireNeverQueues) {
+  Bulkhead bulkhead(BulkheadPolicy::create(1, 4, "optional"));
+
+  auto first = bulkhead.try_acquire();
+  ASSERT_TRUE(first.has_value());
+  EXPECT_EQ(bulkhead.in_flight(), 1);
+
+  EXPECT_FALSE(bulkhead.try_acquire().has_value());
+  EXPECT_EQ(bulkhead.queued(), 0);
+
+  first.reset();
+  EXPECT_EQ(bulkhead.in_flight(), 0);
+}
+
+TEST_F(BulkheadTest, ConcurrentSubmitsRespectLimit) {
+  Bulkhead bulkhead(BulkheadPolicy::create(4, 16, "stress"));
+  std::atomic<size_t> running{0};
+  std::atomic<size_t> max_running{0};
+  std::atomic<size_t> completed{0};
+  std::atomic<size_t> rejected{0};
+
+  auto worker = [&]() {
+    for (int i = 0; i < 500; ++i) {
+      auto admission = bulkhead.submit([&](Bulkhead::Permit) {
+        size_t now = running.fetch_add(1) + 1;
+        size_t seen = max_running.load();
+        while (now > seen && !max_running.compare_exchange_weak(seen, now)) {
+        }
+        std::this_thread::yield();
+        running.fetch_sub(1);
+        completed.fetch_add(1);
+      });
+      if (admission == Bulkhead::Admission::Rejected) {
+        rejected.fetch_add(1);
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 8; ++i) {
+    threads.emplace_back(worker);
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+
+  EXPECT_LE(max_running.load(), 4);
+  EXPECT_EQ(completed.load() + rejected.load(), 8 * 500);
+  EXPECT_EQ(bulkhead.in_flight(), 0);
+  EXPECT_EQ(bulkhead.queued(), 0);
+}
+
+TEST(BulkheadPolicyTest, RejectsZeroConcurrency) {
+  EXPECT_THROW(BulkheadPolicy::create(0, 10, "bad"), std::invalid_argument);
+}
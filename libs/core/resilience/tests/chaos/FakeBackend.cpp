@@ -0,0 +1,109 @@
+#include "FakeBackend.h"
+
+#include <Http2Server.h>
+
+namespace astra::resilience::chaos {
+
+FakeBackend::FakeBackend(uint16_t port, size_t workers, FaultProfile profile)
+    : m_port(port), m_profile(profile), m_worker_count(workers) {
+  http2::ServerConfig config;
+  config.set_address("127.0.0.1");
+  config.set_port(port);
+  config.set_thread_count(1);
+  m_server = std::make_unique<http2::Http2Server>(config);
+
+  m_server->router().get(
+      "/work", [this](std::shared_ptr<router::IRequest>,
+                      std::shared_ptr<router::IResponse> res) {
+        {
+          std::lock_guard<std::mutex> lock(m_mutex);
+          m_queue.push_back(std::move(res));
+        }
+        m_cv.notify_one();
+      });
+}
+
+FakeBackend::~FakeBackend() {
+  stop();
+}
+
+bool FakeBackend::start() {
+  for (size_t i = 0; i < m_worker_count; ++i) {
+    m_workers.emplace_back([this, i]() {
+      work(static_cast<unsigned>(i + 1));
+    });
+  }
+  return m_server->start().is_ok();
+}
+
+void FakeBackend::stop() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_stopping) {
+      return;
+    }
+    m_stopping = true;
+  }
+  m_cv.notify_all();
+  for (auto &worker : m_workers) {
+    worker.join();
+  }
+  if (m_server->stop().is_ok()) {
+    m_server->join();
+  }
+}
+
+void FakeBackend::set_profile(FaultProfile profile) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_profile = profile;
+}
+
+size_t FakeBackend::queued() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_queue.size();
+}
+
+void FakeBackend::work(unsigned seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+  while (true) {
+    std::shared_ptr<router::IResponse> res;
+    FaultProfile profile;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_cv.wait(lock, [this]() {
+        return m_stopping || !m_queue.empty();
+      });
+      if (m_stopping) {
+        return;
+      }
+      res = std::move(m_queue.front());
+      m_queue.pop_front();
+      profile = m_profile;
+    }
+
+    auto service_time = profile.latency;
+    if (profile.jitter.count() > 0) {
+      service_time += std::chrono::microseconds(static_cast<int64_t>(
+          unit(rng) * static_cast<double>(profile.jitter.count())));
+    }
+    std::this_thread::sleep_for(service_time);
+    m_served.fetch_add(1, std::memory_order_relaxed);
+
+    double roll = unit(rng);
+    if (roll < profile.drop_rate) {
+      continue; // Hold no reference; the stream stays open until timeout
+    }
+    if (roll < profile.drop_rate + profile.error_rate) {
+      res->set_status(profile.error_status);
+      res->write(R"({"error":"injected"})");
+    } else {
+      res->set_status(200);
+      res->write(R"({"ok":true})");
+    }
+    res->close();
+  }
+}
+
+} // namespace astra::resilience::chaos
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <IResponse.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace astra::http2 {
+class Http2Server;
+}
+
+namespace astra::resilience::chaos {
+
+/// Faults injected into every request the fake backend serves
+struct FaultProfile {
+  std::chrono::microseconds latency{1000}; // Service time per request
+  std::chrono::microseconds jitter{0};     // Uniform extra in [0, jitter)
+  double error_rate{0.0};                  // Share answered with error_status
+  int error_status{503};
+  double drop_rate{0.0}; // Share never answered; the client must time out
+};
+
+/// Local HTTP/2 backend with a fixed number of workers serving GET /work.
+///
+/// Requests beyond `workers` wait in an unbounded FIFO, so overload shows
+/// up as growing latency, the way a saturated service behaves. The fault
+/// profile can be swapped while traffic is running.
+class FakeBackend {
+public:
+  FakeBackend(uint16_t port, size_t workers, FaultProfile profile = {});
+  ~FakeBackend();
+
+  FakeBackend(const FakeBackend &) = delete;
+  FakeBackend &operator=(const FakeBackend &) = delete;
+
+  bool start();
+  void stop();
+
+  void set_profile(FaultProfile profile);
+
+  [[nodiscard]] uint16_t port() const noexcept {
+    return m_port;
+  }
+  [[nodiscard]] size_t served() const noexcept {
+    return m_served.load(std::memory_order_relaxed);
+  }
+  [[nodiscard]] size_t queued() const;
+
+private:
+  void work(unsigned seed);
+
+  uint16_t m_port;
+  std::unique_ptr<http2::Http2Server> m_server;
+
+  mutable std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::deque<std::shared_ptr<router::IResponse>> m_queue;
+  FaultProfile m_profile;
+  bool m_stopping{false};
+
+  size_t m_worker_count;
+  std::vector<std::thread> m_workers;
+  std::atomic<size_t> m_served{0};
+};
+
+} // namespace astra::resilience::chaos
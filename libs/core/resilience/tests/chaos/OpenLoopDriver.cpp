@@ -0,0 +1,100 @@
+#include "OpenLoopDriver.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace astra::resilience::chaos {
+
+namespace {
+
+struct Tally {
+  std::atomic<size_t> ok{0};
+  std::atomic<size_t> late{0};
+  std::atomic<size_t> errors{0};
+  std::atomic<size_t> failed{0};
+  std::atomic<size_t> pending{0};
+
+  std::mutex mutex;
+  std::condition_variable drained;
+};
+
+} // namespace
+
+OpenLoopDriver::OpenLoopDriver(http2::Http2Client &client, uint16_t port,
+                               std::chrono::milliseconds slo)
+    : m_client(client), m_port(port), m_slo(slo) {
+}
+
+LoadReport OpenLoopDriver::run(double rps, std::chrono::milliseconds duration,
+                               Gate gate, std::chrono::milliseconds drain) {
+  using Clock = std::chrono::steady_clock;
+
+  auto tally = std::make_shared<Tally>();
+  LoadReport report;
+  report.duration = duration;
+
+  auto interval = std::chrono::duration_cast<Clock::duration>(
+      std::chrono::duration<double>(1.0 / rps));
+  auto start = Clock::now();
+  auto end = start + duration;
+  auto slo = m_slo;
+
+  for (auto next = start; next < end; next += interval) {
+    std::this_thread::sleep_until(next);
+    ++report.sent;
+
+    std::shared_ptr<LoadShedderGuard> guard;
+    if (gate) {
+      auto admitted = gate();
+      if (!admitted) {
+        ++report.shed;
+        continue;
+      }
+      guard = std::make_shared<LoadShedderGuard>(std::move(*admitted));
+    }
+
+    // Latency is measured from the scheduled send time, not the actual
+    // one, so a stalled driver cannot hide queueing (coordinated omission)
+    tally->pending.fetch_add(1, std::memory_order_relaxed);
+    m_client.submit(
+        "127.0.0.1", m_port, "GET", "/work", "", {},
+        [tally, guard, next, slo](auto result) mutable {
+          guard.reset();
+          auto latency = Clock::now() - next;
+
+          if (result.is_err()) {
+            tally->failed.fetch_add(1, std::memory_order_relaxed);
+          } else if (result.value().status_code() < 200 ||
+                     result.value().status_code() >= 300) {
+            tally->errors.fetch_add(1, std::memory_order_relaxed);
+          } else if (latency > slo) {
+            tally->late.fetch_add(1, std::memory_order_relaxed);
+          } else {
+            tally->ok.fetch_add(1, std::memory_order_relaxed);
+          }
+
+          if (tally->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::lock_guard<std::mutex> lock(tally->mutex);
+            tally->drained.notify_all();
+          }
+        });
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(tally->mutex);
+    tally->drained.wait_for(lock, drain, [&tally]() {
+      return tally->pending.load(std::memory_order_acquire) == 0;
+    });
+  }
+
+  report.ok = tally->ok.load();
+  report.late = tally->late.load();
+  report.errors = tally->errors.load();
+  report.failed = tally->failed.load();
+  return report;
+}
+
+} // namespace astra::resilience::chaos
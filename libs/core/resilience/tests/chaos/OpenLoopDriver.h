@@ -0,0 +1,52 @@
+#pragma once
+
+#include <Http2Client.h>
+#include <chrono>
+#include <functional>
+#include <optional>
+#include <resilience/LoadShedderGuard.h>
+
+namespace astra::resilience::chaos {
+
+/// Outcome counts of one load run; every sent request lands in exactly one
+/// of shed, ok, late, errors or failed.
+struct LoadReport {
+  size_t sent{0};
+  size_t shed{0};   // Rejected by the gate, never sent
+  size_t ok{0};     // 2xx within the SLO
+  size_t late{0};   // 2xx after the SLO; useless to the caller
+  size_t errors{0}; // Non-2xx responses
+  size_t failed{0}; // Client errors: timeouts, resets, connection loss
+  std::chrono::milliseconds duration{0};
+
+  /// Successful responses within the SLO per second of offered load
+  [[nodiscard]] double goodput() const {
+    return duration.count() > 0 ? ok * 1000.0 / duration.count() : 0.0;
+  }
+  [[nodiscard]] size_t completed() const {
+    return shed + ok + late + errors + failed;
+  }
+};
+
+/// Issues requests on a fixed schedule regardless of how fast they
+/// complete, so a slow backend cannot throttle the offered load.
+class OpenLoopDriver {
+public:
+  /// Admission in front of the backend; nullopt sheds the request
+  using Gate = std::function<std::optional<LoadShedderGuard>()>;
+
+  OpenLoopDriver(http2::Http2Client &client, uint16_t port,
+                 std::chrono::milliseconds slo);
+
+  /// Offer `rps` for `duration`, then wait up to `drain` for stragglers
+  LoadReport run(double rps, std::chrono::milliseconds duration,
+                 Gate gate = nullptr,
+                 std::chrono::milliseconds drain = std::chrono::seconds(10));
+
+private:
+  http2::Http2Client &m_client;
+  uint16_t m_port;
+  std::chrono::milliseconds m_slo;
+};
+
+} // namespace astra::resilience::chaos
@@ -0,0 +1,111 @@
+#include "FakeBackend.h"
+#include "OpenLoopDriver.h"
+
+#include <cstdio>
+#include <gtest/gtest.h>
+#include <resilience/impl/AtomicLoadShedder.h>
+#include <resilience/policy/LoadShedderPolicy.h>
+
+using namespace astra::resilience;
+using namespace astra::resilience::chaos;
+using namespace std::chrono_literals;
+
+namespace {
+
+// 4 workers x 10ms service time: the backend tops out near 400 rps
+constexpr size_t kWorkers = 4;
+constexpr auto kServiceTime = 10ms;
+constexpr auto kSlo = 200ms;
+
+} // namespace
+
+class ShedderChaosTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    auto seed = ::testing::UnitTest::GetInstance()->random_seed();
+    m_port = static_cast<uint16_t>(39000 + seed % 1000);
+    FaultProfile profile;
+    profile.latency = kServiceTime;
+    m_backend = std::make_unique<FakeBackend>(m_port, kWorkers, profile);
+    ASSERT_TRUE(m_backend->start());
+
+    astra::http2::ClientConfig config;
+    config.set_request_timeout_ms(10000);
+    m_client = std::make_unique<astra::http2::Http2Client>(config);
+
+    // Warm the connection so the first requests don't pay for the handshake
+    OpenLoopDriver(*m_client, m_port, kSlo).run(50, 100ms);
+  }
+
+  void TearDown() override {
+    m_client.reset();
+    m_backend->stop();
+  }
+
+  static void print(const char *name, const LoadReport &r) {
+    std::printf("%-12s sent=%zu shed=%zu ok=%zu late=%zu errors=%zu "
+                "failed=%zu goodput=%.0f rps\n",
+                name, r.sent, r.shed, r.ok, r.late, r.errors, r.failed,
+                r.goodput());
+  }
+
+  uint16_t m_port{0};
+  std::unique_ptr<FakeBackend> m_backend;
+  std::unique_ptr<astra::http2::Http2Client> m_client;
+};
+
+TEST_F(ShedderChaosTest, ShedderKeepsGoodputUnderOverload) {
+  OpenLoopDriver driver(*m_client, m_port, kSlo);
+
+  // 2x capacity with nothing in front: the backend queue grows without
+  // bound and almost every answer arrives after the SLO
+  auto unprotected = driver.run(800, 1500ms);
+  print("unprotected", unprotected);
+
+  // Same load behind a shedder sized to the backend plus a short queue
+  AtomicLoadShedder shedder(LoadShedderPolicy::create(kWorkers * 2, "chaos"));
+  auto protected_run = driver.run(800, 1500ms, [&shedder]() {
+    return shedder.try_acquire();
+  });
+  print("protected", protected_run);
+
+  EXPECT_EQ(unprotected.completed(), unprotected.sent);
+  EXPECT_EQ(protected_run.completed(), protected_run.sent);
+  EXPECT_GT(protected_run.shed, 0);
+  EXPECT_GT(protected_run.goodput(), 2 * unprotected.goodput());
+  EXPECT_EQ(shedder.current_count(), 0);
+}
+
+TEST_F(ShedderChaosTest, InjectedErrorsAreCountedNotLost) {
+  FaultProfile profile;
+  profile.latency = 1ms;
+  profile.error_rate = 0.3;
+  m_backend->set_profile(profile);
+
+  OpenLoopDriver driver(*m_client, m_port, kSlo);
+  auto report = driver.run(200, 1000ms);
+  print("errors", report);
+
+  EXPECT_EQ(report.completed(), report.sent);
+  EXPECT_GT(report.errors, report.sent / 10);
+  EXPECT_GT(report.ok, report.sent / 2);
+}
+
+TEST_F(ShedderChaosTest, DroppedResponsesTimeOut) {
+  m_client.reset();
+  astra::http2::ClientConfig config;
+  config.set_request_timeout_ms(100);
+  m_client = std::make_unique<astra::http2::Http2Client>(config);
+
+  FaultProfile profile;
+  profile.latency = 1ms;
+  profile.drop_rate = 0.2;
+  m_backend->set_profile(profile);
+
+  OpenLoopDriver driver(*m_client, m_port, kSlo);
+  auto report = driver.run(100, 1000ms);
+  print("drops", report);
+
+  EXPECT_EQ(report.completed(), report.sent);
+  EXPECT_GT(report.failed, 0);
+}
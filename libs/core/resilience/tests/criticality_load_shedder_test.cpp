@@ -0,0 +1,149 @@
+#include "resilience/impl/CriticalityLoadShedder.h"
+#include "resilience/policy/CriticalityPolicy.h"
+#include "resilience/policy/LoadShedderPolicy.h"
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using namespace astra::resilience;
+
+class CriticalityLoadShedderTest : public ::testing::Test {
+protected:
+  LoadShedderPolicy policy = LoadShedderPolicy::create(10, "test");
+  CriticalityPolicy tiers = CriticalityPolicy::create(0.9, 0.5);
+
+  std::vector<std::optional<LoadShedderGuard>>
+  fill(CriticalityLoadShedder &shedder, Criticality criticality) {
+    std::vector<std::optional<LoadShedderGuard>> guards;
+    while (auto guard = shedder.try_acquire(criticality)) {
+      guards.push_back(std::move(guard));
+    }
+    return guards;
+  }
+};
+
+TEST_F(CriticalityLoadShedderTest, TierLimitsDerivedFromShares) {
+  CriticalityLoadShedder shedder(policy, tiers);
+
+  EXPECT_EQ(shedder.tier_limit(Criticality::Default), 9);
+  EXPECT_EQ(shedder.tier_limit(Criticality::Sheddable), 5);
+}
+
+TEST_F(CriticalityLoadShedderTest, SheddableShedFirst) {
+  CriticalityLoadShedder shedder(policy, tiers);
+
+  auto sheddable = fill(shedder, Criticality::Sheddable);
+  EXPECT_EQ(sheddable.size(), 5);
+
+  // Capacity above the sheddable share is still open to default traffic
+  auto guard = shedder.try_acquire(Criticality::Default);
+  EXPECT_TRUE(guard.has_value());
+  EXPECT_EQ(shedder.current_count(), 6);
+}
+
+TEST_F(CriticalityLoadShedderTest, DefaultShedBeforeMax) {
+  CriticalityLoadShedder shedder(policy, tiers);
+
+  auto guards = fill(shedder, Criticality::Default);
+  EXPECT_EQ(guards.size(), 9);
+  EXPECT_FALSE(shedder.try_acquire(Criticality::Sheddable).has_value());
+}
+
+TEST_F(CriticalityLoadShedderTest, CriticalNeverShed) {
+  CriticalityLoadShedder shedder(policy, tiers);
+
+  auto guards = fill(shedder, Criticality::Default);
+  ASSERT_FALSE(shedder.try_acquire(Criticality::Default).has_value());
+
+  std::vector<std::optional<LoadShedderGuard>> critical;
+  for (int i = 0; i < 20; ++i) {
+    critical.push_back(shedder.try_acquire(Criticality::Critical));
+    EXPECT_TRUE(critical.back().has_value());
+  }
+  EXPECT_EQ(shedder.current_count(), 29);
+
+  critical.clear();
+  guards.clear();
+  EXPECT_EQ(shedder.current_count(), 0);
+}
+
+TEST_F(CriticalityLoadShedderTest, UnqualifiedAcquireUsesDefaultTier) {
+  CriticalityLoadShedder shedder(policy, tiers);
+
+  std::vector<std::optional<LoadShedderGuard>> guards;
+  while (auto guard = shedder.try_acquire()) {
+    guards.push_back(std::move(guard));
+  }
+  EXPECT_EQ(guards.size(), 9);
+}
+
+TEST_F(CriticalityLoadShedderTest, UpdatePolicyRescalesTiers) {
+  CriticalityLoadShedder shedder(policy, tiers);
+
+  shedder.update_policy(LoadShedderPolicy::create(100, "updated"));
+
+  EXPECT_EQ(shedder.max_concurrent(), 100);
+  EXPECT_EQ(shedder.tier_limit(Criticality::Default), 90);
+  EXPECT_EQ(shedder.tier_limit(Criticality::Sheddable), 50);
+}
+
+TEST_F(CriticalityLoadShedderTest, UpdateTiersChangesShares) {
+  CriticalityLoadShedder shedder(policy, tiers);
+
+  shedder.update_tiers(CriticalityPolicy::create(1.0, 0.2));
+
+  EXPECT_EQ(shedder.tier_limit(Criticality::Default), 10);
+  EXPECT_EQ(shedder.tier_limit(Criticality::Sheddable), 2);
+}
+
+TEST_F(CriticalityLoadShedderTest, UpdateAppliesPolicyAndTiersTogether) {
+  CriticalityLoadShedder shedder(policy, tiers);
+
+  shedder.update(LoadShedderPolicy::create(100, "updated"),
+                 CriticalityPolicy::create(1.0, 0.2));
+
+  EXPECT_EQ(shedder.max_concurrent(), 100);
+  EXPECT_EQ(shedder.tier_limit(Criticality::Default), 100);
+  EXPECT_EQ(shedder.tier_limit(Criticality::Sheddable), 20);
+}
+
+TEST_F(CriticalityLoadShedderTest, SmallMaxKeepsEveryTierOpen) {
+  CriticalityLoadShedder shedder(LoadShedderPolicy::create(1, "tiny"), tiers);
+
+  EXPECT_EQ(shedder.tier_limit(Criticality::Sheddable), 1);
+  EXPECT_TRUE(shedder.try_acquire(Criticality::Sheddable).has_value());
+}
+
+TEST_F(CriticalityLoadShedderTest, ConcurrentMixedTiersReleaseCleanly) {
+  CriticalityLoadShedder shedder(LoadShedderPolicy::create(50, "stress"),
+                                 tiers);
+
+  std::atomic<size_t> max_seen_sheddable{0};
+
+  auto worker = [&](Criticality criticality) {
+    for (int i = 0; i < 1000; ++i) {
+      auto guard = shedder.try_acquire(criticality);
+      if (guard && criticality == Criticality::Sheddable) {
+        size_t current = shedder.current_count();
+        size_t expected = max_seen_sheddable.load();
+        while (current > expected &&
+               !max_seen_sheddable.compare_exchange_weak(expected, current)) {
+        }
+      }
+      std::this_thread::yield();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 12; ++i) {
+    threads.emplace_back(worker, static_cast<Criticality>(i % 3));
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+
+  EXPECT_EQ(shedder.current_count(), 0);
+  EXPECT_GT(max_seen_sheddable.load(), 0);
+}
@@ -0,0 +1,56 @@
+#include "resilience/impl/HedgeBudget.h"
+
+#include <gtest/gtest.h>
+
+using namespace astra::resilience;
+
+TEST(HedgeBudgetTest, StartsEmpty) {
+  HedgeBudget budget(0.1);
+
+  EXPECT_FALSE(budget.try_spend());
+}
+
+TEST(HedgeBudgetTest, AllowsRatioOfRequests) {
+  HedgeBudget budget(0.1);
+  int hedges = 0;
+  for (int i = 0; i < 1000; ++i) {
+    budget.on_request();
+    if (budget.try_spend()) {
+      ++hedges;
+    }
+  }
+
+  EXPECT_EQ(hedges, 100);
+}
+
+TEST(HedgeBudgetTest, BalanceIsCapped) {
+  HedgeBudget budget(1.0, 3.0);
+  for (int i = 0; i < 100; ++i) {
+    budget.on_request();
+  }
+
+  EXPECT_DOUBLE_EQ(budget.tokens(), 3.0);
+  EXPECT_TRUE(budget.try_spend());
+  EXPECT_TRUE(budget.try_spend());
+  EXPECT_TRUE(budget.try_spend());
+  EXPECT_FALSE(budget.try_spend());
+}
+
+TEST(HedgeBudgetTest, ZeroRatioNeverHedges) {
+  HedgeBudget budget(0.0);
+  for (int i = 0; i < 100; ++i) {
+    budget.on_request();
+  }
+
+  EXPECT_FALSE(budget.try_spend());
+}
+
+TEST(HedgeBudgetTest, SetRatioAppliesToNewDeposits) {
+  HedgeBudget budget(0.0);
+  budget.set_ratio(0.5);
+  budget.on_request();
+  budget.on_request();
+
+  EXPECT_TRUE(budget.try_spend());
+  EXPECT_FALSE(budget.try_spend());
+}
@@ -0,0 +1,69 @@
+#include "resilience/impl/LatencyTracker.h"
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using namespace astra::resilience;
+using namespace std::chrono_literals;
+
+TEST(LatencyTrackerTest, EmptyTrackerReportsZero) {
+  LatencyTracker tracker;
+
+  EXPECT_EQ(tracker.quantile(0.95), 0us);
+  EXPECT_EQ(tracker.sample_count(), 0);
+}
+
+TEST(LatencyTrackerTest, QuantileWithinBucketError) {
+  LatencyTracker tracker(10000);
+  for (int i = 1; i <= 1000; ++i) {
+    tracker.record(std::chrono::microseconds(i * 10)); // 10us .. 10ms
+  }
+
+  auto p95 = tracker.quantile(0.95).count();
+  EXPECT_GE(p95, 9500);
+  EXPECT_LE(p95, 9500 * 1.2);
+
+  auto p50 = tracker.quantile(0.5).count();
+  EXPECT_GE(p50, 5000);
+  EXPECT_LE(p50, 5000 * 1.2);
+}
+
+TEST(LatencyTrackerTest, HugeLatencyClampsToLastBucket) {
+  LatencyTracker tracker;
+  tracker.record(std::chrono::hours(1));
+
+  EXPECT_GT(tracker.quantile(0.5), 10s);
+}
+
+TEST(LatencyTrackerTest, WindowForgetsOldSamples) {
+  LatencyTracker tracker(100);
+  for (int i = 0; i < 100; ++i) {
+    tracker.record(100ms);
+  }
+  // Two more windows of fast samples push the slow generation out
+  for (int i = 0; i < 200; ++i) {
+    tracker.record(1ms);
+  }
+
+  EXPECT_LE(tracker.quantile(0.99), 2ms);
+  EXPECT_LE(tracker.sample_count(), 200);
+}
+
+TEST(LatencyTrackerTest, ConcurrentRecordKeepsCounting) {
+  LatencyTracker tracker(1000000);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&tracker]() {
+      for (int i = 0; i < 10000; ++i) {
+        tracker.record(500us);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(tracker.sample_count(), 40000);
+  EXPECT_GE(tracker.quantile(0.5), 500us);
+}
@@ -0,0 +1,207 @@
+#include "resilience/impl/AtomicLoadShedder.h"
+#include "resilience/impl/CriticalityLoadShedder.h"
+#include "resilience/impl/StripedLoadShedder.h"
+#include "resilience/policy/LoadShedderPolicy.h"
+
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+using namespace astra::resilience;
+
+// =============================================================================
+// Acquire/release under contention
+// =============================================================================
+//
+// All benchmark threads share one shedder whose limit is never reached, so
+// the numbers isolate the cost of the in-flight counter itself.
+
+namespace {
+
+constexpr size_t kUnreachable = size_t{1} << 30;
+
+template <typename Shedder> Shedder &shared_shedder() {
+  static Shedder shedder(LoadShedderPolicy::create(kUnreachable, "bench"));
+  return shedder;
+}
+
+template <typename Shedder> void acquire_release(benchmark::State &state) {
+  auto &shedder = shared_shedder<Shedder>();
+
+  for (auto _ : state) {
+    auto guard = shedder.try_acquire();
+    benchmark::DoNotOptimize(guard);
+  }
+}
+
+} // namespace
+
+static void BM_AtomicAcquireRelease(benchmark::State &state) {
+  acquire_release<AtomicLoadShedder>(state);
+}
+BENCHMARK(BM_AtomicAcquireRelease)->ThreadRange(1, 64)->UseRealTime();
+
+static void BM_StripedAcquireRelease(benchmark::State &state) {
+  acquire_release<StripedLoadShedder>(state);
+}
+BENCHMARK(BM_StripedAcquireRelease)->ThreadRange(1, 64)->UseRealTime();
+
+static void BM_CriticalityAcquireRelease(benchmark::State &state) {
+  static CriticalityLoadShedder shedder(
+      LoadShedderPolicy::create(kUnreachable, "bench"));
+  for (auto _ : state) {
+    auto guard = shedder.try_acquire(Criticality::Sheddable);
+    benchmark::DoNotOptimize(guard);
+  }
+}
+BENCHMARK(BM_CriticalityAcquireRelease)->ThreadRange(1, 64)->UseRealTime();
+
+// =============================================================================
+// Rejection path under contention
+// =============================================================================
+//
+// A saturated shedder is exactly when try_acquire runs hottest, so the cost
+// of saying no matters as much as the cost of saying yes.
+
+namespace {
+
+template <typename Shedder> void reject(benchmark::State &state) {
+  static Shedder shedder(LoadShedderPolicy::create(1, "bench-full"));
+  static auto held = shedder.try_acquire(); // Keeps the shedder full
+
+  for (auto _ : state) {
+    auto guard = shedder.try_acquire();
+    benchmark::DoNotOptimize(guard);
+  }
+}
+
+} // namespace
+
+static void BM_AtomicReject(benchmark::State &state) {
+  reject<AtomicLoadShedder>(state);
+}
+BENCHMARK(BM_AtomicReject)->ThreadRange(1, 64)->UseRealTime();
+
+static void BM_StripedReject(benchmark::State &state) {
+  reject<StripedLoadShedder>(state);
+}
+BENCHMARK(BM_StripedReject)->ThreadRange(1, 64)->UseRealTime();
+
+// A limit of one leaves a single active stripe, so the runs above measure
+// one shared line. These fill every stripe of a realistic limit first; each
+// rejection then scans the home stripe and its spill window.
+
+namespace {
+
+constexpr size_t kSaturatedLimit = 1024;
+
+template <typename Shedder> Shedder &saturated_shedder() {
+  static Shedder shedder(LoadShedderPolicy::create(kSaturatedLimit, "full"));
+  static std::vector<std::optional<LoadShedderGuard>> held = [] {
+    // Home stripes are handed out round-robin per thread, so kMaxStripes
+    // fresh threads together reach every stripe
+    std::vector<std::optional<LoadShedderGuard>> guards;
+    std::mutex mutex;
+    std::vector<std::thread> fillers;
+    for (size_t i = 0; i < StripedLoadShedder::kMaxStripes; ++i) {
+      fillers.emplace_back([&]() {
+        while (auto guard = shedder.try_acquire()) {
+          std::lock_guard<std::mutex> lock(mutex);
+          guards.push_back(std::move(guard));
+        }
+      });
+    }
+    for (auto &t : fillers) {
+      t.join();
+    }
+    return guards;
+  }();
+  return shedder;
+}
+
+template <typename Shedder> void reject_saturated(benchmark::State &state) {
+  auto &shedder = saturated_shedder<Shedder>();
+
+  for (auto _ : state) {
+    auto guard = shedder.try_acquire();
+    benchmark::DoNotOptimize(guard);
+  }
+  state.counters["in_flight"] =
+      benchmark::Counter(static_cast<double>(shedder.current_count()),
+                         benchmark::Counter::kAvgThreads);
+}
+
+} // namespace
+
+static void BM_AtomicRejectSaturated(benchmark::State &state) {
+  reject_saturated<AtomicLoadShedder>(state);
+}
+BENCHMARK(BM_AtomicRejectSaturated)->ThreadRange(1, 64)->UseRealTime();
+
+static void BM_StripedRejectSaturated(benchmark::State &state) {
+  reject_saturated<StripedLoadShedder>(state);
+}
+BENCHMARK(BM_StripedRejectSaturated)->ThreadRange(1, 64)->UseRealTime();
+
+// =============================================================================
+// Guard overhead
+// =============================================================================
+//
+// LoadShedderGuard is an owner pointer plus a token; these isolate the cost
+// of creating, moving and releasing one from the counter itself.
+
+namespace {
+struct CountingOwner : LoadShedderGuard::Owner {
+  std::atomic<size_t> counter{0};
+
+  void release(uint32_t /*token*/) noexcept override {
+    counter.fetch_sub(1, std::memory_order_relaxed);
+  }
+};
+} // namespace
+
+static void BM_GuardCreateRelease(benchmark::State &state) {
+  CountingOwner owner;
+  for (auto _ : state) {
+    owner.counter.fetch_add(1, std::memory_order_relaxed);
+    auto guard = LoadShedderGuard::create(owner);
+    benchmark::DoNotOptimize(guard);
+  }
+}
+BENCHMARK(BM_GuardCreateRelease);
+
+static void BM_GuardMoveIntoOptional(benchmark::State &state) {
+  // The path try_acquire takes: create, wrap in optional, destroy
+  CountingOwner owner;
+  for (auto _ : state) {
+    owner.counter.fetch_add(1, std::memory_order_relaxed);
+    std::optional<LoadShedderGuard> guard = LoadShedderGuard::create(owner);
+    benchmark::DoNotOptimize(guard);
+  }
+}
+BENCHMARK(BM_GuardMoveIntoOptional);
+
+// =============================================================================
+// Metrics read
+// =============================================================================
+
+static void BM_AtomicCurrentCount(benchmark::State &state) {
+  auto &shedder = shared_shedder<AtomicLoadShedder>();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(shedder.current_count());
+  }
+}
+BENCHMARK(BM_AtomicCurrentCount);
+
+static void BM_StripedCurrentCount(benchmark::State &state) {
+  auto &shedder = shared_shedder<StripedLoadShedder>();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(shedder.current_count());
+  }
+}
+BENCHMARK(BM_StripedCurrentCount);
+
+BENCHMARK_MAIN();
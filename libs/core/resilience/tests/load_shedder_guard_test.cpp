@@ -4,20 +4,21 @@
 
 using namespace astra::resilience;
 
-class LoadShedderGuardTest : public ::testing::Test {
+class LoadShedderGuardTest : public ::testing::Test,
+                             public LoadShedderGuard::Owner {
 protected:
   int release_count = 0;
+  uint32_t last_token = 0;
 
-  LoadShedderGuard::ReleaseFn make_release_fn() {
-    return [this]() {
-      ++release_count;
-    };
+  void release(uint32_t token) noexcept override {
+    ++release_count;
+    last_token = token;
   }
 };
 
 TEST_F(LoadShedderGuardTest, ReleasesOnDestruction) {
   {
-    auto guard = LoadShedderGuard::create(make_release_fn());
+    auto guard = LoadShedderGuard::create(*this);
     EXPECT_EQ(release_count, 0);
   }
   EXPECT_EQ(release_count, 1);
@@ -25,7 +26,7 @@ TEST_F(LoadShedderGuardTest, ReleasesOnDestruction) {
 
 TEST_F(LoadShedderGuardTest, MoveDoesNotDoubleRelease) {
   {
-    auto guard1 = LoadShedderGuard::create(make_release_fn());
+    auto guard1 = LoadShedderGuard::create(*this);
     auto guard2 = std::move(guard1);
     EXPECT_EQ(release_count, 0);
   }
@@ -34,8 +35,8 @@ TEST_F(LoadShedderGuardTest, MoveDoesNotDoubleRelease) {
 
 TEST_F(LoadShedderGuardTest, MoveAssignmentReleasesOldGuard) {
   {
-    auto guard1 = LoadShedderGuard::create(make_release_fn());
-    auto guard2 = LoadShedderGuard::create(make_release_fn());
+    auto guard1 = LoadShedderGuard::create(*this);
+    auto guard2 = LoadShedderGuard::create(*this);
     EXPECT_EQ(release_count, 0);
 
     guard1 = std::move(guard2); // guard1's original should release
@@ -46,7 +47,7 @@ TEST_F(LoadShedderGuardTest, MoveAssignmentReleasesOldGuard) {
 
 TEST_F(LoadShedderGuardTest, MovedFromGuardDoesNotReleaseOnDestruction) {
   {
-    auto guard1 = LoadShedderGuard::create(make_release_fn());
+    auto guard1 = LoadShedderGuard::create(*this);
     {
       auto guard2 = std::move(guard1);
     } // guard2 destroyed, releases
@@ -57,9 +58,35 @@ TEST_F(LoadShedderGuardTest, MovedFromGuardDoesNotReleaseOnDestruction) {
 
 TEST_F(LoadShedderGuardTest, SelfMoveAssignmentIsSafe) {
   {
-    auto guard = LoadShedderGuard::create(make_release_fn());
+    auto guard = LoadShedderGuard::create(*this);
     guard = std::move(guard); // Self-assignment
     EXPECT_EQ(release_count, 0);
   }
   EXPECT_EQ(release_count, 1);
 }
+
+TEST_F(LoadShedderGuardTest, ReleasesWithItsToken) {
+  {
+    auto guard = LoadShedderGuard::create(*this, 7);
+    auto moved = std::move(guard);
+  }
+  EXPECT_EQ(release_count, 1);
+  EXPECT_EQ(last_token, 7u);
+}
+
+TEST_F(LoadShedderGuardTest, DefaultConstructedHoldsNothing) {
+  {
+    LoadShedderGuard guard;
+    EXPECT_FALSE(guard.holds());
+  }
+  EXPECT_EQ(release_count, 0);
+}
+
+TEST_F(LoadShedderGuardTest, ResetReleasesOnce) {
+  auto guard = LoadShedderGuard::create(*this);
+  EXPECT_TRUE(guard.holds());
+  guard.reset();
+  EXPECT_FALSE(guard.holds());
+  guard.reset();
+  EXPECT_EQ(release_count, 1);
+}
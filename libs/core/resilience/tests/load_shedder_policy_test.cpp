@@ -1,3 +1,4 @@
+#include "resilience/policy/CriticalityPolicy.h"
 #include "resilience/policy/LoadShedderPolicy.h"
 
 #include <gtest/gtest.h>
@@ -26,3 +27,19 @@ TEST(LoadShedderPolicyTest, CreateWithLargeValue) {
 
   EXPECT_EQ(policy.max_concurrent, 1000000);
 }
+
+TEST(CriticalityPolicyTest, CreateWithValidShares) {
+  auto tiers = CriticalityPolicy::create(0.9, 0.6);
+
+  EXPECT_DOUBLE_EQ(tiers.default_share, 0.9);
+  EXPECT_DOUBLE_EQ(tiers.sheddable_share, 0.6);
+}
+
+TEST(CriticalityPolicyTest, CreateThrowsOnOutOfRangeShares) {
+  EXPECT_THROW(CriticalityPolicy::create(0.0, 0.0), std::invalid_argument);
+  EXPECT_THROW(CriticalityPolicy::create(1.5, 0.5), std::invalid_argument);
+}
+
+TEST(CriticalityPolicyTest, CreateThrowsWhenSheddableExceedsDefault) {
+  EXPECT_THROW(CriticalityPolicy::create(0.5, 0.8), std::invalid_argument);
+}
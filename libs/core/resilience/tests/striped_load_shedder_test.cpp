@@ -0,0 +1,127 @@
+#include "resilience/impl/StripedLoadShedder.h"
+#include "resilience/policy/LoadShedderPolicy.h"
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using namespace astra::resilience;
+
+class StripedLoadShedderTest : public ::testing::Test {
+protected:
+  LoadShedderPolicy policy = LoadShedderPolicy::create(10, "test");
+
+  std::vector<std::optional<LoadShedderGuard>>
+  fill(StripedLoadShedder &shedder) {
+    std::vector<std::optional<LoadShedderGuard>> guards;
+    while (auto guard = shedder.try_acquire()) {
+      guards.push_back(std::move(guard));
+    }
+    return guards;
+  }
+};
+
+TEST_F(StripedLoadShedderTest, StripeCountRoundsUpToPowerOfTwo) {
+  EXPECT_EQ(StripedLoadShedder(policy, 1).stripe_count(), 1);
+  EXPECT_EQ(StripedLoadShedder(policy, 3).stripe_count(), 4);
+  EXPECT_EQ(StripedLoadShedder(policy, 1000).stripe_count(),
+            StripedLoadShedder::kMaxStripes);
+  EXPECT_GE(StripedLoadShedder(policy).stripe_count(), 1);
+}
+
+TEST_F(StripedLoadShedderTest, SingleThreadReachesExactLimit) {
+  // Both stripes lie within one thread's spill window
+  StripedLoadShedder shedder(policy, 2);
+
+  auto guards = fill(shedder);
+
+  EXPECT_EQ(guards.size(), 10);
+  EXPECT_EQ(shedder.current_count(), 10);
+}
+
+TEST_F(StripedLoadShedderTest, LimitBelowStripeCount) {
+  StripedLoadShedder shedder(LoadShedderPolicy::create(3, "tiny"), 64);
+
+  auto guards = fill(shedder);
+
+  EXPECT_EQ(guards.size(), 3);
+}
+
+TEST_F(StripedLoadShedderTest, SpillIsBoundedToNeighbours) {
+  StripedLoadShedder shedder(LoadShedderPolicy::create(16, "wide"), 8);
+
+  auto guards = fill(shedder);
+
+  // Two slots per stripe, reachable only on the home stripe and its spill
+  EXPECT_EQ(guards.size(), 2 * (StripedLoadShedder::kSpillStripes + 1));
+  EXPECT_EQ(shedder.current_count(), guards.size());
+}
+
+TEST_F(StripedLoadShedderTest, ReleaseReturnsCapacity) {
+  StripedLoadShedder shedder(policy, 8);
+
+  auto guards = fill(shedder);
+  size_t held = guards.size();
+  guards.pop_back();
+
+  EXPECT_EQ(shedder.current_count(), held - 1);
+  EXPECT_TRUE(shedder.try_acquire().has_value());
+
+  guards.clear();
+  EXPECT_EQ(shedder.current_count(), 0);
+}
+
+TEST_F(StripedLoadShedderTest, UpdatePolicyChangesLimit) {
+  StripedLoadShedder shedder(policy, 2);
+
+  shedder.update_policy(LoadShedderPolicy::create(20, "updated"));
+
+  EXPECT_EQ(shedder.max_concurrent(), 20);
+  EXPECT_EQ(fill(shedder).size(), 20);
+}
+
+TEST_F(StripedLoadShedderTest, ReduceMaxBelowCurrentInFlight) {
+  StripedLoadShedder shedder(policy, 2);
+  auto guards = fill(shedder);
+
+  shedder.update_policy(LoadShedderPolicy::create(5, "reduced"));
+  EXPECT_FALSE(shedder.try_acquire().has_value());
+
+  guards.clear();
+  EXPECT_EQ(fill(shedder).size(), 5);
+}
+
+TEST_F(StripedLoadShedderTest, ConcurrentNeverExceedsLimit) {
+  StripedLoadShedder shedder(LoadShedderPolicy::create(16, "stress"), 8);
+  std::atomic<size_t> held{0};
+  std::atomic<size_t> max_held{0};
+  std::atomic<size_t> accepted{0};
+
+  auto worker = [&]() {
+    for (int i = 0; i < 5000; ++i) {
+      auto guard = shedder.try_acquire();
+      if (!guard) {
+        continue;
+      }
+      accepted.fetch_add(1, std::memory_order_relaxed);
+      size_t now = held.fetch_add(1) + 1;
+      size_t seen = max_held.load();
+      while (now > seen && !max_held.compare_exchange_weak(seen, now)) {
+      }
+      held.fetch_sub(1);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 32; ++i) {
+    threads.emplace_back(worker);
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+
+  EXPECT_LE(max_held.load(), 16);
+  EXPECT_GT(accepted.load(), 0);
+  EXPECT_EQ(shedder.current_count(), 0);
+}
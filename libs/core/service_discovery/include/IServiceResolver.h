@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace astra::service_discovery {
 
@@ -25,6 +26,17 @@ public:
   virtual std::pair<std::string, uint16_t>
   resolve(const std::string &service_name) = 0;
 
+  /**
+   * @brief Resolve a service name to all of its endpoints
+   * @param service_name The logical service name
+   * @return Endpoints in preference order; the first matches resolve()
+   * @throws std::runtime_error if service not found
+   */
+  virtual std::vector<std::pair<std::string, uint16_t>>
+  resolve_all(const std::string &service_name) {
+    return {resolve(service_name)};
+  }
+
   /**
    * @brief Check if a service is registered
    * @param service_name The logical service name
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace astra::utils {
+
+/// Read-copy-update cell for rarely changing, frequently read values.
+///
+/// Writers publish a complete new value under a mutex and bump a version
+/// counter. Each reading thread caches the last value it saw together with
+/// that version, so a read is one atomic load plus a reference-count copy
+/// and never locks while the value is unchanged. Only the first read on a
+/// thread after a publish takes the mutex to refresh its cache.
+///
+/// A retired value is freed once no caller holds it and every thread that
+/// cached it has read again (or exited), so memory stays bounded by one
+/// value per reading thread no matter how often the cell is republished.
+/// The cache holds one cell per value type; threads alternating between
+/// several cells of the same T fall back to the locked path.
+template <typename T> class AtomicSnapshot {
+public:
+  explicit AtomicSnapshot(T initial)
+      : m_current(std::make_shared<const T>(std::move(initial))) {
+  }
+
+  AtomicSnapshot(const AtomicSnapshot &) = delete;
+  AtomicSnapshot &operator=(const AtomicSnapshot &) = delete;
+
+  [[nodiscard]] std::shared_ptr<const T> load() const {
+    static thread_local Cache cache;
+    auto version = m_version.load(std::memory_order_acquire);
+    if (cache.id != m_id || cache.version != version) {
+      std::lock_guard<std::mutex> lock(m_write_mutex);
+      cache.id = m_id;
+      cache.version = m_version.load(std::memory_order_relaxed);
+      cache.value = m_current;
+    }
+    return cache.value;
+  }
+
+  /// Publish a new value and return the one it replaced
+  std::shared_ptr<const T> publish(T value) {
+    auto next = std::make_shared<const T>(std::move(value));
+    std::lock_guard<std::mutex> lock(m_write_mutex);
+    m_current.swap(next);
+    m_version.fetch_add(1, std::memory_order_release);
+    return next;
+  }
+
+private:
+  struct Cache {
+    uint64_t id{0};
+    uint64_t version{0};
+    std::shared_ptr<const T> value;
+  };
+
+  static uint64_t next_id() noexcept {
+    static std::atomic<uint64_t> counter{0};
+    return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+  }
+
+  const uint64_t m_id{next_id()};
+  std::shared_ptr<const T> m_current;
+  std::atomic<uint64_t> m_version{0};
+  mutable std::mutex m_write_mutex;
+};
+
+} // namespace astra::utils
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <chrono>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace astra::utils {
+
+/// Point in time by which a request must be answered.
+///
+/// A default-constructed Deadline is unset and never expires. Deadlines are
+/// carried from the server through the execution layer to downstream
+/// calls, which receive the remaining budget in a grpc-timeout header.
+class Deadline {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  static constexpr const char *kHeader = "grpc-timeout";
+
+  /// Longest budget accepted from a grpc-timeout header; larger values are
+  /// clamped to it
+  static constexpr std::chrono::hours kMaxGrpcTimeout{24};
+
+  Deadline() = default;
+
+  [[nodiscard]] static Deadline at(Clock::time_point when) noexcept {
+    Deadline deadline;
+    deadline.m_when = when;
+    return deadline;
+  }
+
+  /// Saturates at the clock's range instead of overflowing, so a huge
+  /// budget yields a far-off deadline rather than one in the past. A budget
+  /// of zero or less is already expired.
+  [[nodiscard]] static Deadline
+  after(std::chrono::milliseconds budget) noexcept {
+    auto now = Clock::now();
+    if (budget <= std::chrono::milliseconds::zero()) {
+      return at(now);
+    }
+    auto headroom = std::chrono::duration_cast<std::chrono::milliseconds>(
+        Clock::time_point::max() - now);
+    if (budget >= headroom) {
+      return at(Clock::time_point::max() - Clock::duration(1));
+    }
+    return at(now + budget);
+  }
+
+  [[nodiscard]] bool is_set() const noexcept {
+    return m_when != Clock::time_point::max();
+  }
+
+  [[nodiscard]] bool expired() const noexcept {
+    return is_set() && Clock::now() >= m_when;
+  }
+
+  /// Time left, clamped at zero; unbounded when unset
+  [[nodiscard]] std::chrono::milliseconds remaining() const noexcept {
+    if (!is_set()) {
+      return std::chrono::milliseconds::max();
+    }
+    auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+        m_when - Clock::now());
+    return left.count() > 0 ? left : std::chrono::milliseconds::zero();
+  }
+
+  [[nodiscard]] Clock::time_point when() const noexcept {
+    return m_when;
+  }
+
+  /// The tighter of the two deadlines
+  [[nodiscard]] Deadline earliest(Deadline other) const noexcept {
+    return other.m_when < m_when ? other : *this;
+  }
+
+  /// Remaining budget in grpc-timeout wire format, e.g. "250m"
+  [[nodiscard]] std::string to_grpc_timeout() const;
+
+  /// Parse a grpc-timeout value ("<1-8 digits><H|M|S|m|u|n>"), capped at
+  /// kMaxGrpcTimeout
+  [[nodiscard]] static std::optional<std::chrono::milliseconds>
+  parse_grpc_timeout(std::string_view value);
+
+private:
+  Clock::time_point m_when{Clock::time_point::max()};
+};
+
+} // namespace astra::utils
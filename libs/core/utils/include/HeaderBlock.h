@@ -0,0 +1,181 @@
+#pragma once
+
+#include <boost/container/small_vector.hpp>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace astra::utils {
+
+// Header name with its hash computed up front, so lookups of well-known
+// headers skip hashing the key. Hashing folds ASCII case, matching the
+// case-insensitive comparison HeaderBlock does.
+class HeaderName {
+public:
+  // Implicit, so anything string-like can be passed where a name is taken
+  template <typename S, typename = std::enable_if_t<
+                            std::is_convertible_v<const S &, std::string_view>>>
+  constexpr HeaderName(const S &name) noexcept // NOLINT
+      : m_name(name), m_hash(hash(m_name)) {
+  }
+
+  [[nodiscard]] constexpr std::string_view name() const noexcept {
+    return m_name;
+  }
+  [[nodiscard]] constexpr uint32_t hash() const noexcept {
+    return m_hash;
+  }
+
+  // FNV-1a over the lowercased bytes
+  static constexpr uint32_t hash(std::string_view name) noexcept {
+    uint32_t h = 2166136261u;
+    for (char c : name) {
+      h ^= static_cast<uint8_t>(to_lower(c));
+      h *= 16777619u;
+    }
+    return h;
+  }
+
+  static constexpr bool equals(std::string_view a,
+                               std::string_view b) noexcept {
+    if (a.size() != b.size()) {
+      return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+      if (to_lower(a[i]) != to_lower(b[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  static constexpr char to_lower(char c) noexcept {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+  }
+
+private:
+  std::string_view m_name;
+  uint32_t m_hash;
+};
+
+namespace header {
+inline constexpr HeaderName kAccept{"accept"};
+inline constexpr HeaderName kAcceptEncoding{"accept-encoding"};
+inline constexpr HeaderName kAuthorization{"authorization"};
+inline constexpr HeaderName kContentEncoding{"content-encoding"};
+inline constexpr HeaderName kContentLength{"content-length"};
+inline constexpr HeaderName kContentType{"content-type"};
+inline constexpr HeaderName kGrpcTimeout{"grpc-timeout"};
+inline constexpr HeaderName kHost{"host"};
+inline constexpr HeaderName kRetryAfter{"retry-after"};
+inline constexpr HeaderName kUserAgent{"user-agent"};
+inline constexpr HeaderName kVary{"vary"};
+} // namespace header
+
+// Flat header storage shared by the HTTP clients and servers. Entries sit
+// in one small-buffer vector, in insertion order, with names lowercased
+// on the way in (HTTP/2 requires it on the wire). Lookups are linear, but
+// compare a cached hash before touching the strings; with the handful of
+// headers a request carries that beats a node-based map and does not
+// allocate per header. Names are unique: operator[] and set() overwrite.
+class HeaderBlock {
+public:
+  using value_type = std::pair<std::string, std::string>;
+  static constexpr size_t kInlineHeaders = 8;
+  using Storage = boost::container::small_vector<value_type, kInlineHeaders>;
+  using const_iterator = Storage::const_iterator;
+  using iterator = const_iterator;
+
+  HeaderBlock() = default;
+  HeaderBlock(std::initializer_list<value_type> headers);
+
+  void set(HeaderName name, std::string value);
+  std::string &operator[](HeaderName name);
+  bool erase(HeaderName name);
+  void reserve(size_t n);
+  void clear() noexcept;
+
+  [[nodiscard]] const_iterator find(HeaderName name) const noexcept;
+  [[nodiscard]] bool contains(HeaderName name) const noexcept {
+    return find(name) != end();
+  }
+  [[nodiscard]] size_t count(HeaderName name) const noexcept {
+    return contains(name) ? 1 : 0;
+  }
+  // Empty when the header is missing
+  [[nodiscard]] std::string_view get(HeaderName name) const noexcept;
+
+  [[nodiscard]] const_iterator begin() const noexcept {
+    return m_headers.begin();
+  }
+  [[nodiscard]] const_iterator end() const noexcept {
+    return m_headers.end();
+  }
+  [[nodiscard]] size_t size() const noexcept {
+    return m_headers.size();
+  }
+  [[nodiscard]] bool empty() const noexcept {
+    return m_headers.empty();
+  }
+
+  friend bool operator==(const HeaderBlock &a, const HeaderBlock &b) {
+    return a.m_headers == b.m_headers;
+  }
+  friend bool operator!=(const HeaderBlock &a, const HeaderBlock &b) {
+    return !(a == b);
+  }
+
+private:
+  [[nodiscard]] size_t index_of(HeaderName name) const noexcept;
+
+  Storage m_headers;
+  boost::container::small_vector<uint32_t, kInlineHeaders> m_hashes;
+};
+
+// Read-only lookups over a transport's own header container, such as
+// nghttp2's header_map, without copying it into a HeaderBlock. Only valid
+// while the container is; the transport's callback is the usual scope.
+template <typename Map> class HeaderView {
+public:
+  explicit HeaderView(const Map &headers) noexcept : m_headers(&headers) {
+  }
+
+  // Empty when the header is missing
+  [[nodiscard]] std::string_view get(HeaderName name) const noexcept {
+    for (const auto &[key, value] : *m_headers) {
+      if (HeaderName::equals(key, name.name())) {
+        return value_of(value);
+      }
+    }
+    return {};
+  }
+
+  [[nodiscard]] size_t size() const noexcept {
+    return m_headers->size();
+  }
+
+  [[nodiscard]] HeaderBlock to_block() const {
+    HeaderBlock block;
+    block.reserve(m_headers->size());
+    for (const auto &[key, value] : *m_headers) {
+      block.set(key, std::string(value_of(value)));
+    }
+    return block;
+  }
+
+private:
+  template <typename V> static std::string_view value_of(const V &value) {
+    if constexpr (std::is_convertible_v<const V &, std::string_view>) {
+      return value;
+    } else {
+      return value.value; // nghttp2::asio_http2::header_value
+    }
+  }
+
+  const Map *m_headers;
+};
+
+} // namespace astra::utils
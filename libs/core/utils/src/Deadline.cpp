@@ -0,0 +1,65 @@
+#include "Deadline.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace astra::utils {
+
+std::string Deadline::to_grpc_timeout() const {
+  // The value is limited to 8 digits, so switch to coarser units for long
+  // budgets
+  constexpr int64_t kMaxDigits = 99999999;
+  auto ms = remaining().count();
+  if (ms <= kMaxDigits) {
+    return std::to_string(ms) + "m";
+  }
+  if (ms / 1000 <= kMaxDigits) {
+    return std::to_string(ms / 1000) + "S";
+  }
+  return std::to_string(std::min<int64_t>(ms / 3600000, kMaxDigits)) + "H";
+}
+
+std::optional<std::chrono::milliseconds>
+Deadline::parse_grpc_timeout(std::string_view value) {
+  if (value.size() < 2 || value.size() > 9) {
+    return std::nullopt;
+  }
+
+  int64_t amount = 0;
+  for (char c : value.substr(0, value.size() - 1)) {
+    if (c < '0' || c > '9') {
+      return std::nullopt;
+    }
+    amount = amount * 10 + (c - '0');
+  }
+
+  std::chrono::milliseconds budget;
+  switch (value.back()) {
+  case 'H':
+    budget = std::chrono::hours(amount);
+    break;
+  case 'M':
+    budget = std::chrono::minutes(amount);
+    break;
+  case 'S':
+    budget = std::chrono::seconds(amount);
+    break;
+  case 'm':
+    budget = std::chrono::milliseconds(amount);
+    break;
+  case 'u':
+    budget = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::microseconds(amount));
+    break;
+  case 'n':
+    budget = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::nanoseconds(amount));
+    break;
+  default:
+    return std::nullopt;
+  }
+  // 8 digits of hours fit in milliseconds, so clamping afterwards is safe
+  return std::min<std::chrono::milliseconds>(budget, kMaxGrpcTimeout);
+}
+
+} // namespace astra::utils
@@ -0,0 +1,78 @@
+#include "HeaderBlock.h"
+
+namespace astra::utils {
+
+namespace {
+
+std::string lowercase(std::string_view name) {
+  std::string out(name);
+  for (auto &c : out) {
+    c = HeaderName::to_lower(c);
+  }
+  return out;
+}
+
+} // namespace
+
+HeaderBlock::HeaderBlock(std::initializer_list<value_type> headers) {
+  reserve(headers.size());
+  for (const auto &[name, value] : headers) {
+    set(name, value);
+  }
+}
+
+void HeaderBlock::set(HeaderName name, std::string value) {
+  (*this)[name] = std::move(value);
+}
+
+std::string &HeaderBlock::operator[](HeaderName name) {
+  size_t index = index_of(name);
+  if (index != m_headers.size()) {
+    return m_headers[index].second;
+  }
+  m_headers.emplace_back(lowercase(name.name()), std::string());
+  m_hashes.push_back(name.hash());
+  return m_headers.back().second;
+}
+
+bool HeaderBlock::erase(HeaderName name) {
+  size_t index = index_of(name);
+  if (index == m_headers.size()) {
+    return false;
+  }
+  m_headers.erase(m_headers.begin() + index);
+  m_hashes.erase(m_hashes.begin() + index);
+  return true;
+}
+
+void HeaderBlock::reserve(size_t n) {
+  m_headers.reserve(n);
+  m_hashes.reserve(n);
+}
+
+void HeaderBlock::clear() noexcept {
+  m_headers.clear();
+  m_hashes.clear();
+}
+
+HeaderBlock::const_iterator HeaderBlock::find(HeaderName name) const noexcept {
+  return m_headers.begin() + index_of(name);
+}
+
+std::string_view HeaderBlock::get(HeaderName name) const noexcept {
+  auto it = find(name);
+  return it != end() ? std::string_view(it->second) : std::string_view();
+}
+
+size_t HeaderBlock::index_of(HeaderName name) const noexcept {
+  for (size_t i = 0; i < m_hashes.size(); ++i) {
+    // Stored names are already lowercase, so only the probe needs folding
+    if (m_hashes[i] == name.hash() &&
+        HeaderName::equals(m_headers[i].first, name.name())) {
+      return i;
+    }
+  }
+  return m_headers.size();
+}
+
+} // namespace astra::utils
@@ -0,0 +1,95 @@
+#include "AtomicSnapshot.h"
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace astra::utils;
+
+TEST(AtomicSnapshotTest, LoadReturnsInitialValue) {
+  AtomicSnapshot<std::string> snapshot("v1");
+  EXPECT_EQ(*snapshot.load(), "v1");
+}
+
+TEST(AtomicSnapshotTest, PublishReplacesValueAndReturnsPrevious) {
+  AtomicSnapshot<std::string> snapshot("v1");
+
+  auto previous = snapshot.publish("v2");
+
+  EXPECT_EQ(*previous, "v1");
+  EXPECT_EQ(*snapshot.load(), "v2");
+}
+
+TEST(AtomicSnapshotTest, OldReferencesStayValidAfterPublish) {
+  AtomicSnapshot<std::string> snapshot("v1");
+  auto held = snapshot.load();
+
+  snapshot.publish("v2");
+  snapshot.publish("v3");
+
+  EXPECT_EQ(*held, "v1");
+  EXPECT_EQ(*snapshot.load(), "v3");
+}
+
+TEST(AtomicSnapshotTest, RetiredValuesAreFreedOnceUnreferenced) {
+  AtomicSnapshot<std::string> snapshot("v1");
+  std::weak_ptr<const std::string> v1 = snapshot.load();
+  auto held = snapshot.publish("v2");
+  std::weak_ptr<const std::string> v2 = snapshot.load();
+
+  snapshot.publish("v3");
+  EXPECT_FALSE(v2.expired()); // Still cached by this thread
+  EXPECT_EQ(*snapshot.load(), "v3");
+
+  EXPECT_FALSE(v1.expired());
+  EXPECT_TRUE(v2.expired());
+  held.reset();
+  EXPECT_TRUE(v1.expired());
+}
+
+TEST(AtomicSnapshotTest, SeparateCellsDoNotShareCachedValues) {
+  AtomicSnapshot<std::string> first("a");
+  AtomicSnapshot<std::string> second("b");
+
+  EXPECT_EQ(*first.load(), "a");
+  EXPECT_EQ(*second.load(), "b");
+  first.publish("c");
+  EXPECT_EQ(*second.load(), "b");
+  EXPECT_EQ(*first.load(), "c");
+}
+
+TEST(AtomicSnapshotTest, ConcurrentReadersSeeCompleteValues) {
+  struct Pair {
+    int a;
+    int b;
+  };
+  AtomicSnapshot<Pair> snapshot(Pair{0, 0});
+  std::atomic<bool> stop{false};
+  std::atomic<int> torn{0};
+
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 4; ++i) {
+    readers.emplace_back([&]() {
+      while (!stop.load()) {
+        auto value = snapshot.load();
+        if (value->a != value->b) {
+          torn++;
+        }
+      }
+    });
+  }
+
+  for (int i = 1; i <= 1000; ++i) {
+    snapshot.publish(Pair{i, i});
+  }
+  stop = true;
+  for (auto &t : readers) {
+    t.join();
+  }
+
+  EXPECT_EQ(torn.load(), 0);
+  EXPECT_EQ(snapshot.load()->a, 1000);
+}
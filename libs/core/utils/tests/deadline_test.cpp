@@ -0,0 +1,98 @@
+#include "Deadline.h"
+
+#include <gtest/gtest.h>
+
+using namespace astra::utils;
+using namespace std::chrono_literals;
+
+TEST(DeadlineTest, DefaultIsUnsetAndNeverExpires) {
+  Deadline deadline;
+
+  EXPECT_FALSE(deadline.is_set());
+  EXPECT_FALSE(deadline.expired());
+}
+
+TEST(DeadlineTest, RemainingCountsDown) {
+  auto deadline = Deadline::after(500ms);
+
+  EXPECT_TRUE(deadline.is_set());
+  EXPECT_FALSE(deadline.expired());
+  EXPECT_GT(deadline.remaining(), 400ms);
+  EXPECT_LE(deadline.remaining(), 500ms);
+}
+
+TEST(DeadlineTest, PastDeadlineIsExpiredWithZeroRemaining) {
+  auto deadline = Deadline::at(Deadline::Clock::now() - 1s);
+
+  EXPECT_TRUE(deadline.expired());
+  EXPECT_EQ(deadline.remaining(), 0ms);
+}
+
+TEST(DeadlineTest, EarliestPicksTighterDeadline) {
+  auto loose = Deadline::after(10s);
+  auto tight = Deadline::after(1s);
+
+  EXPECT_EQ(loose.earliest(tight).when(), tight.when());
+  EXPECT_EQ(tight.earliest(loose).when(), tight.when());
+  EXPECT_EQ(Deadline().earliest(tight).when(), tight.when());
+}
+
+TEST(DeadlineTest, FormatsGrpcTimeout) {
+  auto deadline = Deadline::at(Deadline::Clock::now() + 2s + 500ms);
+
+  auto value = deadline.to_grpc_timeout();
+  ASSERT_EQ(value.back(), 'm');
+  auto parsed = Deadline::parse_grpc_timeout(value);
+  ASSERT_TRUE(parsed.has_value());
+  EXPECT_GT(*parsed, 2400ms);
+  EXPECT_LE(*parsed, 2500ms);
+}
+
+TEST(DeadlineTest, ParsesGrpcTimeoutUnits) {
+  EXPECT_EQ(Deadline::parse_grpc_timeout("1H"), 3600000ms);
+  EXPECT_EQ(Deadline::parse_grpc_timeout("2M"), 120000ms);
+  EXPECT_EQ(Deadline::parse_grpc_timeout("3S"), 3000ms);
+  EXPECT_EQ(Deadline::parse_grpc_timeout("250m"), 250ms);
+  EXPECT_EQ(Deadline::parse_grpc_timeout("1500u"), 1ms);
+  EXPECT_EQ(Deadline::parse_grpc_timeout("99999999n"), 99ms);
+}
+
+TEST(DeadlineTest, ClampsHugeGrpcTimeout) {
+  EXPECT_EQ(Deadline::parse_grpc_timeout("99999999H"),
+            Deadline::kMaxGrpcTimeout);
+  EXPECT_EQ(Deadline::parse_grpc_timeout("99999999M"),
+            Deadline::kMaxGrpcTimeout);
+  EXPECT_EQ(Deadline::parse_grpc_timeout("24H"), Deadline::kMaxGrpcTimeout);
+  EXPECT_EQ(Deadline::parse_grpc_timeout("23H"), 23h);
+
+  auto deadline = Deadline::after(*Deadline::parse_grpc_timeout("99999999H"));
+  EXPECT_FALSE(deadline.expired());
+  EXPECT_GT(deadline.remaining(), 23h);
+}
+
+TEST(DeadlineTest, AfterSaturatesInsteadOfOverflowing) {
+  auto far = Deadline::after(std::chrono::milliseconds::max());
+  EXPECT_TRUE(far.is_set());
+  EXPECT_FALSE(far.expired());
+  EXPECT_GT(far.remaining(), 24h * 365 * 100);
+
+  auto hours = Deadline::after(std::chrono::hours(99999999));
+  EXPECT_FALSE(hours.expired());
+
+  auto value = far.to_grpc_timeout();
+  EXPECT_LE(value.size(), 9);
+  EXPECT_EQ(value.back(), 'H');
+  EXPECT_EQ(Deadline::parse_grpc_timeout(value), Deadline::kMaxGrpcTimeout);
+
+  auto past = Deadline::after(std::chrono::milliseconds::min());
+  EXPECT_TRUE(past.expired());
+}
+
+TEST(DeadlineTest, RejectsMalformedGrpcTimeout) {
+  EXPECT_FALSE(Deadline::parse_grpc_timeout(""));
+  EXPECT_FALSE(Deadline::parse_grpc_timeout("m"));
+  EXPECT_FALSE(Deadline::parse_grpc_timeout("10"));
+  EXPECT_FALSE(Deadline::parse_grpc_timeout("10x"));
+  EXPECT_FALSE(Deadline::parse_grpc_timeout("-5m"));
+  EXPECT_FALSE(Deadline::parse_grpc_timeout("123456789m"));
+}
@@ -0,0 +1,73 @@
+#include "HeaderBlock.h"
+
+#include <gtest/gtest.h>
+#include <map>
+#include <string>
+
+using astra::utils::HeaderBlock;
+using astra::utils::HeaderName;
+using astra::utils::HeaderView;
+namespace header = astra::utils::header;
+
+TEST(HeaderBlockTest, NamesAreLowercasedAndLookupsFoldCase) {
+  HeaderBlock headers{{"Content-Type", "application/json"}};
+  headers["X-Request-Id"] = "abc";
+
+  EXPECT_EQ(headers.begin()->first, "content-type");
+  EXPECT_EQ(headers.get("CONTENT-TYPE"), "application/json");
+  EXPECT_EQ(headers.get(header::kContentType), "application/json");
+  EXPECT_EQ(headers.get("x-request-id"), "abc");
+  EXPECT_TRUE(headers.get("missing").empty());
+}
+
+TEST(HeaderBlockTest, SetOverwritesInPlace) {
+  HeaderBlock headers{{"a", "1"}, {"b", "2"}};
+  headers.set("A", "3");
+
+  ASSERT_EQ(headers.size(), 2u);
+  EXPECT_EQ(headers.begin()->first, "a");
+  EXPECT_EQ(headers.begin()->second, "3");
+}
+
+TEST(HeaderBlockTest, EraseKeepsHashesAligned) {
+  HeaderBlock headers{{"a", "1"}, {"b", "2"}, {"c", "3"}};
+  EXPECT_TRUE(headers.erase("b"));
+  EXPECT_FALSE(headers.erase("b"));
+
+  EXPECT_EQ(headers.size(), 2u);
+  EXPECT_EQ(headers.get("a"), "1");
+  EXPECT_EQ(headers.get("c"), "3");
+  EXPECT_EQ(headers.find("b"), headers.end());
+}
+
+TEST(HeaderBlockTest, GrowsPastInlineCapacity) {
+  HeaderBlock headers;
+  for (size_t i = 0; i < HeaderBlock::kInlineHeaders * 2; ++i) {
+    headers.set("h" + std::to_string(i), std::to_string(i));
+  }
+  EXPECT_EQ(headers.size(), HeaderBlock::kInlineHeaders * 2);
+  EXPECT_EQ(headers.get("h15"), "15");
+}
+
+TEST(HeaderBlockTest, WellKnownHashesAreCompileTime) {
+  static_assert(header::kGrpcTimeout.hash() ==
+                HeaderName::hash("GRPC-Timeout"));
+  SUCCEED();
+}
+
+TEST(HeaderViewTest, ReadsForeignContainerWithoutCopy) {
+  struct Value {
+    std::string value;
+  };
+  std::multimap<std::string, Value> raw{{"content-length", {"42"}},
+                                        {"host", {"example"}}};
+  HeaderView view(raw);
+
+  EXPECT_EQ(view.get(header::kContentLength).data(),
+            raw.find("content-length")->second.value.data());
+  EXPECT_TRUE(view.get("accept").empty());
+
+  auto block = view.to_block();
+  EXPECT_EQ(block.size(), 2u);
+  EXPECT_EQ(block.get("host"), "example");
+}
@@ -1,7 +1,7 @@
 #pragma once
 
+#include <HeaderBlock.h>
 #include <boost/beast/http.hpp>
-#include <map>
 #include <string>
 
 namespace astra::http1 {
@@ -9,7 +9,7 @@ namespace astra::http1 {
 struct Response {
   int status_code;
   std::string body;
-  std::map<std::string, std::string> headers;
+  astra::utils::HeaderBlock headers;
 };
 
 class Client {
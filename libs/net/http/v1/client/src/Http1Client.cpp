@@ -68,8 +68,9 @@ Response Client::perform_request(const std::string &host,
     response.status_code = res.result_int();
     response.body = res.body();
     for (auto &field : res) {
-      response.headers[std::string(field.name_string())] =
-          std::string(field.value());
+      auto name = field.name_string();
+      response.headers.set(std::string_view(name.data(), name.size()),
+                           std::string(field.value()));
     }
     return response;
 
@@ -17,6 +17,7 @@ public:
   [[nodiscard]] const std::string &path() const override;
   [[nodiscard]] std::string header(const std::string &name) const override;
   [[nodiscard]] const std::string &body() const override;
+  [[nodiscard]] std::string_view body_view() const override;
   [[nodiscard]] std::string path_param(const std::string &key) const override;
   [[nodiscard]] std::string query_param(const std::string &key) const override;
 
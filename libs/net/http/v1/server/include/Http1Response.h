@@ -14,11 +14,17 @@ public:
       boost::beast::http::response<boost::beast::http::string_body>)>;
 
   explicit Response(SendCallback callback);
+  // A response dropped without an answer sends a bare 500, so the
+  // connection is never left owing it
+  ~Response() override;
 
   void set_status(int status_code) noexcept override;
   void set_header(const std::string &name, const std::string &value) override;
   void write(const std::string &content) override;
   void close() override;
+  void send_prepared(
+      const std::shared_ptr<const astra::router::PreparedResponse> &response)
+      override;
   [[nodiscard]] bool is_alive() const noexcept override;
 
 private:
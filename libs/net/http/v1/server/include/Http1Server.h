@@ -7,6 +7,7 @@
 #include <boost/asio.hpp>
 #include <boost/beast/core.hpp>
 #include <boost/beast/http.hpp>
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <string>
@@ -17,10 +18,40 @@ namespace astra::http1 {
 
 class Server {
 public:
+  // Answers before returning; the request and response are only borrowed
+  // for the call. Routes served through router() may instead answer
+  // later, from any thread, as Execution::Offload routes do.
   using Handler = std::function<void(astra::router::IRequest &,
                                      astra::router::IResponse &)>;
 
+  enum class AcceptMode {
+    // One acceptor and one io_context shared by every thread
+    Shared,
+    // One SO_REUSEPORT acceptor and io_context per thread; the kernel
+    // spreads connections and each loop runs without cross-thread locking
+    ReusePort,
+  };
+
+  struct Options {
+    int threads = 1;
+    AcceptMode accept_mode = AcceptMode::Shared;
+    // ReusePort only, Linux only: pins loop i (and the thread calling
+    // run() as loop 0) to CPU i and steers each connection to the loop
+    // on the CPU that received it
+    bool cpu_affinity = false;
+    // A kept-alive connection is closed when no request has arrived this
+    // long after its last response; zero waits forever
+    std::chrono::milliseconds idle_timeout{std::chrono::seconds(30)};
+    // Responses a connection may owe before the server stops reading
+    // pipelined requests from it
+    size_t pipeline_limit = 16;
+    // The response to the last request allowed carries Connection: close;
+    // zero means no limit
+    size_t max_requests_per_connection = 0;
+  };
+
   Server(const std::string &address, unsigned short port, int threads = 1);
+  Server(const std::string &address, unsigned short port, Options options);
   ~Server();
 
   void handle(Handler handler);
@@ -31,18 +62,43 @@ public:
     return m_router;
   }
 
+  // Port the server listens on; the one the kernel chose if constructed
+  // with port 0
+  [[nodiscard]] unsigned short port() const noexcept {
+    return m_port;
+  }
+
+  // Whether the kernel is steering connections by CPU; false if the
+  // filter could not be attached, in which case the kernel hashes instead
+  [[nodiscard]] bool cpu_steering() const noexcept {
+    return m_cpu_steering;
+  }
+
 private:
-  void do_accept();
+  struct Loop {
+    explicit Loop(int concurrency) : ioc(concurrency), acceptor(ioc) {
+    }
+
+    boost::asio::io_context ioc;
+    boost::asio::ip::tcp::acceptor acceptor;
+  };
+
+  void open_acceptor(Loop &loop, const boost::asio::ip::tcp::endpoint &endpoint,
+                     bool reuse_port);
+  void run_loop(size_t index);
+  void do_accept(Loop &loop);
   void do_session(boost::asio::ip::tcp::socket socket);
 
   std::string m_address;
   unsigned short m_port;
-  int m_threads;
-  boost::asio::io_context m_ioc;
+  Options m_options;
+  std::vector<std::unique_ptr<Loop>> m_loops;
+  bool m_cpu_steering = false;
   astra::router::Router m_router;
-  boost::asio::ip::tcp::acceptor m_acceptor;
   std::vector<std::thread> m_thread_pool;
-  Handler m_handler;
+  // Sessions share ownership of the request and response with whatever
+  // this hands them to
+  astra::router::Handler m_handler;
   mutable std::mutex m_handler_mutex;
 };
 
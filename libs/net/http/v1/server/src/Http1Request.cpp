@@ -30,6 +30,10 @@ const std::string &Request::body() const {
   return body_str_;
 }
 
+std::string_view Request::body_view() const {
+  return req_.body();
+}
+
 std::string Request::path_param(const std::string &key) const {
   auto it = path_params_.find(key);
   if (it != path_params_.end()) {
@@ -6,6 +6,17 @@ Response::Response(SendCallback callback) : callback_(std::move(callback)) {
   res_.version(11); // HTTP/1.1
 }
 
+Response::~Response() {
+  if (closed_ || !callback_) {
+    return;
+  }
+  boost::beast::http::response<boost::beast::http::string_body> res;
+  res.version(res_.version());
+  res.result(boost::beast::http::status::internal_server_error);
+  res.prepare_payload();
+  callback_(std::move(res));
+}
+
 void Response::set_status(int status_code) noexcept {
   res_.result(static_cast<boost::beast::http::status>(status_code));
 }
@@ -29,6 +40,26 @@ void Response::close() {
   }
 }
 
+void Response::send_prepared(
+    const std::shared_ptr<const astra::router::PreparedResponse> &response) {
+  if (closed_) {
+    return;
+  }
+  // Anything set before is dropped, as with HTTP/2
+  boost::beast::http::response<boost::beast::http::string_body> res;
+  res.version(res_.version());
+  res.result(static_cast<boost::beast::http::status>(response->status()));
+  for (const auto &[name, value] : response->headers()) {
+    res.set(boost::beast::string_view(name.data(), name.size()),
+            boost::beast::string_view(value.data(), value.size()));
+  }
+  res.body().assign(response->body().data(), response->body().size());
+  if (callback_) {
+    callback_(std::move(res));
+  }
+  closed_ = true;
+}
+
 bool Response::is_alive() const noexcept {
   return !closed_;
 }
@@ -3,7 +3,20 @@
 #include "Http1Request.h"
 #include "Http1Response.h"
 
+#include <algorithm>
+#include <atomic>
+#include <boost/asio/steady_timer.hpp>
+#include <deque>
 #include <iostream>
+#include <optional>
+#include <thread>
+
+#ifdef __linux__
+#include <linux/filter.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/socket.h>
+#endif
 
 namespace astra::http1 {
 
@@ -12,27 +25,75 @@ namespace http = beast::http;
 namespace net = boost::asio;
 using tcp = net::ip::tcp;
 
+namespace {
+
+#ifdef __linux__
+// The program applies to the whole SO_REUSEPORT group, so one socket is enough
+bool attach_cpu_steering(tcp::acceptor &acceptor, size_t group_size) {
+#ifdef SO_ATTACH_REUSEPORT_CBPF
+  // Pick the socket whose index matches the CPU handling the packet
+  sock_filter code[] = {
+      {BPF_LD | BPF_W | BPF_ABS, 0, 0,
+       static_cast<uint32_t>(SKF_AD_OFF + SKF_AD_CPU)},
+      {BPF_ALU | BPF_MOD | BPF_K, 0, 0, static_cast<uint32_t>(group_size)},
+      {BPF_RET | BPF_A, 0, 0, 0},
+  };
+  sock_fprog program{static_cast<unsigned short>(std::size(code)), code};
+  return setsockopt(acceptor.native_handle(), SOL_SOCKET,
+                    SO_ATTACH_REUSEPORT_CBPF, &program, sizeof(program)) == 0;
+#else
+  (void)acceptor;
+  (void)group_size;
+  return false;
+#endif
+}
+
+void pin_to_cpu(size_t cpu) {
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu % std::max(std::thread::hardware_concurrency(), 1u), &set);
+  pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+#endif
+
+} // namespace
+
 Server::Server(const std::string &address, unsigned short port, int threads)
-    : m_address(address), m_port(port), m_threads(threads), m_ioc(threads),
-      m_acceptor(m_ioc) {
+    : Server(address, port, Options{threads}) {
+}
+
+Server::Server(const std::string &address, unsigned short port,
+               Options options)
+    : m_address(address), m_port(port), m_options(options) {
+  m_options.threads = std::max(m_options.threads, 1);
   const auto addr = net::ip::make_address(address);
-  const auto endpoint = tcp::endpoint{addr, port};
-
-  m_acceptor.open(endpoint.protocol());
-  m_acceptor.set_option(net::socket_base::reuse_address(true));
-  m_acceptor.bind(endpoint);
-  m_acceptor.listen(net::socket_base::max_listen_connections);
-
-  // Default handler: Dispatch to Router using shared_ptr wrappers
-  m_handler = [this](astra::router::IRequest &req,
-                     astra::router::IResponse &res) {
-    // Use aliasing constructor to create shared_ptr that doesn't own the object
-    // This is safe because the request/response outlive the dispatch call
-    auto req_ptr =
-        std::shared_ptr<astra::router::IRequest>(std::shared_ptr<void>{}, &req);
-    auto res_ptr = std::shared_ptr<astra::router::IResponse>(
-        std::shared_ptr<void>{}, &res);
-    m_router.dispatch(req_ptr, res_ptr);
+  auto endpoint = tcp::endpoint{addr, port};
+
+  if (m_options.accept_mode == AcceptMode::Shared) {
+    m_loops.push_back(std::make_unique<Loop>(m_options.threads));
+    open_acceptor(*m_loops.front(), endpoint, false);
+  } else {
+    for (int i = 0; i < m_options.threads; ++i) {
+      m_loops.push_back(std::make_unique<Loop>(1));
+      open_acceptor(*m_loops.back(), endpoint, true);
+      // With port 0 the first bind picks the port; the rest must join it
+      // rather than each getting a port of their own
+      endpoint.port(m_loops.front()->acceptor.local_endpoint().port());
+    }
+#ifdef __linux__
+    if (m_options.cpu_affinity) {
+      m_cpu_steering =
+          attach_cpu_steering(m_loops.front()->acceptor, m_loops.size());
+    }
+#endif
+  }
+  m_port = m_loops.front()->acceptor.local_endpoint().port();
+
+  // Default handler: the router gets owning pointers, so an offloaded
+  // route keeps its request and response alive until it answers
+  m_handler = [this](std::shared_ptr<astra::router::IRequest> req,
+                     std::shared_ptr<astra::router::IResponse> res) {
+    m_router.dispatch(std::move(req), std::move(res));
   };
 }
 
@@ -42,22 +103,58 @@ Server::~Server() {
 
 void Server::handle(Handler handler) {
   std::lock_guard<std::mutex> lock(m_handler_mutex);
-  m_handler = std::move(handler);
+  m_handler = [handler = std::move(handler)](
+                  std::shared_ptr<astra::router::IRequest> req,
+                  std::shared_ptr<astra::router::IResponse> res) {
+    handler(*req, *res);
+  };
+}
+
+void Server::open_acceptor(Loop &loop, const tcp::endpoint &endpoint,
+                           bool reuse_port) {
+  loop.acceptor.open(endpoint.protocol());
+  loop.acceptor.set_option(net::socket_base::reuse_address(true));
+  if (reuse_port) {
+#ifdef SO_REUSEPORT
+    loop.acceptor.set_option(
+        net::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>(true));
+#else
+    throw std::runtime_error("SO_REUSEPORT is not supported on this platform");
+#endif
+  }
+  loop.acceptor.bind(endpoint);
+  loop.acceptor.listen(net::socket_base::max_listen_connections);
 }
 
 void Server::run() {
-  do_accept();
+  for (auto &loop : m_loops) {
+    do_accept(*loop);
+  }
 
-  for (int i = 0; i < m_threads - 1; ++i) {
-    m_thread_pool.emplace_back([this] {
-      m_ioc.run();
+  // Shared: every thread runs the one loop. ReusePort: thread i owns loop i.
+  for (int i = 1; i < m_options.threads; ++i) {
+    size_t index = m_loops.size() == 1 ? 0 : static_cast<size_t>(i);
+    m_thread_pool.emplace_back([this, index] {
+      run_loop(index);
     });
   }
-  m_ioc.run();
+  run_loop(0);
+}
+
+void Server::run_loop(size_t index) {
+#ifdef __linux__
+  if (m_options.cpu_affinity &&
+      m_options.accept_mode == AcceptMode::ReusePort) {
+    pin_to_cpu(index);
+  }
+#endif
+  m_loops[index]->ioc.run();
 }
 
 void Server::stop() {
-  m_ioc.stop();
+  for (auto &loop : m_loops) {
+    loop->ioc.stop();
+  }
   for (auto &t : m_thread_pool) {
     if (t.joinable()) {
       t.join();
@@ -66,19 +163,48 @@ void Server::stop() {
   m_thread_pool.clear();
 }
 
+// One connection. Requests are read back to back, so a pipelining client
+// is served without waiting on each response. Each request takes the next
+// slot in the outbox when it is read; its response fills that slot whenever
+// the handler answers, inline or later from another thread, and slots go
+// out strictly in order, one write at a time. The read buffer outlives each
+// request, carrying over whatever bytes of the next one arrived early.
 class Session : public std::enable_shared_from_this<Session> {
+  using Message = http::response<http::string_body>;
+
   tcp::socket socket_;
+  net::any_io_executor m_executor;
   beast::flat_buffer buffer_;
-  http::request<http::string_body> req_;
-  Server::Handler
-      m_handler; // Copy of handler (std::function is cheap to copy usually, or
-                 // use reference if lifetime guaranteed)
-  // Actually Server lifetime outlives Session? Not necessarily if Server is
-  // destroyed. But Handler is a function object.
+  std::optional<http::request_parser<http::string_body>> m_parser;
+  astra::router::Handler m_handler;
+  net::steady_timer m_idle_timer;
+  std::chrono::milliseconds m_idle_timeout;
+  size_t m_pipeline_limit;
+  size_t m_max_requests;
+
+  // One slot per request owed a response, oldest first; empty until the
+  // handler answers. The front one is being written while m_writing is set.
+  std::deque<std::optional<Message>> m_outbox;
+  uint64_t m_front_seq = 0; // Sequence number of m_outbox.front()
+  uint64_t m_next_seq = 0;
+  size_t m_requests = 0;
+  bool m_reading = false;
+  bool m_writing = false;
+  // No more requests will be read: the peer finished, asked to close or
+  // used up its request allowance
+  bool m_read_done = false;
+  // Set while a handler runs on the session's thread, so an answer given
+  // during the call is taken without a post
+  std::atomic<std::thread::id> m_handler_thread{};
 
 public:
-  Session(tcp::socket socket, Server::Handler handler)
-      : socket_(std::move(socket)), m_handler(std::move(handler)) {
+  Session(tcp::socket socket, astra::router::Handler handler,
+          const Server::Options &options)
+      : socket_(std::move(socket)), m_executor(socket_.get_executor()),
+        m_handler(std::move(handler)), m_idle_timer(m_executor),
+        m_idle_timeout(options.idle_timeout),
+        m_pipeline_limit(std::max<size_t>(options.pipeline_limit, 1)),
+        m_max_requests(options.max_requests_per_connection) {
   }
 
   void run() {
@@ -87,92 +213,178 @@ public:
 
 private:
   void do_read() {
+    m_parser.emplace();
+    m_reading = true;
+    watch_idle();
+
     auto self = shared_from_this();
-    http::async_read(
-        socket_, buffer_, req_,
-        [self](beast::error_code ec, std::size_t bytes_transferred) {
-          boost::ignore_unused(bytes_transferred);
-          if (ec == http::error::end_of_stream) {
-            return self->do_close();
-          }
-          if (ec) {
-            return; // Log error?
-          }
-
-          self->process_request();
-        });
-  }
-
-  void process_request() {
-    auto self = shared_from_this();
+    http::async_read(socket_, buffer_, *m_parser,
+                     [self](beast::error_code ec, std::size_t) {
+                       self->on_read(ec);
+                     });
+  }
+
+  void on_read(beast::error_code ec) {
+    m_reading = false;
+    m_idle_timer.cancel();
+
+    if (ec == http::error::end_of_stream) {
+      m_read_done = true;
+      if (m_outbox.empty()) {
+        do_close();
+      }
+      return;
+    }
+    if (ec) {
+      // Reset, malformed, or closed by the idle watch; whatever is queued
+      // still goes out
+      m_read_done = true;
+      return;
+    }
+
+    ++m_requests;
+    auto req = m_parser->release();
+    bool keep_alive = req.keep_alive() &&
+                      (m_max_requests == 0 || m_requests < m_max_requests);
+    m_read_done = !keep_alive;
+    process_request(std::move(req), keep_alive);
+
+    do_write();
+    if (!m_read_done && m_outbox.size() < m_pipeline_limit) {
+      do_read();
+    }
+  }
 
-    // Create abstractions
-    // We need to keep request alive until response is sent?
-    // The Request object copies data or views?
-    // Http1Request uses boost::beast::http::request which owns data.
-    // We move req_ into Request?
-    // If we move req_, we can't use it for next loop if we wanted to reuse.
-    // But for now let's assume one request per read or reset.
-
-    // Construct Request wrapper
-    // We need to be careful about moving req_ if we want to support
-    // pipelining/keep-alive later. But Http1Request takes by value/move
-    // usually.
-
-    // Let's look at Http1Request constructor: explicit
-    // Request(boost::beast::http::request<...> req); It takes by value (copy or
-    // move).
-
-    Request request(std::move(req_));
-
-    auto send_lambda = [self](http::response<http::string_body> msg) {
-      // The response object 'msg' needs to be kept alive during async_write
-      // We need a shared_ptr to the message or capture it by value in the
-      // lambda. http::async_write takes the message by const reference. So the
-      // message must exist until completion.
-
-      auto sp =
-          std::make_shared<http::response<http::string_body>>(std::move(msg));
-
-      http::async_write(self->socket_, *sp,
-                        [self, sp](beast::error_code ec, std::size_t bytes) {
-                          self->socket_.shutdown(tcp::socket::shutdown_send,
-                                                 ec);
-                          // In a real server we would check keep-alive and loop
-                          // back to do_read()
-                        });
+  void process_request(http::request<http::string_body> req,
+                       bool keep_alive) {
+    const unsigned version = req.version();
+    const uint64_t seq = m_next_seq++;
+    m_outbox.emplace_back();
+
+    // Stamped here rather than by Response, which cannot see the request.
+    // The callback keeps the session alive until the answer is in.
+    auto answer = [self = shared_from_this(), seq, version,
+                   keep_alive](Message msg) {
+      msg.version(version);
+      msg.keep_alive(keep_alive);
+      self->deliver(seq, std::move(msg));
     };
 
-    Response response(send_lambda);
+    m_handler_thread.store(std::this_thread::get_id());
+    {
+      auto request = std::make_shared<Request>(std::move(req));
+      auto response = std::make_shared<Response>(std::move(answer));
+      if (m_handler) {
+        m_handler(std::move(request), std::move(response));
+      } else {
+        response->set_status(404);
+        response->write("No handler configured");
+        response->close();
+      }
+    }
+    m_handler_thread.store(std::thread::id{});
+  }
 
-    if (m_handler) {
-      m_handler(request, response);
-    } else {
-      response.set_status(404);
-      response.write("No handler configured");
-      response.close();
+  // May be called from any thread
+  void deliver(uint64_t seq, Message msg) {
+    if (m_handler_thread.load() == std::this_thread::get_id()) {
+      on_response(seq, std::move(msg));
+      return;
     }
+    net::post(m_executor, [self = shared_from_this(), seq,
+                           msg = std::move(msg)]() mutable {
+      self->on_response(seq, std::move(msg));
+      self->do_write();
+    });
+  }
+
+  void on_response(uint64_t seq, Message msg) {
+    if (!socket_.is_open()) {
+      return;
+    }
+    m_outbox[seq - m_front_seq] = std::move(msg);
+  }
+
+  void do_write() {
+    if (m_writing || m_outbox.empty() || !m_outbox.front()) {
+      return;
+    }
+    m_writing = true;
+
+    auto self = shared_from_this();
+    http::async_write(socket_, *m_outbox.front(),
+                      [self](beast::error_code ec, std::size_t) {
+                        self->on_write(ec);
+                      });
+  }
+
+  void on_write(beast::error_code ec) {
+    m_writing = false;
+    const bool keep_alive = m_outbox.front()->keep_alive();
+    m_outbox.pop_front();
+    ++m_front_seq;
+
+    if (ec) {
+      close_socket();
+      return;
+    }
+    if (!keep_alive || (m_read_done && m_outbox.empty())) {
+      do_close();
+      return;
+    }
+
+    do_write();
+    if (m_reading) {
+      watch_idle();
+    } else if (!m_read_done && m_outbox.size() < m_pipeline_limit) {
+      do_read();
+    }
+  }
+
+  // Only a connection owing nothing is idle; the watch is re-armed once
+  // the last queued response is out
+  void watch_idle() {
+    if (m_idle_timeout.count() == 0 || !m_outbox.empty()) {
+      return;
+    }
+    m_idle_timer.expires_after(m_idle_timeout);
+    m_idle_timer.async_wait([self = shared_from_this()](beast::error_code ec) {
+      if (!ec && self->m_outbox.empty()) {
+        self->close_socket();
+      }
+    });
   }
 
   void do_close() {
     beast::error_code ec;
     socket_.shutdown(tcp::socket::shutdown_send, ec);
   }
+
+  void close_socket() {
+    beast::error_code ec;
+    socket_.shutdown(tcp::socket::shutdown_both, ec);
+    socket_.close(ec);
+  }
 };
 
-void Server::do_accept() {
-  m_acceptor.async_accept(net::make_strand(m_ioc), [this](beast::error_code ec,
-                                                          tcp::socket socket) {
+void Server::do_accept(Loop &loop) {
+  // A loop run by one thread needs no strand around its sessions
+  auto executor = m_loops.size() == 1 && m_options.threads > 1
+                      ? net::any_io_executor(net::make_strand(loop.ioc))
+                      : net::any_io_executor(loop.ioc.get_executor());
+  loop.acceptor.async_accept(executor, [this, &loop](beast::error_code ec,
+                                                     tcp::socket socket) {
     if (!ec) {
-      Handler handler_copy;
+      astra::router::Handler handler_copy;
       {
         std::lock_guard<std::mutex> lock(m_handler_mutex);
         handler_copy = m_handler;
       }
-      std::make_shared<Session>(std::move(socket), std::move(handler_copy))
+      std::make_shared<Session>(std::move(socket), std::move(handler_copy),
+                                m_options)
           ->run();
     }
-    do_accept();
+    do_accept(loop);
   });
 }
 
@@ -1,11 +1,15 @@
 #include "Http1Server.h"
 
 #include <boost/asio.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
 #include <chrono>
+#include <functional>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
-#include <random>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 using namespace std::chrono_literals;
 using namespace testing;
@@ -39,51 +43,79 @@ std::string send_request(int port, const std::string &method,
   }
 }
 
+namespace http = boost::beast::http;
+
+// A client connection that can send several requests, pipelined or not,
+// and read each response whole
+class Connection {
+public:
+  explicit Connection(int port) : m_socket(m_ioc) {
+    m_socket.connect(boost::asio::ip::tcp::endpoint(
+        boost::asio::ip::make_address("127.0.0.1"), port));
+  }
+
+  void send(const std::string &method, const std::string &path,
+            const std::string &body = "",
+            const std::string &extra_headers = "") {
+    std::string req = method + " " + path +
+                      " HTTP/1.1\r\nHost: 127.0.0.1\r\nContent-Length: " +
+                      std::to_string(body.size()) + "\r\n" + extra_headers +
+                      "\r\n" + body;
+    boost::asio::write(m_socket, boost::asio::buffer(req));
+  }
+
+  http::response<http::string_body> read() {
+    http::response<http::string_body> res;
+    http::read(m_socket, m_buffer, res);
+    return res;
+  }
+
+  // True once the server has closed its side
+  bool closed_by_peer() {
+    boost::beast::error_code ec;
+    http::response<http::string_body> res;
+    http::read(m_socket, m_buffer, res, ec);
+    return ec == http::error::end_of_stream ||
+           ec == boost::asio::error::eof ||
+           ec == boost::asio::error::connection_reset;
+  }
+
+private:
+  boost::asio::io_context m_ioc;
+  boost::asio::ip::tcp::socket m_socket;
+  boost::beast::flat_buffer m_buffer;
+};
+
 class Http1ServerTest : public Test {
 protected:
   void SetUp() override {
-    // Retry with different random ports to avoid collisions in parallel
-    // execution
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(20000, 60000);
-
-    const int max_retries = 10;
-    for (int attempt = 0; attempt < max_retries; ++attempt) {
-      m_port = dis(gen);
-
-      try {
-        server_ =
-            std::make_unique<astra::http1::Server>("127.0.0.1", m_port, 4);
-        server_->handle([](const astra::router::IRequest &req,
-                           astra::router::IResponse &res) {
-          if (req.path() == "/test") {
-            res.set_status(200);
-            res.write("Hello Test");
-          } else if (req.path() == "/echo") {
-            res.set_status(200);
-            res.write(req.body());
-          } else {
-            res.set_status(404);
-          }
-          res.close();
-        });
-
-        server_thread_ = std::thread([this] {
-          server_->run();
-        });
-
-        // Wait for server to start
-        std::this_thread::sleep_for(100ms);
-        return; // Success
-      } catch (const std::exception &e) {
-        // Port likely in use, try another
-        server_.reset();
-        if (attempt == max_retries - 1) {
-          throw; // Give up after max retries
-        }
+    // Port 0 lets the kernel pick a free port, so parallel runs never collide
+    server_ = std::make_unique<astra::http1::Server>("127.0.0.1", 0, options());
+    m_port = server_->port();
+    server_->handle([](const astra::router::IRequest &req,
+                       astra::router::IResponse &res) {
+      if (req.path() == "/test") {
+        res.set_status(200);
+        res.write("Hello Test");
+      } else if (req.path() == "/echo") {
+        res.set_status(200);
+        res.write(req.body());
+      } else {
+        res.set_status(404);
       }
-    }
+      res.close();
+    });
+
+    server_thread_ = std::thread([this] {
+      server_->run();
+    });
+
+    // Wait for server to start
+    std::this_thread::sleep_for(100ms);
+  }
+
+  virtual astra::http1::Server::Options options() const {
+    return {4};
   }
 
   void TearDown() override {
@@ -166,3 +198,228 @@ TEST_F(Http1ServerTest, HighConcurrency) {
 
   EXPECT_EQ(success_count, num_threads * 10);
 }
+
+TEST_F(Http1ServerTest, KeepAliveServesRequestsOnOneConnection) {
+  Connection connection(m_port);
+  for (int i = 0; i < 5; ++i) {
+    connection.send("GET", "/test");
+    auto res = connection.read();
+    EXPECT_EQ(res.result_int(), 200);
+    EXPECT_EQ(res.body(), "Hello Test");
+    EXPECT_TRUE(res.keep_alive());
+  }
+}
+
+TEST_F(Http1ServerTest, PipelinedResponsesComeBackInOrder) {
+  Connection connection(m_port);
+  connection.send("GET", "/test");
+  connection.send("POST", "/echo", "second");
+  connection.send("GET", "/unknown");
+
+  auto first = connection.read();
+  auto second = connection.read();
+  auto third = connection.read();
+  EXPECT_EQ(first.body(), "Hello Test");
+  EXPECT_EQ(second.body(), "second");
+  EXPECT_EQ(third.result_int(), 404);
+}
+
+TEST_F(Http1ServerTest, ConnectionCloseIsHonoured) {
+  Connection connection(m_port);
+  connection.send("GET", "/test", "", "Connection: close\r\n");
+
+  auto res = connection.read();
+  EXPECT_EQ(res.result_int(), 200);
+  EXPECT_FALSE(res.keep_alive());
+  EXPECT_TRUE(connection.closed_by_peer());
+}
+
+class Http1ServerLimitsTest : public Http1ServerTest {
+protected:
+  astra::http1::Server::Options options() const override {
+    astra::http1::Server::Options options;
+    options.threads = 2;
+    options.idle_timeout = 200ms;
+    options.pipeline_limit = 1;
+    options.max_requests_per_connection = 3;
+    return options;
+  }
+};
+
+TEST_F(Http1ServerLimitsTest, ClosesAfterMaxRequests) {
+  Connection connection(m_port);
+  for (int i = 0; i < 3; ++i) {
+    connection.send("GET", "/test");
+  }
+
+  EXPECT_TRUE(connection.read().keep_alive());
+  EXPECT_TRUE(connection.read().keep_alive());
+  auto last = connection.read();
+  EXPECT_EQ(last.result_int(), 200);
+  EXPECT_FALSE(last.keep_alive());
+  EXPECT_TRUE(connection.closed_by_peer());
+}
+
+TEST_F(Http1ServerLimitsTest, IdleConnectionIsClosed) {
+  Connection connection(m_port);
+  connection.send("GET", "/test");
+  EXPECT_EQ(connection.read().result_int(), 200);
+
+  std::this_thread::sleep_for(400ms);
+  EXPECT_TRUE(connection.closed_by_peer());
+}
+
+class Http1ServerReusePortTest : public Http1ServerTest {
+protected:
+  astra::http1::Server::Options options() const override {
+    return {4, astra::http1::Server::AcceptMode::ReusePort};
+  }
+};
+
+TEST_F(Http1ServerReusePortTest, BasicRequests) {
+  auto res = send_request(m_port, "GET", "/test");
+  EXPECT_THAT(res, HasSubstr("200 OK"));
+
+  res = send_request(m_port, "POST", "/echo", "body");
+  EXPECT_THAT(res, HasSubstr("200 OK"));
+}
+
+TEST_F(Http1ServerReusePortTest, ConcurrentRequestsAcrossLoops) {
+  int num_threads = 20;
+  std::vector<std::thread> threads;
+  std::atomic<int> success_count{0};
+
+  for (int i = 0; i < num_threads; ++i) {
+    threads.emplace_back([this, &success_count] {
+      for (int j = 0; j < 10; ++j) {
+        auto res = send_request(m_port, "GET", "/test");
+        if (res.find("200 OK") != std::string::npos) {
+          success_count++;
+        }
+      }
+    });
+  }
+
+  for (auto &t : threads) {
+    t.join();
+  }
+
+  EXPECT_EQ(success_count, num_threads * 10);
+}
+
+TEST(Http1ServerReusePort, CpuAffinityStillServes) {
+  astra::http1::Server::Options options{
+      2, astra::http1::Server::AcceptMode::ReusePort, true};
+  astra::http1::Server server("127.0.0.1", 0, options);
+  int port = server.port();
+  server.handle(
+      [](const astra::router::IRequest &, astra::router::IResponse &res) {
+        res.set_status(200);
+        res.close();
+      });
+  std::thread runner([&server] {
+    server.run();
+  });
+  std::this_thread::sleep_for(100ms);
+
+  // Steering may be refused (old kernel, no privileges); either way every
+  // connection must still land on a loop that accepts it
+  for (int i = 0; i < 20; ++i) {
+    EXPECT_THAT(send_request(port, "GET", "/"), HasSubstr("200 OK"));
+  }
+
+  server.stop();
+  runner.join();
+}
+
+// Routes served through the router, with offloaded handlers run on threads
+// of their own after a delay, as an executor lane would
+class Http1ServerOffloadTest : public Test {
+protected:
+  void SetUp() override {
+    using astra::router::Execution;
+    using astra::router::RouteOptions;
+    RouteOptions offload;
+    offload.execution = Execution::Offload;
+
+    server_ = std::make_unique<astra::http1::Server>("127.0.0.1", 0);
+    m_port = server_->port();
+    auto &router = server_->router();
+    router.set_offload([this](const std::shared_ptr<astra::router::IRequest> &,
+                              std::function<void()> work) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_workers.emplace_back([work = std::move(work)] {
+        std::this_thread::sleep_for(100ms);
+        work();
+      });
+    });
+    router.get(
+        "/slow",
+        [](auto, std::shared_ptr<astra::router::IResponse> res) {
+          res->set_status(200);
+          res->write("slow");
+          res->close();
+        },
+        offload);
+    router.get("/fast",
+               [](auto, std::shared_ptr<astra::router::IResponse> res) {
+                 res->set_status(200);
+                 res->write("fast");
+                 res->close();
+               });
+    router.get("/dropped", [](auto, auto) {}, offload);
+
+    server_thread_ = std::thread([this] {
+      server_->run();
+    });
+    std::this_thread::sleep_for(100ms);
+  }
+
+  void TearDown() override {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      for (auto &worker : m_workers) {
+        worker.join();
+      }
+    }
+    server_->stop();
+    server_thread_.join();
+  }
+
+  int m_port;
+  std::unique_ptr<astra::http1::Server> server_;
+  std::thread server_thread_;
+  std::mutex m_mutex;
+  std::vector<std::thread> m_workers;
+};
+
+TEST_F(Http1ServerOffloadTest, OffloadedRouteAnswersAfterDispatchReturns) {
+  Connection connection(m_port);
+  connection.send("GET", "/slow");
+
+  auto res = connection.read();
+  EXPECT_EQ(res.result_int(), 200);
+  EXPECT_EQ(res.body(), "slow");
+  EXPECT_TRUE(res.keep_alive());
+}
+
+TEST_F(Http1ServerOffloadTest, PipelinedResponsesKeepRequestOrder) {
+  Connection connection(m_port);
+  connection.send("GET", "/slow");
+  connection.send("GET", "/fast");
+
+  // /fast is answered first but must wait its turn behind /slow
+  auto first = connection.read();
+  auto second = connection.read();
+  EXPECT_EQ(first.body(), "slow");
+  EXPECT_EQ(second.body(), "fast");
+}
+
+TEST_F(Http1ServerOffloadTest, DroppedResponseGets500AndConnectionSurvives) {
+  Connection connection(m_port);
+  connection.send("GET", "/dropped");
+  EXPECT_EQ(connection.read().result_int(), 500);
+
+  connection.send("GET", "/fast");
+  EXPECT_EQ(connection.read().body(), "fast");
+}
@@ -3,6 +3,7 @@
 #include "NgHttp2Client.h"
 
 #include <boost/asio.hpp>
+#include <chrono>
 #include <memory>
 #include <thread>
 #include <unordered_map>
@@ -17,10 +18,13 @@ public:
   ClientDispatcher(const ClientDispatcher &) = delete;
   ClientDispatcher &operator=(const ClientDispatcher &) = delete;
 
-  void submit(const std::string &host, uint16_t port, const std::string &method,
-              const std::string &path, const std::string &body,
-              const std::map<std::string, std::string> &headers,
-              ResponseHandler handler);
+  RequestHandlePtr submit(const std::string &host, uint16_t port,
+                          const std::string &method, const std::string &path,
+                          const std::string &body,
+                          const astra::utils::HeaderBlock &headers,
+                          ResponseHandler handler);
+
+  void schedule(std::chrono::milliseconds delay, std::function<void()> task);
 
 private:
   NgHttp2Client *get_or_create(const std::string &host, uint16_t port);
@@ -2,11 +2,13 @@
 
 #include "Http2ClientError.h"
 #include "Http2ClientResponse.h"
+#include "RequestHandle.h"
 #include "http2client.pb.h"
 
+#include <HeaderBlock.h>
 #include <Result.h>
+#include <chrono>
 #include <functional>
-#include <map>
 #include <memory>
 #include <string>
 
@@ -23,10 +25,16 @@ public:
   Http2Client(const Http2Client &) = delete;
   Http2Client &operator=(const Http2Client &) = delete;
 
-  void submit(const std::string &host, uint16_t port, const std::string &method,
-              const std::string &path, const std::string &body,
-              const std::map<std::string, std::string> &headers,
-              ResponseHandler handler);
+  /// The handler is invoked exactly once. The returned handle may be used
+  /// to cancel the request; callers that never cancel can ignore it.
+  RequestHandlePtr submit(const std::string &host, uint16_t port,
+                          const std::string &method, const std::string &path,
+                          const std::string &body,
+                          const astra::utils::HeaderBlock &headers,
+                          ResponseHandler handler);
+
+  /// Run a task on the client's dispatcher thread after a delay
+  void schedule(std::chrono::milliseconds delay, std::function<void()> task);
 
 private:
   class Impl;
@@ -7,7 +7,8 @@ enum class Http2ClientError {
   RequestTimeout,
   StreamClosed,
   NotConnected,
-  SubmitFailed
+  SubmitFailed,
+  Cancelled
 };
 
 } // namespace astra::http2
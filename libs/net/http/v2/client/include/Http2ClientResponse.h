@@ -1,6 +1,6 @@
 #pragma once
 
-#include <map>
+#include <HeaderBlock.h>
 #include <string>
 
 namespace astra::http2 {
@@ -9,7 +9,7 @@ class Http2ClientResponse {
 public:
   Http2ClientResponse() = default;
   Http2ClientResponse(int status_code, std::string body,
-                      std::map<std::string, std::string> headers);
+                      astra::utils::HeaderBlock headers);
 
   [[nodiscard]] int status_code() const {
     return m_status_code;
@@ -18,14 +18,14 @@ public:
     return m_body;
   }
   [[nodiscard]] std::string header(const std::string &name) const;
-  [[nodiscard]] const std::map<std::string, std::string> &headers() const {
+  [[nodiscard]] const astra::utils::HeaderBlock &headers() const {
     return m_headers;
   }
 
 private:
   int m_status_code = 0;
   std::string m_body;
-  std::map<std::string, std::string> m_headers;
+  astra::utils::HeaderBlock m_headers;
 };
 
 } // namespace astra::http2
@@ -2,17 +2,22 @@
 
 #include "Http2ClientError.h"
 #include "Http2ClientResponse.h"
+#include "RequestHandle.h"
 #include "http2client.pb.h"
 
+#include <Deadline.h>
+#include <HeaderBlock.h>
 #include <Log.h>
 #include <Result.h>
 #include <atomic>
 #include <boost/asio.hpp>
+#include <boost/asio/ssl/context.hpp>
 #include <functional>
 #include <mutex>
 #include <nghttp2/asio_http2_client.h>
 #include <queue>
 #include <thread>
+#include <vector>
 
 namespace astra::http2 {
 
@@ -27,8 +32,10 @@ struct PendingRequest {
   std::string method;
   std::string path;
   std::string body;
-  std::map<std::string, std::string> headers;
+  astra::utils::HeaderBlock headers;
   ResponseHandler handler;
+  RequestHandlePtr handle;
+  astra::utils::Deadline deadline;
 };
 
 class NgHttp2Client {
@@ -41,10 +48,11 @@ public:
   NgHttp2Client(const NgHttp2Client &) = delete;
   NgHttp2Client &operator=(const NgHttp2Client &) = delete;
 
+  /// A grpc-timeout header caps the request timeout; it is rewritten to
+  /// the budget left when the request actually goes on the wire.
   void submit(const std::string &method, const std::string &path,
-              const std::string &body,
-              const std::map<std::string, std::string> &headers,
-              ResponseHandler handler);
+              const std::string &body, const astra::utils::HeaderBlock &headers,
+              ResponseHandler handler, RequestHandlePtr handle = nullptr);
 
   bool is_connected() const;
   ConnectionState state() const;
@@ -56,8 +64,10 @@ private:
   void stop_io_thread();
   void do_submit(const std::string &method, const std::string &path,
                  const std::string &body,
-                 const std::map<std::string, std::string> &headers,
-                 ResponseHandler handler);
+                 const astra::utils::HeaderBlock &headers,
+                 ResponseHandler handler, RequestHandlePtr handle,
+                 astra::utils::Deadline deadline);
+  void track(const RequestHandlePtr &handle);
   void flush_pending_requests();
 
   std::string m_host;
@@ -72,10 +82,17 @@ private:
       m_work;
   std::thread m_io_thread;
 
+  // Kept across reconnects so each new session can resume the last one.
+  // Null when TLS is off or the context could not be set up.
+  std::unique_ptr<boost::asio::ssl::context> m_tls;
   std::unique_ptr<nghttp2::asio_http2::client::session> m_session;
   std::atomic<ConnectionState> m_state{ConnectionState::DISCONNECTED};
   std::mutex m_connect_mutex;
   std::queue<PendingRequest> m_pending_requests;
+
+  // Handles with a live canceller; detached before the io_context dies.
+  // Only touched on the io thread, or after it has been joined.
+  std::vector<std::weak_ptr<RequestHandle>> m_handles;
 };
 
 } // namespace astra::http2
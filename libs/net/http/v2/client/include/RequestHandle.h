@@ -0,0 +1,53 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace astra::http2 {
+
+/// Caller-side handle for one submitted request.
+///
+/// cancel() may be called from any thread. A request cancelled before it
+/// is sent fails with Http2ClientError::Cancelled without touching the
+/// network; an in-flight one has its stream reset with NGHTTP2_CANCEL and
+/// its handler is invoked with Cancelled, unless a response already won.
+class RequestHandle {
+public:
+  void cancel() {
+    m_cancelled.store(true, std::memory_order_release);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_canceller) {
+      auto canceller = std::move(m_canceller);
+      m_canceller = nullptr;
+      canceller();
+    }
+  }
+
+  [[nodiscard]] bool cancelled() const noexcept {
+    return m_cancelled.load(std::memory_order_acquire);
+  }
+
+  /// Called by the client once the stream exists; the canceller must only
+  /// post work to the connection's io thread.
+  void attach(std::function<void()> canceller) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_canceller = std::move(canceller);
+  }
+
+  /// Called by the client when the stream closes or the connection dies
+  void detach() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_canceller = nullptr;
+  }
+
+private:
+  std::atomic<bool> m_cancelled{false};
+  std::mutex m_mutex;
+  std::function<void()> m_canceller;
+};
+
+using RequestHandlePtr = std::shared_ptr<RequestHandle>;
+
+} // namespace astra::http2
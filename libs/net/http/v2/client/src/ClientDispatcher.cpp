@@ -26,15 +26,29 @@ ClientDispatcher::~ClientDispatcher() {
   }
 }
 
-void ClientDispatcher::submit(const std::string &host, uint16_t port,
-                              const std::string &method,
-                              const std::string &path, const std::string &body,
-                              const std::map<std::string, std::string> &headers,
-                              ResponseHandler handler) {
+RequestHandlePtr
+ClientDispatcher::submit(const std::string &host, uint16_t port,
+                         const std::string &method, const std::string &path,
+                         const std::string &body,
+                         const astra::utils::HeaderBlock &headers,
+                         ResponseHandler handler) {
+  auto handle = std::make_shared<RequestHandle>();
   boost::asio::post(m_io, [=]() {
     auto *client = get_or_create(host, port);
-    client->submit(method, path, body, headers, handler);
+    client->submit(method, path, body, headers, handler, handle);
   });
+  return handle;
+}
+
+void ClientDispatcher::schedule(std::chrono::milliseconds delay,
+                                std::function<void()> task) {
+  auto timer = std::make_shared<boost::asio::steady_timer>(m_io, delay);
+  timer->async_wait(
+      [timer, task = std::move(task)](const boost::system::error_code &ec) {
+        if (!ec) {
+          task();
+        }
+      });
 }
 
 NgHttp2Client *ClientDispatcher::get_or_create(const std::string &host,
@@ -9,11 +9,17 @@ public:
   explicit Impl(const ClientConfig &config) : m_dispatcher(config) {
   }
 
-  void submit(const std::string &host, uint16_t port, const std::string &method,
-              const std::string &path, const std::string &body,
-              const std::map<std::string, std::string> &headers,
-              ResponseHandler handler) {
-    m_dispatcher.submit(host, port, method, path, body, headers, handler);
+  RequestHandlePtr submit(const std::string &host, uint16_t port,
+                          const std::string &method, const std::string &path,
+                          const std::string &body,
+                          const astra::utils::HeaderBlock &headers,
+                          ResponseHandler handler) {
+    return m_dispatcher.submit(host, port, method, path, body, headers,
+                               handler);
+  }
+
+  void schedule(std::chrono::milliseconds delay, std::function<void()> task) {
+    m_dispatcher.schedule(delay, std::move(task));
   }
 
 private:
@@ -26,12 +32,18 @@ Http2Client::Http2Client(const ClientConfig &config)
 
 Http2Client::~Http2Client() = default;
 
-void Http2Client::submit(const std::string &host, uint16_t port,
-                         const std::string &method, const std::string &path,
-                         const std::string &body,
-                         const std::map<std::string, std::string> &headers,
-                         ResponseHandler handler) {
-  m_impl->submit(host, port, method, path, body, headers, handler);
+RequestHandlePtr
+Http2Client::submit(const std::string &host, uint16_t port,
+                    const std::string &method, const std::string &path,
+                    const std::string &body,
+                    const astra::utils::HeaderBlock &headers,
+                    ResponseHandler handler) {
+  return m_impl->submit(host, port, method, path, body, headers, handler);
+}
+
+void Http2Client::schedule(std::chrono::milliseconds delay,
+                           std::function<void()> task) {
+  m_impl->schedule(delay, std::move(task));
 }
 
 } // namespace astra::http2
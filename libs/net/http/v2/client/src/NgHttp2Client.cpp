@@ -2,8 +2,11 @@
 
 #include "Http2ClientResponse.h"
 
+#include <TlsContext.h>
+#include <algorithm>
 #include <boost/asio/deadline_timer.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
+#include <stdexcept>
 
 namespace astra::http2 {
 
@@ -13,9 +16,44 @@ struct ResponseStream {
   bool completed = false;
   int status_code = 0;
   std::string body;
-  std::map<std::string, std::string> headers;
+  astra::utils::HeaderBlock headers;
 };
 
+astra::utils::Deadline
+deadline_from(const astra::utils::HeaderBlock &headers) {
+  auto it = headers.find(astra::utils::Deadline::kHeader);
+  if (it == headers.end()) {
+    return {};
+  }
+  auto budget = astra::utils::Deadline::parse_grpc_timeout(it->second);
+  return budget ? astra::utils::Deadline::after(*budget)
+                : astra::utils::Deadline{};
+}
+
+std::unique_ptr<boost::asio::ssl::context>
+make_tls_context(const std::string &host, const ClientTlsConfig &config) {
+  astra::tls::ClientOptions options;
+  options.ca_file = config.ca_file();
+  options.verify_peer = !config.insecure_skip_verify();
+  options.server_name =
+      config.server_name().empty() ? host : config.server_name();
+  options.ciphers = config.ciphers();
+  options.ciphersuites = config.ciphersuites();
+  options.session_resumption = !config.disable_session_resumption();
+  options.ktls = config.ktls();
+
+  auto context = std::make_unique<boost::asio::ssl::context>(
+      boost::asio::ssl::context::tls_client);
+  auto configured = astra::tls::configure_client(*context, options);
+  if (configured.is_err()) {
+    obs::error("Client TLS setup failed",
+               {{"host", host},
+                {"error", astra::tls::to_string(configured.error())}});
+    return nullptr;
+  }
+  return context;
+}
+
 } // namespace
 
 NgHttp2Client::NgHttp2Client(const std::string &host, uint16_t port,
@@ -23,6 +61,9 @@ NgHttp2Client::NgHttp2Client(const std::string &host, uint16_t port,
                              OnCloseCallback on_close, OnErrorCallback on_error)
     : m_host(host), m_port(port), m_config(config),
       m_on_close(std::move(on_close)), m_on_error(std::move(on_error)) {
+  if (m_config.tls().enabled()) {
+    m_tls = make_tls_context(m_host, m_config.tls());
+  }
   start_io_thread();
 }
 
@@ -65,6 +106,14 @@ void NgHttp2Client::stop_io_thread() {
     m_io_thread.join();
   }
 
+  // Cancellers post to m_io_context, which is about to go away
+  for (const auto &weak : m_handles) {
+    if (auto handle = weak.lock()) {
+      handle->detach();
+    }
+  }
+  m_handles.clear();
+
   // Now safe to destroy the session - io_thread has exited, no callbacks
   // running
   m_session.reset();
@@ -96,8 +145,15 @@ void NgHttp2Client::connect() {
       boost::system::error_code ec;
       std::string port_str = std::to_string(m_port);
 
-      m_session = std::make_unique<nghttp2::asio_http2::client::session>(
-          m_io_context, m_host, port_str);
+      if (!m_config.tls().enabled()) {
+        m_session = std::make_unique<nghttp2::asio_http2::client::session>(
+            m_io_context, m_host, port_str);
+      } else if (m_tls) {
+        m_session = std::make_unique<nghttp2::asio_http2::client::session>(
+            m_io_context, *m_tls, m_host, port_str);
+      } else {
+        throw std::runtime_error("no usable TLS context for " + m_host);
+      }
 
       // Create connect timeout timer
       uint32_t timeout_ms = m_config.connect_timeout_ms() > 0
@@ -209,9 +265,10 @@ ConnectionState NgHttp2Client::state() const {
 
 void NgHttp2Client::submit(const std::string &method, const std::string &path,
                            const std::string &body,
-                           const std::map<std::string, std::string> &headers,
-                           ResponseHandler handler) {
+                           const astra::utils::HeaderBlock &headers,
+                           ResponseHandler handler, RequestHandlePtr handle) {
   ConnectionState current = m_state.load(std::memory_order_acquire);
+  auto deadline = deadline_from(headers);
 
   if (current == ConnectionState::FAILED) {
     obs::debug("submit: returning error - state is FAILED");
@@ -221,13 +278,15 @@ void NgHttp2Client::submit(const std::string &method, const std::string &path,
   }
 
   if (current == ConnectionState::CONNECTED) {
-    do_submit(method, path, body, headers, handler);
+    do_submit(method, path, body, headers, handler, std::move(handle),
+              deadline);
     return;
   }
 
   {
     std::lock_guard<std::mutex> lock(m_connect_mutex);
-    m_pending_requests.push({method, path, body, headers, handler});
+    m_pending_requests.push(
+        {method, path, body, headers, handler, std::move(handle), deadline});
   }
 
   ensure_connected();
@@ -238,16 +297,33 @@ void NgHttp2Client::flush_pending_requests() {
   while (!m_pending_requests.empty()) {
     auto req = std::move(m_pending_requests.front());
     m_pending_requests.pop();
-    do_submit(req.method, req.path, req.body, req.headers, req.handler);
+    do_submit(req.method, req.path, req.body, req.headers, req.handler,
+              std::move(req.handle), req.deadline);
   }
 }
 
 void NgHttp2Client::do_submit(const std::string &method,
                               const std::string &path, const std::string &body,
-                              const std::map<std::string, std::string> &headers,
-                              ResponseHandler handler) {
-  boost::asio::post(m_io_context, [this, method, path, body, headers,
-                                   handler]() {
+                              const astra::utils::HeaderBlock &headers,
+                              ResponseHandler handler, RequestHandlePtr handle,
+                              astra::utils::Deadline deadline) {
+  boost::asio::post(m_io_context, [this, method, path, body, headers, handler,
+                                   handle, deadline]() {
+    if (handle && handle->cancelled()) {
+      handler(
+          astra::outcome::Result<Http2ClientResponse, Http2ClientError>::Err(
+              Http2ClientError::Cancelled));
+      return;
+    }
+
+    // Nobody is waiting for the answer any more
+    if (deadline.expired()) {
+      handler(
+          astra::outcome::Result<Http2ClientResponse, Http2ClientError>::Err(
+              Http2ClientError::RequestTimeout));
+      return;
+    }
+
     if (m_state.load(std::memory_order_acquire) != ConnectionState::CONNECTED) {
       obs::debug("do_submit: returning error - not connected");
       handler(
@@ -260,11 +336,21 @@ void NgHttp2Client::do_submit(const std::string &method,
 
     nghttp2::asio_http2::header_map ng_headers;
     for (const auto &kv : headers) {
+      if (deadline.is_set() && kv.first == astra::utils::Deadline::kHeader) {
+        continue;
+      }
       ng_headers.emplace(kv.first,
                          nghttp2::asio_http2::header_value{kv.second, false});
     }
+    if (deadline.is_set()) {
+      ng_headers.emplace(
+          astra::utils::Deadline::kHeader,
+          nghttp2::asio_http2::header_value{deadline.to_grpc_timeout(), false});
+    }
 
-    std::string uri = "http://" + m_host + ":" + std::to_string(m_port) + path;
+    // nghttp2 takes :scheme from the URI, so it must match the transport
+    std::string uri = (m_config.tls().enabled() ? "https://" : "http://") +
+                      m_host + ":" + std::to_string(m_port) + path;
 
     if (!m_session) {
       obs::debug("do_submit: m_session is nullptr!");
@@ -303,18 +389,41 @@ void NgHttp2Client::do_submit(const std::string &method,
       return;
     }
 
-    uint32_t timeout_ms = m_config.request_timeout_ms() > 0
-                              ? m_config.request_timeout_ms()
-                              : 10000;
+    int64_t timeout_ms = m_config.request_timeout_ms() > 0
+                             ? m_config.request_timeout_ms()
+                             : 10000;
+    if (deadline.is_set()) {
+      timeout_ms = std::min<int64_t>(timeout_ms, deadline.remaining().count());
+    }
     auto timer = std::make_shared<boost::asio::deadline_timer>(m_io_context);
     timer->expires_from_now(boost::posix_time::milliseconds(timeout_ms));
 
     auto stream = std::make_shared<ResponseStream>();
 
-    timer->async_wait([req, stream,
-                       handler](const boost::system::error_code &ec) {
+    if (handle) {
+      track(handle);
+      handle->attach([this, req, stream, timer, handler]() {
+        boost::asio::post(m_io_context, [req, stream, timer, handler]() {
+          if (stream->completed) {
+            return;
+          }
+          stream->completed = true;
+          timer->cancel();
+          req->cancel(NGHTTP2_CANCEL);
+          handler(astra::outcome::Result<Http2ClientResponse,
+                                         Http2ClientError>::
+                      Err(Http2ClientError::Cancelled));
+        });
+      });
+    }
+
+    timer->async_wait([req, stream, handler,
+                       handle](const boost::system::error_code &ec) {
       if (!ec && !stream->completed) {
         stream->completed = true;
+        if (handle) {
+          handle->detach();
+        }
         req->cancel(NGHTTP2_CANCEL);
         handler(
             astra::outcome::Result<Http2ClientResponse, Http2ClientError>::Err(
@@ -326,9 +435,7 @@ void NgHttp2Client::do_submit(const std::string &method,
         [stream](const nghttp2::asio_http2::client::response &res) {
           stream->status_code = res.status_code();
 
-          for (const auto &kv : res.header()) {
-            stream->headers[kv.first] = kv.second.value;
-          }
+          stream->headers = astra::utils::HeaderView(res.header()).to_block();
 
           res.on_data([stream](const uint8_t *data, std::size_t len) {
             if (len > 0) {
@@ -337,7 +444,10 @@ void NgHttp2Client::do_submit(const std::string &method,
           });
         });
 
-    req->on_close([stream, timer, handler](uint32_t error_code) {
+    req->on_close([stream, timer, handler, handle](uint32_t error_code) {
+      if (handle) {
+        handle->detach();
+      }
       if (stream->completed) {
         return;
       }
@@ -362,4 +472,16 @@ void NgHttp2Client::do_submit(const std::string &method,
   });
 }
 
+void NgHttp2Client::track(const RequestHandlePtr &handle) {
+  // Prune handles whose callers have let go, amortised over submits
+  if (m_handles.size() >= 64 && m_handles.size() % 64 == 0) {
+    m_handles.erase(std::remove_if(m_handles.begin(), m_handles.end(),
+                                   [](const auto &weak) {
+                                     return weak.expired();
+                                   }),
+                    m_handles.end());
+  }
+  m_handles.push_back(handle);
+}
+
 } // namespace astra::http2
@@ -72,7 +72,7 @@ static void BM_SubmitWithHeaders(benchmark::State &state) {
   config.set_request_timeout_ms(100);
   Http2Client client(config);
 
-  std::map<std::string, std::string> headers;
+  astra::utils::HeaderBlock headers;
   headers["Content-Type"] = "application/json";
   headers["Authorization"] = "Bearer token123";
   headers["X-Request-Id"] = "request-id-12345";
@@ -115,7 +115,7 @@ BENCHMARK(BM_SubmitLargeBody)->Range(1024, 65536);
 // =============================================================================
 
 static void BM_ResponseConstruction(benchmark::State &state) {
-  std::map<std::string, std::string> headers;
+  astra::utils::HeaderBlock headers;
   headers["content-type"] = "application/json";
   headers["x-request-id"] = "12345";
 
@@ -127,7 +127,7 @@ static void BM_ResponseConstruction(benchmark::State &state) {
 BENCHMARK(BM_ResponseConstruction);
 
 static void BM_ResponseHeaderLookup(benchmark::State &state) {
-  std::map<std::string, std::string> headers;
+  astra::utils::HeaderBlock headers;
   for (int i = 0; i < 20; ++i) {
     headers["header-" + std::to_string(i)] = "value-" + std::to_string(i);
   }
@@ -61,7 +61,7 @@ void SubmitWithHeadersNeverCrashes(const std::string &headerKey,
     Http2Client client(config);
     std::atomic<bool> done{false};
 
-    std::map<std::string, std::string> headers;
+    astra::utils::HeaderBlock headers;
     headers[headerKey] = headerValue;
 
     client.submit("127.0.0.1", 19999, "GET", "/test", "", headers,
@@ -83,7 +83,7 @@ void ResponseConstructionNeverCrashes(int status_code, const std::string &body,
                                       const std::string &headerKey,
                                       const std::string &headerValue) {
   try {
-    std::map<std::string, std::string> headers;
+    astra::utils::HeaderBlock headers;
     if (!headerKey.empty()) {
       headers[headerKey] = headerValue;
     }
@@ -104,7 +104,7 @@ FUZZ_TEST(Http2ClientFuzzTest, ResponseConstructionNeverCrashes);
 
 // Fuzz header lookup
 void HeaderLookupNeverCrashes(const std::string &lookupKey) {
-  std::map<std::string, std::string> headers;
+  astra::utils::HeaderBlock headers;
   headers["content-type"] = "application/json";
   headers["x-request-id"] = "12345";
 
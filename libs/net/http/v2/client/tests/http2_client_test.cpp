@@ -4,9 +4,19 @@
 #include "Http2ClientResponse.h"
 #include "NgHttp2Client.h"
 
+#include <TlsContext.h>
 #include <atomic>
+#include <boost/asio/ssl.hpp>
 #include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <future>
 #include <gtest/gtest.h>
+#include <mutex>
+#include <nghttp2/asio_http2_server.h>
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/x509.h>
 #include <thread>
 #include <vector>
 
@@ -48,7 +58,7 @@ TEST_F(Http2ClientTest, SubmitPostWithBody) {
   std::atomic<bool> done{false};
 
   std::string body = R"({"key": "value"})";
-  std::map<std::string, std::string> headers;
+  astra::utils::HeaderBlock headers;
   headers["Content-Type"] = "application/json";
 
   client.submit("127.0.0.1", 19999, "POST", "/api/data", body, headers,
@@ -192,7 +202,7 @@ TEST_F(Http2ClientTest, SubmitWithCustomHeaders) {
   Http2Client client(m_config);
   std::atomic<bool> done{false};
 
-  std::map<std::string, std::string> headers;
+  astra::utils::HeaderBlock headers;
   headers["Authorization"] = "Bearer token123";
   headers["X-Request-Id"] = "req-456";
   headers["X-Trace-Id"] = "trace-789";
@@ -299,7 +309,7 @@ TEST_F(Http2ClientResponseTest, DefaultConstructorCreatesEmptyResponse) {
 }
 
 TEST_F(Http2ClientResponseTest, ParameterizedConstructorSetsValues) {
-  std::map<std::string, std::string> headers;
+  astra::utils::HeaderBlock headers;
   headers["content-type"] = "application/json";
 
   Http2ClientResponse response(200, "test body", headers);
@@ -310,7 +320,7 @@ TEST_F(Http2ClientResponseTest, ParameterizedConstructorSetsValues) {
 }
 
 TEST_F(Http2ClientResponseTest, HeaderReturnsValueWhenExists) {
-  std::map<std::string, std::string> headers;
+  astra::utils::HeaderBlock headers;
   headers["content-type"] = "application/json";
 
   Http2ClientResponse response(200, "", headers);
@@ -494,5 +504,144 @@ TEST_F(ClientDispatcherTest, DestructorWaitsForPendingRequests) {
   }
 }
 
+// =============================================================================
+// Scheme Tests
+// =============================================================================
+
+// Self-signed P-256 certificate for "localhost", written to the temp dir
+struct SelfSigned {
+  std::string cert_file;
+  std::string key_file;
+
+  SelfSigned() {
+    auto dir = std::filesystem::temp_directory_path();
+    cert_file = (dir / "astra_http2_client_test_cert.pem").string();
+    key_file = (dir / "astra_http2_client_test_key.pem").string();
+
+    EVP_PKEY *key = EVP_EC_gen("P-256");
+    X509 *cert = X509_new();
+    ASN1_INTEGER_set(X509_get_serialNumber(cert), 1);
+    X509_gmtime_adj(X509_getm_notBefore(cert), 0);
+    X509_gmtime_adj(X509_getm_notAfter(cert), 3600);
+    X509_set_pubkey(cert, key);
+    X509_NAME *name = X509_get_subject_name(cert);
+    X509_NAME_add_entry_by_txt(
+        name, "CN", MBSTRING_ASC,
+        reinterpret_cast<const unsigned char *>("localhost"), -1, -1, 0);
+    X509_set_issuer_name(cert, name);
+    X509_sign(cert, key, EVP_sha256());
+
+    FILE *out = std::fopen(cert_file.c_str(), "w");
+    PEM_write_X509(out, cert);
+    std::fclose(out);
+    out = std::fopen(key_file.c_str(), "w");
+    PEM_write_PrivateKey(out, key, nullptr, nullptr, 0, nullptr, nullptr);
+    std::fclose(out);
+
+    X509_free(cert);
+    EVP_PKEY_free(key);
+  }
+
+  ~SelfSigned() {
+    std::remove(cert_file.c_str());
+    std::remove(key_file.c_str());
+  }
+};
+
+// Loopback h2 server that reports the :scheme of each request it receives
+class SchemeRecorder {
+public:
+  // Plain h2c unless a TLS context is given
+  explicit SchemeRecorder(boost::asio::ssl::context *tls = nullptr) {
+    m_server.num_threads(1);
+    m_server.handle("/", [this](const nghttp2::asio_http2::server::request &req,
+                                const nghttp2::asio_http2::server::response
+                                    &res) {
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_schemes.push_back(req.uri().scheme);
+      }
+      res.write_head(200);
+      res.end();
+    });
+
+    boost::system::error_code ec;
+    if (tls) {
+      m_server.listen_and_serve(ec, *tls, "127.0.0.1", "0", true);
+    } else {
+      m_server.listen_and_serve(ec, "127.0.0.1", "0", true);
+    }
+    if (ec) {
+      throw std::runtime_error("listen failed: " + ec.message());
+    }
+  }
+
+  ~SchemeRecorder() {
+    m_server.stop();
+    m_server.join();
+  }
+
+  [[nodiscard]] uint16_t port() const {
+    return static_cast<uint16_t>(m_server.ports().front());
+  }
+
+  [[nodiscard]] std::vector<std::string> schemes() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_schemes;
+  }
+
+private:
+  nghttp2::asio_http2::server::http2 m_server;
+  mutable std::mutex m_mutex;
+  std::vector<std::string> m_schemes;
+};
+
+// Status of one GET through the client, or -1 on a client error
+int get_status(Http2Client &client, uint16_t port) {
+  std::promise<int> status;
+  client.submit("127.0.0.1", port, "GET", "/scheme", "", {},
+                [&status](auto result) {
+                  status.set_value(result.is_ok() ? result.value().status_code()
+                                                  : -1);
+                });
+  auto future = status.get_future();
+  if (future.wait_for(std::chrono::seconds(2)) != std::future_status::ready) {
+    return 0;
+  }
+  return future.get();
+}
+
+TEST(Http2ClientSchemeTest, PlainConnectionSendsHttpScheme) {
+  SchemeRecorder server;
+  ClientConfig config;
+  config.set_connect_timeout_ms(1000);
+  config.set_request_timeout_ms(1000);
+  Http2Client client(config);
+
+  EXPECT_EQ(get_status(client, server.port()), 200);
+  EXPECT_EQ(server.schemes(), std::vector<std::string>{"http"});
+}
+
+TEST(Http2ClientSchemeTest, TlsConnectionSendsHttpsScheme) {
+  SelfSigned cert;
+  boost::asio::ssl::context tls(boost::asio::ssl::context::tls_server);
+  astra::tls::ServerOptions options;
+  options.cert_file = cert.cert_file;
+  options.key_file = cert.key_file;
+  ASSERT_TRUE(astra::tls::configure_server(tls, options).is_ok());
+  SchemeRecorder server(&tls);
+
+  ClientConfig config;
+  config.set_connect_timeout_ms(1000);
+  config.set_request_timeout_ms(1000);
+  config.mutable_tls()->set_enabled(true);
+  config.mutable_tls()->set_ca_file(cert.cert_file);
+  config.mutable_tls()->set_server_name("localhost");
+  Http2Client client(config);
+
+  EXPECT_EQ(get_status(client, server.port()), 200);
+  EXPECT_EQ(server.schemes(), std::vector<std::string>{"https"});
+}
+
 } // namespace test
 } // namespace astra::http2
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+namespace astra::http2 {
+
+// Tracks open streams per connection so the server can cap both. A
+// connection counts as active from its first admitted stream until its
+// last one closes. nghttp2-asio exposes no accept or connection hook, so
+// stream-less connections are not counted here; the server's read timeout
+// closes those instead. Excess active connections are turned away one
+// stream at a time with REFUSED_STREAM, which clients may retry elsewhere.
+// A limit of 0 means unlimited. Once closed it admits nothing, which is
+// how the server drains: refuse new streams, wait out the open ones.
+//
+// Per-connection counts live in shards picked by connection id, and the
+// totals are atomics, so io threads only contend when their connections
+// hash to the same shard.
+class ConnectionLimiter {
+public:
+  using ConnectionId = uint64_t;
+
+  static constexpr size_t kShards = 16;
+
+  enum class Admission { Admitted, ConnectionLimit, StreamLimit, Closed };
+
+  ConnectionLimiter(size_t max_connections, size_t max_streams_per_connection)
+      : m_max_connections(max_connections),
+        m_max_streams(max_streams_per_connection) {
+  }
+
+  Admission admit(ConnectionId connection);
+  // Pairs with an Admitted result only; returns the connection's streams
+  // still open, so 0 means its last one just closed
+  size_t release(ConnectionId connection);
+
+  void close();
+  // True once every admitted stream is released; false on the deadline
+  bool wait_idle(std::chrono::steady_clock::time_point deadline);
+
+  [[nodiscard]] size_t connections() const;
+  [[nodiscard]] size_t streams() const;
+  [[nodiscard]] size_t streams(ConnectionId connection) const;
+
+private:
+  struct alignas(64) Shard {
+    mutable std::mutex mutex;
+    std::unordered_map<ConnectionId, size_t> streams;
+  };
+
+  Shard &shard_of(ConnectionId connection) const;
+  bool reserve_connection();
+  void drop_stream();
+
+  const size_t m_max_connections;
+  const size_t m_max_streams;
+
+  mutable std::array<Shard, kShards> m_shards;
+  std::atomic<size_t> m_connections{0};
+  std::atomic<size_t> m_total{0};
+  std::atomic<bool> m_closed{false};
+
+  // Only taken to wake wait_idle when the last stream goes
+  std::mutex m_idle_mutex;
+  std::condition_variable m_idle;
+};
+
+} // namespace astra::http2
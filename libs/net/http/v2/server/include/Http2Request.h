@@ -1,8 +1,11 @@
 #pragma once
 
 #include "IRequest.h"
+#include "RequestBody.h"
 
-#include <map>
+#include <HeaderBlock.h>
+
+#include <optional>
 #include <string>
 #include <unordered_map>
 
@@ -12,7 +15,7 @@ class Http2Request final : public astra::router::IRequest {
 public:
   Http2Request() = default;
   Http2Request(std::string method, std::string path,
-               std::map<std::string, std::string> headers = {},
+               astra::utils::HeaderBlock headers = {},
                std::string body = {},
                std::unordered_map<std::string, std::string> query_params = {});
 
@@ -21,12 +24,25 @@ public:
   Http2Request(Http2Request &&) noexcept = default;
   Http2Request &operator=(Http2Request &&) noexcept = default;
 
+  Http2Request(std::string method, std::string path,
+               astra::utils::HeaderBlock headers,
+               astra::router::RequestBody body,
+               std::unordered_map<std::string, std::string> query_params = {});
+
   ~Http2Request() override = default;
 
   [[nodiscard]] const std::string &method() const override;
   [[nodiscard]] const std::string &path() const override;
   [[nodiscard]] std::string header(const std::string &key) const override;
+  [[nodiscard]] const astra::utils::HeaderBlock &headers() const noexcept {
+    return m_headers;
+  }
+  /// Copies the body into a string on first use; prefer body_view()
   [[nodiscard]] const std::string &body() const override;
+  [[nodiscard]] std::string_view body_view() const override;
+  [[nodiscard]] const astra::router::RequestBody &raw_body() const noexcept {
+    return m_body;
+  }
 
   [[nodiscard]] std::string path_param(const std::string &key) const override;
   [[nodiscard]] std::string query_param(const std::string &key) const override;
@@ -34,13 +50,18 @@ public:
   void
   set_path_params(std::unordered_map<std::string, std::string> params) override;
 
+  [[nodiscard]] astra::utils::Deadline deadline() const override;
+  void set_deadline(astra::utils::Deadline deadline);
+
 private:
   std::string m_method;
   std::string m_path;
-  std::string m_body;
-  std::map<std::string, std::string> m_headers;
+  astra::router::RequestBody m_body;
+  mutable std::optional<std::string> m_body_string;
+  astra::utils::HeaderBlock m_headers;
   std::unordered_map<std::string, std::string> m_path_params;
   std::unordered_map<std::string, std::string> m_query_params;
+  astra::utils::Deadline m_deadline;
 };
 
 } // namespace astra::http2
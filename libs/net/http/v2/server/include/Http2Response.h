@@ -2,8 +2,9 @@
 
 #include "IResponse.h"
 
+#include <HeaderBlock.h>
 #include <IScopedResource.h>
-#include <map>
+#include <resilience/LoadShedderGuard.h>
 #include <memory>
 #include <optional>
 #include <string>
@@ -28,14 +29,22 @@ public:
   void set_header(const std::string &key, const std::string &value) override;
   void write(const std::string &data) override;
   void close() override;
+  /// Headers and body set on this response so far are discarded
+  void send_prepared(
+      const std::shared_ptr<const astra::router::PreparedResponse> &response)
+      override;
+  /// Headers set so far go out with the status (200 if unset)
+  [[nodiscard]] std::shared_ptr<astra::router::IResponseStream>
+  start_stream() override;
   [[nodiscard]] bool is_alive() const noexcept override;
 
   void add_scoped_resource(
       std::unique_ptr<astra::execution::IScopedResource> resource);
+  void add_guard(astra::resilience::LoadShedderGuard guard);
 
 private:
   std::optional<int> m_status;
-  std::map<std::string, std::string> m_headers;
+  astra::utils::HeaderBlock m_headers;
   std::string m_body;
   std::weak_ptr<Http2ResponseWriter> m_writer;
   bool m_closed = false;
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "Http2ResponseWriter.h"
+
+#include <IResponseStream.h>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace astra::http2 {
+
+// Buffers chunks from a producer on any thread and hands them to nghttp2
+// through a pull callback, which nghttp2 only calls when the peer's flow
+// control window has room. A drained buffer parks the stream until the
+// next write; a buffer over the high-water mark pushes back on the
+// producer until it falls under half of it.
+class Http2ResponseStream final
+    : public astra::router::IResponseStream,
+      public std::enable_shared_from_this<Http2ResponseStream> {
+public:
+  static constexpr size_t kDefaultHighWater = 64 * 1024;
+
+  explicit Http2ResponseStream(std::weak_ptr<Http2ResponseWriter> writer,
+                               size_t high_water = kDefaultHighWater);
+
+  bool write(std::string chunk) override;
+  void on_writable(std::function<void()> callback) override;
+  void finish() override;
+  [[nodiscard]] bool is_alive() const noexcept override;
+
+  // Bound to this stream, for Http2ResponseWriter::start_stream
+  [[nodiscard]] Http2ResponseWriter::Pull puller();
+
+  [[nodiscard]] size_t buffered() const;
+
+private:
+  Http2ResponseWriter::Pulled pull(uint8_t *buf, size_t len);
+  void wake(bool parked);
+
+  std::weak_ptr<Http2ResponseWriter> m_writer;
+  const size_t m_high_water;
+
+  mutable std::mutex m_mutex;
+  std::deque<std::string> m_chunks;
+  size_t m_front_offset = 0;
+  size_t m_buffered = 0;
+  bool m_finished = false;
+  bool m_parked = false;
+  bool m_blocked = false;
+  std::function<void()> m_on_writable;
+};
+
+} // namespace astra::http2
@@ -1,9 +1,13 @@
 #pragma once
 
+#include <HeaderBlock.h>
 #include <IScopedResource.h>
+#include <PreparedResponse.h>
+#include <array>
 #include <atomic>
+#include <cstdint>
 #include <functional>
-#include <map>
+#include <resilience/LoadShedderGuard.h>
 #include <memory>
 #include <string>
 #include <vector>
@@ -14,14 +18,50 @@ class Http2ResponseWriter
     : public std::enable_shared_from_this<Http2ResponseWriter> {
 public:
   using SendResponse =
-      std::function<void(int status, std::map<std::string, std::string> headers,
+      std::function<void(int status, astra::utils::HeaderBlock headers,
                          std::string body)>;
   using PostWork = std::function<void(std::function<void()>)>;
+  using SendPrepared = std::function<void(
+      const std::shared_ptr<const astra::router::PreparedResponse> &)>;
 
-  Http2ResponseWriter(SendResponse send_response, PostWork post_work);
+  // One pull of a streamed body: how many bytes were written into the
+  // transport's buffer, and whether to wait for resume() or stop after them
+  struct Pulled {
+    enum class State { Data, Wait, End };
+    size_t size;
+    State state;
+  };
+  // Called on the io thread only when flow control has room for `len`
+  using Pull = std::function<Pulled(uint8_t *buf, size_t len)>;
+  using StartStream = std::function<void(
+      int status, astra::utils::HeaderBlock headers, Pull pull)>;
+  using Resume = std::function<void()>;
+  // True when called on the thread post_work posts to. A response sent
+  // from there, by an inline route, runs straight away instead of posting.
+  using OnIoThread = std::function<bool()>;
 
-  void send(int status, std::map<std::string, std::string> headers,
+  Http2ResponseWriter(SendResponse send_response, PostWork post_work,
+                      StartStream start_stream = nullptr,
+                      Resume resume = nullptr,
+                      SendPrepared send_prepared = nullptr,
+                      OnIoThread on_io_thread = nullptr);
+
+  void send(int status, astra::utils::HeaderBlock headers,
             std::string body);
+  // Falls back to copying into send() when the transport has no
+  // SendPrepared
+  void send_prepared(
+      std::shared_ptr<const astra::router::PreparedResponse> response);
+
+  [[nodiscard]] bool can_stream() const noexcept {
+    return m_start_stream != nullptr;
+  }
+
+  // Sends headers and hands the body to `pull`; resume() wakes a pull
+  // that returned Wait
+  void start_stream(int status, astra::utils::HeaderBlock headers,
+                    Pull pull);
+  void resume();
 
   void mark_closed() noexcept;
 
@@ -32,12 +72,27 @@ public:
     m_scoped_resources.push_back(std::move(resource));
   }
 
+  // Admission guards are held inline, so attaching one on the request path
+  // does not allocate; only guards past kInlineGuards spill to the heap.
+  void add_guard(astra::resilience::LoadShedderGuard guard);
+
 private:
+  [[nodiscard]] bool on_io_thread() const;
+
   SendResponse m_send_response;
   PostWork m_post_work;
+  StartStream m_start_stream;
+  Resume m_resume;
+  SendPrepared m_send_prepared;
+  OnIoThread m_on_io_thread;
   std::atomic<bool> m_stream_alive{true};
   std::vector<std::unique_ptr<astra::execution::IScopedResource>>
       m_scoped_resources;
+
+  static constexpr size_t kInlineGuards = 2;
+  std::array<astra::resilience::LoadShedderGuard, kInlineGuards> m_guards;
+  size_t m_guard_count = 0;
+  std::vector<astra::resilience::LoadShedderGuard> m_spilled_guards;
 };
 
 } // namespace astra::http2
@@ -5,6 +5,7 @@
 #include "http2server.pb.h"
 
 #include <Result.h>
+#include <cstddef>
 #include <functional>
 #include <memory>
 #include <string>
@@ -14,8 +15,15 @@ namespace astra::http2 {
 class Http2Request;
 class Http2Response;
 
+// What a graceful stop() did with the streams open when it began
+struct DrainReport {
+  size_t drained = 0; // completed within drain_timeout_ms
+  size_t aborted = 0; // still open at the deadline and reset
+};
+
 class Http2Server {
 public:
+  // Throws std::invalid_argument for a compression level outside 1-9
   explicit Http2Server(const ServerConfig &config);
   ~Http2Server();
 
@@ -24,12 +32,15 @@ public:
 
   using Handler = astra::router::Handler;
 
+  // Same as router().add_route(); "*" matches any method
   void handle(const std::string &method, const std::string &path,
               Handler handler);
 
   astra::outcome::Result<void, Http2ServerError> start();
   astra::outcome::Result<void, Http2ServerError> join();
-  astra::outcome::Result<void, Http2ServerError> stop();
+  // Refuses new streams, waits up to drain_timeout_ms for open ones, then
+  // closes every connection. Blocks the caller for the drain.
+  astra::outcome::Result<DrainReport, Http2ServerError> stop();
 
   [[nodiscard]] astra::router::Router &router() {
     return m_router;
@@ -37,8 +48,10 @@ public:
 
 private:
   class Impl;
-  std::unique_ptr<Impl> m_impl;
+  // Declared first: the server's streams dispatch into it until m_impl is
+  // torn down
   astra::router::Router m_router;
+  std::unique_ptr<Impl> m_impl;
 };
 
 } // namespace astra::http2
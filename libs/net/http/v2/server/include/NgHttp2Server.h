@@ -1,10 +1,13 @@
 #pragma once
 
+#include "ConnectionLimiter.h"
 #include "Http2Server.h"
 #include "Http2ServerError.h"
+#include "Router.h"
 
 #include <Result.h>
 #include <atomic>
+#include <boost/asio/ssl/context.hpp>
 #include <nghttp2/asio_http2_server.h>
 #include <string>
 
@@ -12,19 +15,25 @@ namespace astra::http2 {
 
 class NgHttp2Server {
 public:
-  NgHttp2Server(const ServerConfig &config);
+  // Every request is matched against `router`, which must outlive this
+  NgHttp2Server(const ServerConfig &config, astra::router::Router &router);
   ~NgHttp2Server();
 
-  void handle(const std::string &method, const std::string &path,
-              Http2Server::Handler handler);
-
   astra::outcome::Result<void, Http2ServerError> start();
   astra::outcome::Result<void, Http2ServerError> join();
-  astra::outcome::Result<void, Http2ServerError> stop();
+  astra::outcome::Result<DrainReport, Http2ServerError> stop();
 
 private:
+  void serve();
+
   ServerConfig m_config;
+  astra::router::Router &m_router;
   std::atomic<bool> m_is_running{false};
+  std::atomic<bool> m_is_stopping{false};
+  // Outlives m_server, whose stream callbacks release into it
+  ConnectionLimiter m_limiter;
+  // Used only with tls.enabled; every TLS connection holds a reference
+  boost::asio::ssl::context m_tls{boost::asio::ssl::context::tls_server};
   nghttp2::asio_http2::server::http2 m_server;
 };
 
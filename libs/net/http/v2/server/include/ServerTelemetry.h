@@ -0,0 +1,84 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace astra::http2::telemetry {
+
+// Connection, stream and phase metrics for the HTTP/2 server, recorded
+// into an obs::MetricsRegistry. Built with ASTRA_HTTP2_TELEMETRY undefined
+// (-DENABLE_HTTP2_TELEMETRY=OFF) every call below is an empty inline
+// function and StreamTimer holds nothing, so the layer compiles away.
+//
+// nghttp2-asio exposes no accept hook, so a connection is seen from its
+// first admitted stream until its last one closes, as ConnectionLimiter
+// counts it.
+#ifdef ASTRA_HTTP2_TELEMETRY
+inline constexpr bool kEnabled = true;
+
+void connection_active(uint64_t connection);
+void connection_idle(uint64_t connection);
+// `open` is the connection's stream count including this one
+void stream_opened(size_t open);
+void stream_closed(uint32_t error_code);
+void request_header_bytes(size_t bytes);
+void request_body_bytes(size_t bytes);
+void response_body_bytes(size_t bytes);
+// A streamed response pushed back on its producer because the peer's
+// flow control window is not draining the buffer
+void flow_control_stall();
+
+// Phase timings of one stream: headers received, body complete, response
+// handed to nghttp2, stream closed. Stamped on the stream's io thread.
+class StreamTimer {
+public:
+  StreamTimer() : m_headers(std::chrono::steady_clock::now()) {
+  }
+
+  void body_complete() {
+    m_body = std::chrono::steady_clock::now();
+  }
+  void response_started() {
+    m_response = std::chrono::steady_clock::now();
+  }
+  // Records whichever phases the stream got through
+  void finish() const;
+
+private:
+  std::chrono::steady_clock::time_point m_headers;
+  std::chrono::steady_clock::time_point m_body;
+  std::chrono::steady_clock::time_point m_response;
+};
+#else
+inline constexpr bool kEnabled = false;
+
+inline void connection_active(uint64_t) {
+}
+inline void connection_idle(uint64_t) {
+}
+inline void stream_opened(size_t) {
+}
+inline void stream_closed(uint32_t) {
+}
+inline void request_header_bytes(size_t) {
+}
+inline void request_body_bytes(size_t) {
+}
+inline void response_body_bytes(size_t) {
+}
+inline void flow_control_stall() {
+}
+
+class StreamTimer {
+public:
+  void body_complete() {
+  }
+  void response_started() {
+  }
+  void finish() const {
+  }
+};
+#endif
+
+} // namespace astra::http2::telemetry
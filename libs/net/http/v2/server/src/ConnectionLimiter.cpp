@@ -0,0 +1,116 @@
+#include "ConnectionLimiter.h"
+
+namespace astra::http2 {
+
+ConnectionLimiter::Admission ConnectionLimiter::admit(ConnectionId connection) {
+  if (m_closed.load(std::memory_order_acquire)) {
+    return Admission::Closed;
+  }
+
+  auto &shard = shard_of(connection);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+
+  auto it = shard.streams.find(connection);
+  if (it != shard.streams.end() && m_max_streams > 0 &&
+      it->second >= m_max_streams) {
+    return Admission::StreamLimit;
+  }
+
+  // Counted before close() is re-checked, so either the drain sees this
+  // stream or this stream sees the drain
+  m_total.fetch_add(1);
+  if (m_closed.load()) {
+    drop_stream();
+    return Admission::Closed;
+  }
+
+  if (it == shard.streams.end()) {
+    if (!reserve_connection()) {
+      drop_stream();
+      return Admission::ConnectionLimit;
+    }
+    shard.streams.emplace(connection, 1);
+  } else {
+    ++it->second;
+  }
+  return Admission::Admitted;
+}
+
+size_t ConnectionLimiter::release(ConnectionId connection) {
+  size_t left = 0;
+  {
+    auto &shard = shard_of(connection);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.streams.find(connection);
+    if (it == shard.streams.end()) {
+      return 0;
+    }
+    left = --it->second;
+    if (left == 0) {
+      shard.streams.erase(it);
+      m_connections.fetch_sub(1, std::memory_order_relaxed);
+    }
+  }
+
+  drop_stream();
+  return left;
+}
+
+void ConnectionLimiter::close() {
+  m_closed.store(true);
+}
+
+bool ConnectionLimiter::wait_idle(
+    std::chrono::steady_clock::time_point deadline) {
+  std::unique_lock<std::mutex> lock(m_idle_mutex);
+  return m_idle.wait_until(lock, deadline, [this] {
+    return m_total.load(std::memory_order_acquire) == 0;
+  });
+}
+
+size_t ConnectionLimiter::connections() const {
+  return m_connections.load(std::memory_order_relaxed);
+}
+
+size_t ConnectionLimiter::streams() const {
+  return m_total.load(std::memory_order_acquire);
+}
+
+size_t ConnectionLimiter::streams(ConnectionId connection) const {
+  auto &shard = shard_of(connection);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  auto it = shard.streams.find(connection);
+  return it != shard.streams.end() ? it->second : 0;
+}
+
+ConnectionLimiter::Shard &
+ConnectionLimiter::shard_of(ConnectionId connection) const {
+  // Peer ports sit in the low bits of the id; mix before picking a shard
+  uint64_t h = connection * 0x9E3779B97F4A7C15ull;
+  return m_shards[(h >> 32) % kShards];
+}
+
+void ConnectionLimiter::drop_stream() {
+  if (m_total.fetch_sub(1) == 1) {
+    std::lock_guard<std::mutex> lock(m_idle_mutex);
+    m_idle.notify_all();
+  }
+}
+
+bool ConnectionLimiter::reserve_connection() {
+  if (m_max_connections == 0) {
+    m_connections.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+  size_t current = m_connections.load(std::memory_order_relaxed);
+  while (current < m_max_connections) {
+    if (m_connections.compare_exchange_weak(current, current + 1,
+                                            std::memory_order_relaxed)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace astra::http2
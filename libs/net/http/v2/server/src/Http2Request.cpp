@@ -4,7 +4,16 @@ namespace astra::http2 {
 
 Http2Request::Http2Request(
     std::string method, std::string path,
-    std::map<std::string, std::string> headers, std::string body,
+    astra::utils::HeaderBlock headers, std::string body,
+    std::unordered_map<std::string, std::string> query_params)
+    : m_method(std::move(method)), m_path(std::move(path)),
+      m_body(body), m_headers(std::move(headers)),
+      m_query_params(std::move(query_params)) {
+}
+
+Http2Request::Http2Request(
+    std::string method, std::string path,
+    astra::utils::HeaderBlock headers, astra::router::RequestBody body,
     std::unordered_map<std::string, std::string> query_params)
     : m_method(std::move(method)), m_path(std::move(path)),
       m_body(std::move(body)), m_headers(std::move(headers)),
@@ -20,15 +29,18 @@ const std::string &Http2Request::path() const {
 }
 
 std::string Http2Request::header(const std::string &key) const {
-  auto it = m_headers.find(key);
-  if (it != m_headers.end()) {
-    return it->second;
-  }
-  return {};
+  return std::string(m_headers.get(key));
 }
 
 const std::string &Http2Request::body() const {
-  return m_body;
+  if (!m_body_string) {
+    m_body_string = m_body.to_string();
+  }
+  return *m_body_string;
+}
+
+std::string_view Http2Request::body_view() const {
+  return m_body.view();
 }
 
 std::string Http2Request::path_param(const std::string &key) const {
@@ -52,4 +64,12 @@ void Http2Request::set_path_params(
   m_path_params = std::move(params);
 }
 
+astra::utils::Deadline Http2Request::deadline() const {
+  return m_deadline;
+}
+
+void Http2Request::set_deadline(astra::utils::Deadline deadline) {
+  m_deadline = deadline;
+}
+
 } // namespace astra::http2
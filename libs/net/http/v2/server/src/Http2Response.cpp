@@ -1,5 +1,6 @@
 #include "Http2Response.h"
 
+#include "Http2ResponseStream.h"
 #include "Http2ResponseWriter.h"
 
 #include <Log.h>
@@ -16,7 +17,7 @@ void Http2Response::set_status(int code) noexcept {
 
 void Http2Response::set_header(const std::string &key,
                                const std::string &value) {
-  m_headers[key] = value;
+  m_headers.set(key, value);
 }
 
 void Http2Response::write(const std::string &data) {
@@ -41,6 +42,33 @@ void Http2Response::close() {
   }
 }
 
+void Http2Response::send_prepared(
+    const std::shared_ptr<const astra::router::PreparedResponse> &response) {
+  if (m_closed) {
+    return;
+  }
+  m_closed = true;
+
+  if (auto handle = m_writer.lock()) {
+    handle->send_prepared(response);
+  } else {
+    obs::debug("Cannot send response: stream already closed");
+  }
+}
+
+std::shared_ptr<astra::router::IResponseStream> Http2Response::start_stream() {
+  auto handle = m_writer.lock();
+  if (m_closed || !handle || !handle->can_stream()) {
+    return nullptr;
+  }
+  m_closed = true;
+
+  auto stream = std::make_shared<Http2ResponseStream>(m_writer);
+  handle->start_stream(m_status.value_or(200), std::move(m_headers),
+                       stream->puller());
+  return stream;
+}
+
 void Http2Response::add_scoped_resource(
     std::unique_ptr<astra::execution::IScopedResource> resource) {
   if (auto handle = m_writer.lock()) {
@@ -48,6 +76,12 @@ void Http2Response::add_scoped_resource(
   }
 }
 
+void Http2Response::add_guard(astra::resilience::LoadShedderGuard guard) {
+  if (auto handle = m_writer.lock()) {
+    handle->add_guard(std::move(guard));
+  }
+}
+
 bool Http2Response::is_alive() const noexcept {
   if (auto handle = m_writer.lock()) {
     return handle->is_alive();
@@ -0,0 +1,135 @@
+#include "Http2ResponseStream.h"
+
+#include "ServerTelemetry.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace astra::http2 {
+
+Http2ResponseStream::Http2ResponseStream(
+    std::weak_ptr<Http2ResponseWriter> writer, size_t high_water)
+    : m_writer(std::move(writer)),
+      m_high_water(std::max<size_t>(high_water, 1)) {
+}
+
+bool Http2ResponseStream::write(std::string chunk) {
+  if (!is_alive()) {
+    return false;
+  }
+
+  bool parked;
+  bool writable;
+  bool stalled;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_finished) {
+      return false;
+    }
+    if (!chunk.empty()) {
+      m_buffered += chunk.size();
+      m_chunks.push_back(std::move(chunk));
+    }
+    parked = std::exchange(m_parked, false);
+    writable = m_buffered < m_high_water;
+    stalled = !writable && !m_blocked;
+    m_blocked = m_blocked || !writable;
+  }
+
+  if (stalled) {
+    telemetry::flow_control_stall();
+  }
+  wake(parked);
+  return writable;
+}
+
+void Http2ResponseStream::on_writable(std::function<void()> callback) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_on_writable = std::move(callback);
+}
+
+void Http2ResponseStream::finish() {
+  bool parked;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_finished) {
+      return;
+    }
+    m_finished = true;
+    parked = std::exchange(m_parked, false);
+  }
+  wake(parked);
+}
+
+bool Http2ResponseStream::is_alive() const noexcept {
+  if (auto writer = m_writer.lock()) {
+    return writer->is_alive();
+  }
+  return false;
+}
+
+Http2ResponseWriter::Pull Http2ResponseStream::puller() {
+  return [self = shared_from_this()](uint8_t *buf, size_t len) {
+    return self->pull(buf, len);
+  };
+}
+
+size_t Http2ResponseStream::buffered() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_buffered;
+}
+
+Http2ResponseWriter::Pulled Http2ResponseStream::pull(uint8_t *buf,
+                                                      size_t len) {
+  using State = Http2ResponseWriter::Pulled::State;
+
+  std::function<void()> notify;
+  Http2ResponseWriter::Pulled pulled{0, State::Data};
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // Copy straight into nghttp2's frame buffer; a chunk larger than the
+    // window is sent across several pulls
+    while (pulled.size < len && !m_chunks.empty()) {
+      const auto &front = m_chunks.front();
+      size_t n = std::min(len - pulled.size, front.size() - m_front_offset);
+      std::memcpy(buf + pulled.size, front.data() + m_front_offset, n);
+      pulled.size += n;
+      m_front_offset += n;
+      if (m_front_offset == front.size()) {
+        m_chunks.pop_front();
+        m_front_offset = 0;
+      }
+    }
+    m_buffered -= pulled.size;
+
+    if (m_chunks.empty()) {
+      if (m_finished) {
+        pulled.state = State::End;
+      } else if (pulled.size == 0) {
+        pulled.state = State::Wait;
+        m_parked = true;
+      }
+    }
+
+    if (m_blocked && m_buffered <= m_high_water / 2) {
+      m_blocked = false;
+      notify = m_on_writable;
+    }
+  }
+
+  if (notify) {
+    notify();
+  }
+  return pulled;
+}
+
+void Http2ResponseStream::wake(bool parked) {
+  if (!parked) {
+    return;
+  }
+  if (auto writer = m_writer.lock()) {
+    writer->resume();
+  }
+}
+
+} // namespace astra::http2
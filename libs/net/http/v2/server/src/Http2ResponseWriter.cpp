@@ -3,14 +3,32 @@
 namespace astra::http2 {
 
 Http2ResponseWriter::Http2ResponseWriter(SendResponse send_response,
-                                         PostWork post_work)
+                                         PostWork post_work,
+                                         StartStream start_stream,
+                                         Resume resume,
+                                         SendPrepared send_prepared,
+                                         OnIoThread on_io_thread)
     : m_send_response(std::move(send_response)),
-      m_post_work(std::move(post_work)), m_stream_alive(true) {
+      m_post_work(std::move(post_work)),
+      m_start_stream(std::move(start_stream)), m_resume(std::move(resume)),
+      m_send_prepared(std::move(send_prepared)),
+      m_on_io_thread(std::move(on_io_thread)), m_stream_alive(true) {
+}
+
+bool Http2ResponseWriter::on_io_thread() const {
+  return m_on_io_thread && m_on_io_thread();
 }
 
 void Http2ResponseWriter::send(int status,
-                               std::map<std::string, std::string> headers,
+                               astra::utils::HeaderBlock headers,
                                std::string body) {
+  if (on_io_thread()) {
+    if (is_alive()) {
+      m_send_response(status, std::move(headers), std::move(body));
+    }
+    return;
+  }
+
   auto self = shared_from_this();
 
   m_post_work([self, status, headers = std::move(headers),
@@ -21,10 +39,75 @@ void Http2ResponseWriter::send(int status,
   });
 }
 
+void Http2ResponseWriter::send_prepared(
+    std::shared_ptr<const astra::router::PreparedResponse> response) {
+  if (!m_send_prepared) {
+    send(response->status(), response->headers(),
+         std::string(response->body()));
+    return;
+  }
+
+  if (on_io_thread()) {
+    if (is_alive()) {
+      m_send_prepared(response);
+    }
+    return;
+  }
+
+  auto self = shared_from_this();
+
+  m_post_work([self, response = std::move(response)]() {
+    if (self->m_stream_alive.load(std::memory_order_acquire)) {
+      self->m_send_prepared(response);
+    }
+  });
+}
+
+void Http2ResponseWriter::start_stream(
+    int status, astra::utils::HeaderBlock headers, Pull pull) {
+  if (on_io_thread()) {
+    if (is_alive()) {
+      m_start_stream(status, std::move(headers), std::move(pull));
+    }
+    return;
+  }
+
+  auto self = shared_from_this();
+
+  m_post_work([self, status, headers = std::move(headers),
+               pull = std::move(pull)]() mutable {
+    if (self->m_stream_alive.load(std::memory_order_acquire)) {
+      self->m_start_stream(status, std::move(headers), std::move(pull));
+    }
+  });
+}
+
+// Always posted: a pull can wake its own stream from inside nghttp2's read
+// callback, and a resume there would be undone when the callback returns
+// deferred
+void Http2ResponseWriter::resume() {
+  auto self = shared_from_this();
+
+  m_post_work([self]() {
+    if (self->m_stream_alive.load(std::memory_order_acquire)) {
+      self->m_resume();
+    }
+  });
+}
+
 void Http2ResponseWriter::mark_closed() noexcept {
   m_stream_alive.store(false, std::memory_order_release);
 }
 
+void Http2ResponseWriter::add_guard(
+    astra::resilience::LoadShedderGuard guard) {
+  if (m_guard_count < kInlineGuards) {
+    m_guards[m_guard_count++] = std::move(guard);
+  } else {
+    m_spilled_guards.push_back(std::move(guard));
+  }
+}
+
 bool Http2ResponseWriter::is_alive() const noexcept {
   return m_stream_alive.load(std::memory_order_acquire);
 }
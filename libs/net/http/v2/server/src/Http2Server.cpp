@@ -6,28 +6,44 @@
 
 namespace astra::http2 {
 
+namespace {
+
+astra::router::CompressionPolicy
+compression_policy(const ServerCompressionConfig &config) {
+  astra::router::CompressionPolicy defaults;
+  auto or_default = [](uint32_t value, size_t fallback) {
+    return value > 0 ? size_t{value} : fallback;
+  };
+  return astra::router::CompressionPolicy::create(
+      config.level() > 0 ? static_cast<int>(config.level()) : defaults.level,
+      or_default(config.min_size(), defaults.min_size),
+      or_default(config.cache_entries(), defaults.cache_entries),
+      or_default(config.cache_max_body(), defaults.cache_max_body));
+}
+
+} // namespace
+
 class Http2Server::Impl {
 public:
-  Impl(const ServerConfig &config) : backend(config) {
+  Impl(const ServerConfig &config, astra::router::Router &router)
+      : backend(config, router) {
   }
 
   NgHttp2Server backend;
 };
 
 Http2Server::Http2Server(const ServerConfig &config)
-    : m_impl(std::make_unique<Impl>(config)) {
-  m_impl->backend.handle("*", "/",
-                         [this](std::shared_ptr<astra::router::IRequest> req,
-                                std::shared_ptr<astra::router::IResponse> res) {
-                           m_router.dispatch(req, res);
-                         });
+    : m_impl(std::make_unique<Impl>(config, m_router)) {
+  if (config.compression().enabled()) {
+    m_router.set_compression(compression_policy(config.compression()));
+  }
 }
 
 Http2Server::~Http2Server() = default;
 
 void Http2Server::handle(const std::string &method, const std::string &path,
                          Handler handler) {
-  m_impl->backend.handle(method, path, handler);
+  m_router.add_route(method, path, std::move(handler));
 }
 
 astra::outcome::Result<void, Http2ServerError> Http2Server::start() {
@@ -38,7 +54,7 @@ astra::outcome::Result<void, Http2ServerError> Http2Server::join() {
   return m_impl->backend.join();
 }
 
-astra::outcome::Result<void, Http2ServerError> Http2Server::stop() {
+astra::outcome::Result<DrainReport, Http2ServerError> Http2Server::stop() {
   return m_impl->backend.stop();
 }
 
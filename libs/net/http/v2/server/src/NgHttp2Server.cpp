@@ -3,29 +3,220 @@
 #include "Http2Request.h"
 #include "Http2Response.h"
 #include "Http2ResponseWriter.h"
+#include "ServerTelemetry.h"
 #include "Url.h"
 
+#include <HeaderBlock.h>
 #include <Log.h>
+#include <Metrics.h>
+#include <RequestBody.h>
+#include <TlsContext.h>
+#include <algorithm>
+#include <boost/asio/steady_timer.hpp>
+#include <charconv>
+#include <cstring>
+#include <nghttp2/nghttp2.h>
 
 namespace {
 
+nghttp2::asio_http2::header_map
+to_header_map(const astra::utils::HeaderBlock &headers) {
+  nghttp2::asio_http2::header_map h;
+  for (const auto &[k, v] : headers) {
+    h.emplace(k, nghttp2::asio_http2::header_value{v, false});
+  }
+  return h;
+}
+
 struct RequestStream {
   std::string method;
   std::string path;
-  std::map<std::string, std::string> headers;
-  std::string body;
+  astra::utils::HeaderBlock headers;
+  astra::router::RequestBody body;
   std::unordered_map<std::string, std::string> query_params;
+  astra::utils::Deadline deadline;
   std::shared_ptr<astra::http2::Http2ResponseWriter> response_writer;
-  astra::http2::Http2Server::Handler handler;
+  astra::router::Router::MatchResult match;
+  astra::http2::telemetry::StreamTimer timer;
+
+  // Stream idle watch; only touched on the connection's io thread
+  std::unique_ptr<boost::asio::steady_timer> idle_timer;
+  std::chrono::steady_clock::time_point last_activity;
+  // Body and handler deadline; same thread rules as the idle watch
+  std::unique_ptr<boost::asio::steady_timer> deadline_timer;
+  bool body_complete = false;
+  bool response_started = false;
+  bool timed_out = false;
+  bool closed = false;
 };
 
+constexpr uint32_t kDefaultWindowSize = 65535;
+constexpr uint32_t kAdvertisedMaxStreams = 100; // Fixed by nghttp2-asio
+
+astra::http2::ConnectionLimiter::ConnectionId
+connection_id(const boost::asio::ip::tcp::endpoint &peer) {
+  const auto &address = peer.address();
+  if (address.is_v4()) {
+    return (uint64_t{address.to_v4().to_uint()} << 16) | peer.port();
+  }
+  uint64_t h = 14695981039346656037ull; // FNV-1a
+  for (auto byte : address.to_v6().to_bytes()) {
+    h = (h ^ byte) * 1099511628211ull;
+  }
+  return (h << 16) ^ peer.port();
+}
+
+astra::tls::ServerOptions
+tls_options(const astra::http2::ServerTlsConfig &config) {
+  astra::tls::ServerOptions options;
+  options.cert_file = config.cert_file();
+  options.key_file = config.key_file();
+  options.ciphers = config.ciphers();
+  options.ciphersuites = config.ciphersuites();
+  // nghttp2-asio speaks nothing else on this listener
+  options.alpn = {"h2"};
+  if (config.session_cache_size() > 0) {
+    options.session_cache_size = config.session_cache_size();
+  }
+  if (config.session_timeout_s() > 0) {
+    options.session_timeout = std::chrono::seconds(config.session_timeout_s());
+  }
+  options.session_tickets = !config.disable_session_tickets();
+  options.ktls = config.ktls();
+  return options;
+}
+
+// The body is pulled straight out of the shared PreparedResponse, which
+// the generator keeps alive until the last byte is out
+void send_prepared(
+    const nghttp2::asio_http2::server::response &res,
+    const std::shared_ptr<const astra::router::PreparedResponse> &prepared) {
+  res.write_head(prepared->status(), to_header_map(prepared->headers()));
+  if (prepared->body().empty()) {
+    res.end();
+    return;
+  }
+  res.end([prepared, offset = size_t{0}](uint8_t *buf, std::size_t len,
+                                         uint32_t *data_flags) mutable
+          -> ssize_t {
+    auto body = prepared->body();
+    size_t n = std::min(len, body.size() - offset);
+    std::memcpy(buf, body.data() + offset, n);
+    offset += n;
+    if (offset == body.size()) {
+      *data_flags |= NGHTTP2_DATA_FLAG_EOF;
+    }
+    return static_cast<ssize_t>(n);
+  });
+}
+
+void limit_hit(const char *limit) {
+  obs::counter("http2.server.limit_hit").inc(1, {{"limit", limit}});
+}
+
+// Re-arms for whatever is left of the window instead of restarting the
+// timer on every DATA frame
+void watch_idle(const std::shared_ptr<RequestStream> &stream,
+                const nghttp2::asio_http2::server::response &res,
+                std::chrono::milliseconds idle) {
+  stream->idle_timer->expires_at(stream->last_activity + idle);
+  stream->idle_timer->async_wait(
+      [stream, &res, idle](const boost::system::error_code &ec) {
+        if (ec || stream->closed || stream->body_complete) {
+          return;
+        }
+        if (std::chrono::steady_clock::now() - stream->last_activity < idle) {
+          watch_idle(stream, res, idle);
+          return;
+        }
+        limit_hit("stream_idle");
+        res.cancel(NGHTTP2_CANCEL);
+      });
+}
+
+const std::shared_ptr<const astra::router::PreparedResponse> &
+request_timeout() {
+  static const auto response =
+      astra::router::PreparedResponse::create(408, {}, "Request Timeout");
+  return response;
+}
+
+const std::shared_ptr<const astra::router::PreparedResponse> &
+gateway_timeout() {
+  static const auto response =
+      astra::router::PreparedResponse::create(504, {}, "Gateway Timeout");
+  return response;
+}
+
+// Answers for the stream once it overruns: 408 while the body is still
+// arriving, 504 once the handler has it but has not begun a response.
+// Closing the writer first drops whatever the handler sends later; the
+// stream then ends normally and on_close frees it, the writer and the
+// shedder guards the writer holds.
+void watch_deadline(const std::shared_ptr<RequestStream> &stream,
+                    const nghttp2::asio_http2::server::response &res,
+                    std::chrono::steady_clock::time_point when) {
+  stream->deadline_timer->expires_at(when);
+  stream->deadline_timer->async_wait(
+      [stream, &res](const boost::system::error_code &ec) {
+        if (ec || stream->closed || stream->response_started) {
+          return;
+        }
+        const bool in_body = !stream->body_complete;
+        stream->timed_out = true;
+        stream->response_started = true;
+        stream->response_writer->mark_closed();
+        if (stream->idle_timer) {
+          stream->idle_timer->cancel();
+        }
+        stream->body = {};
+        obs::counter("http2.server.timeouts")
+            .inc(1, {{"phase", in_body ? "body" : "handler"}});
+        stream->timer.response_started();
+        send_prepared(res, in_body ? request_timeout() : gateway_timeout());
+      });
+}
+
 } // namespace
 
 namespace astra::http2 {
 
-NgHttp2Server::NgHttp2Server(const ServerConfig &config) : m_config(config) {
+NgHttp2Server::NgHttp2Server(const ServerConfig &config,
+                             astra::router::Router &router)
+    : m_config(config), m_router(router),
+      m_limiter(config.max_connections(), config.max_concurrent_streams()) {
   int threads = m_config.thread_count() > 0 ? m_config.thread_count() : 1;
   m_server.num_threads(threads);
+  // nghttp2-asio offers no connection hook, so its read timeout is what
+  // closes connections left without streams. It fires on any connection
+  // silent that long in both directions, so it never undercuts the request
+  // budget of a stream still waiting on its handler.
+  if (m_config.connection_idle_timeout_ms() > 0) {
+    uint32_t idle_ms = std::max(m_config.connection_idle_timeout_ms(),
+                                m_config.request_timeout_ms());
+    if (idle_ms != m_config.connection_idle_timeout_ms()) {
+      obs::warn("connection_idle_timeout_ms raised to request_timeout_ms",
+                {{"idle_ms", std::to_string(idle_ms)}});
+    }
+    m_server.read_timeout(boost::posix_time::milliseconds(idle_ms));
+  }
+
+  // nghttp2-asio sends its own SETTINGS frame and offers no way to change
+  // it, so these are enforced server-side where possible and reported
+  if (m_config.max_concurrent_streams() > kAdvertisedMaxStreams) {
+    obs::warn("max_concurrent_streams above the advertised " +
+              std::to_string(kAdvertisedMaxStreams) +
+              "; peers will not open more than that");
+  }
+  if (m_config.initial_window_size() != 0 &&
+      m_config.initial_window_size() != kDefaultWindowSize) {
+    obs::warn("initial_window_size is not applied; nghttp2-asio always "
+              "advertises " +
+              std::to_string(kDefaultWindowSize));
+  }
+
+  serve();
+
   obs::info("NgHttp2Server initialized with " + std::to_string(threads) +
             " threads");
 }
@@ -37,15 +228,52 @@ NgHttp2Server::~NgHttp2Server() {
   }
 }
 
-void NgHttp2Server::handle(const std::string &method, const std::string &path,
-                           Http2Server::Handler handler) {
-  m_server.handle(path, [handler = std::move(handler), method](
-                            const nghttp2::asio_http2::server::request &req,
-                            const nghttp2::asio_http2::server::response &res) {
-    if (method != "*" && req.method() != method) {
-      res.write_head(405);
-      res.end();
+// One catch-all for nghttp2's mux; the router matches once per request, on
+// the io thread, before any of the body is read. A miss is answered right
+// there, without admitting the stream or allocating its state.
+void NgHttp2Server::serve() {
+  auto timeout = std::chrono::milliseconds(m_config.request_timeout_ms());
+  auto idle = std::chrono::milliseconds(m_config.stream_idle_timeout_ms());
+  auto body_timeout = std::chrono::milliseconds(m_config.body_timeout_ms());
+  auto *limiter = &m_limiter;
+  auto *router = &m_router;
+  m_server.handle("/", [timeout, idle, body_timeout, limiter, router](
+                           const nghttp2::asio_http2::server::request &req,
+                           const nghttp2::asio_http2::server::response &res) {
+    auto match = router->match(req.method(), req.uri().path);
+    if (!match) {
+      send_prepared(res, router::Router::not_found());
+      return;
+    }
+
+    // REFUSED_STREAM tells the client nothing was processed, so it can
+    // safely retry on another connection
+    auto connection = connection_id(req.remote_endpoint());
+    switch (limiter->admit(connection)) {
+    case ConnectionLimiter::Admission::Admitted:
+      break;
+    case ConnectionLimiter::Admission::ConnectionLimit:
+      limit_hit("connections");
+      res.cancel(NGHTTP2_REFUSED_STREAM);
+      return;
+    case ConnectionLimiter::Admission::StreamLimit:
+      limit_hit("streams");
+      res.cancel(NGHTTP2_REFUSED_STREAM);
       return;
+    case ConnectionLimiter::Admission::Closed:
+      obs::counter("http2.server.drain_refused").inc();
+      res.cancel(NGHTTP2_REFUSED_STREAM);
+      return;
+    }
+
+    // A connection's streams all run on its one io thread, so the count
+    // read back here is exact
+    if constexpr (telemetry::kEnabled) {
+      size_t open = limiter->streams(connection);
+      if (open == 1) {
+        telemetry::connection_active(connection);
+      }
+      telemetry::stream_opened(open);
     }
 
     auto stream = std::make_shared<RequestStream>();
@@ -55,50 +283,179 @@ void NgHttp2Server::handle(const std::string &method, const std::string &path,
       stream->query_params =
           utils::Url::parse_query_string(req.uri().raw_query);
     }
-    for (const auto &h : req.header()) {
-      stream->headers[h.first] = h.second.value;
+    stream->match = std::move(*match);
+
+    // Read what the server itself needs straight from nghttp2's map; the
+    // one copy into a HeaderBlock is what outlives this callback
+    utils::HeaderView incoming(req.header());
+    stream->headers = incoming.to_block();
+    if constexpr (telemetry::kEnabled) {
+      size_t bytes = 0;
+      for (const auto &[name, value] : stream->headers) {
+        bytes += name.size() + value.size();
+      }
+      telemetry::request_header_bytes(bytes);
+    }
+
+    // A declared length lets the body land in one slice; the cap in
+    // RequestBody::reserve keeps a lying peer from reserving much
+    auto value = incoming.get(utils::header::kContentLength);
+    if (!value.empty()) {
+      size_t expected = 0;
+      auto [end, ec] =
+          std::from_chars(value.data(), value.data() + value.size(), expected);
+      if (ec == std::errc() && end == value.data() + value.size()) {
+        stream->body.reserve(expected);
+      }
     }
-    stream->handler = handler;
 
+    // The budget starts when the headers arrive; a caller's grpc-timeout
+    // can only tighten it
+    if (timeout.count() > 0) {
+      stream->deadline = utils::Deadline::after(timeout);
+    }
+    auto caller_timeout = incoming.get(utils::header::kGrpcTimeout);
+    if (!caller_timeout.empty()) {
+      if (auto budget = utils::Deadline::parse_grpc_timeout(caller_timeout)) {
+        stream->deadline =
+            stream->deadline.earliest(utils::Deadline::after(*budget));
+      }
+    }
+
+    // The writer only calls back on the io thread while the stream is
+    // open, and the stream state outlives that through on_close
+    auto *state = stream.get();
     auto &io_ctx = res.io_service();
     stream->response_writer = std::make_shared<Http2ResponseWriter>(
-        [&res](int status, std::map<std::string, std::string> headers,
-               std::string body) {
-          nghttp2::asio_http2::header_map h;
-          for (const auto &[k, v] : headers) {
-            h.emplace(k, nghttp2::asio_http2::header_value{v, false});
-          }
-
-          res.write_head(status, h);
+        [&res, state](int status, astra::utils::HeaderBlock headers,
+                      std::string body) {
+          state->response_started = true;
+          state->timer.response_started();
+          telemetry::response_body_bytes(body.size());
+          res.write_head(status, to_header_map(headers));
           res.end(std::move(body));
         },
 
         [&io_ctx](std::function<void()> work) {
           boost::asio::post(io_ctx, std::move(work));
+        },
+
+        // nghttp2 only calls the generator when the flow control window
+        // has room, so a slow reader stalls the pull rather than growing
+        // a buffer here
+        [&res, state](int status, astra::utils::HeaderBlock headers,
+                      Http2ResponseWriter::Pull pull) {
+          state->response_started = true;
+          state->timer.response_started();
+          res.write_head(status, to_header_map(headers));
+          res.end([pull = std::move(pull)](uint8_t *buf, std::size_t len,
+                                           uint32_t *data_flags) -> ssize_t {
+            auto pulled = pull(buf, len);
+            switch (pulled.state) {
+            case Http2ResponseWriter::Pulled::State::Wait:
+              return NGHTTP2_ERR_DEFERRED;
+            case Http2ResponseWriter::Pulled::State::End:
+              *data_flags |= NGHTTP2_DATA_FLAG_EOF;
+              break;
+            case Http2ResponseWriter::Pulled::State::Data:
+              break;
+            }
+            telemetry::response_body_bytes(pulled.size);
+            return static_cast<ssize_t>(pulled.size);
+          });
+        },
+
+        [&res]() {
+          res.resume();
+        },
+
+        [&res, state](const std::shared_ptr<const router::PreparedResponse>
+                          &prepared) {
+          state->response_started = true;
+          state->timer.response_started();
+          telemetry::response_body_bytes(prepared->body().size());
+          send_prepared(res, prepared);
+        },
+
+        [&io_ctx]() {
+          return io_ctx.get_executor().running_in_this_thread();
         });
 
     const_cast<nghttp2::asio_http2::server::response &>(res).on_close(
-        [response_writer = stream->response_writer](uint32_t error_code) {
-          response_writer->mark_closed();
+        [stream, limiter, connection](uint32_t error_code) {
+          stream->closed = true;
+          if (stream->idle_timer) {
+            stream->idle_timer->cancel();
+          }
+          if (stream->deadline_timer) {
+            stream->deadline_timer->cancel();
+          }
+          if (limiter->release(connection) == 0) {
+            telemetry::connection_idle(connection);
+          }
+          stream->response_writer->mark_closed();
+          stream->timer.finish();
+          telemetry::stream_closed(error_code);
           if (error_code != 0) {
             obs::debug("Stream closed with error code: " +
                        std::to_string(error_code));
           }
         });
 
+    if (idle.count() > 0) {
+      stream->idle_timer = std::make_unique<boost::asio::steady_timer>(io_ctx);
+      stream->last_activity = std::chrono::steady_clock::now();
+      watch_idle(stream, res, idle);
+    }
+
+    // Until the body is in, the tighter of the body and request budgets
+    // applies; after that only the request's
+    auto body_deadline = stream->deadline;
+    if (body_timeout.count() > 0) {
+      body_deadline =
+          body_deadline.earliest(utils::Deadline::after(body_timeout));
+    }
+    if (body_deadline.is_set()) {
+      stream->deadline_timer =
+          std::make_unique<boost::asio::steady_timer>(io_ctx);
+      watch_deadline(stream, res, body_deadline.when());
+    }
+
     const_cast<nghttp2::asio_http2::server::request &>(req).on_data(
-        [stream](const uint8_t *data, std::size_t len) {
+        [stream, router, &res](const uint8_t *data, std::size_t len) {
+          // Already answered 408; the rest of the body is discarded
+          if (stream->timed_out) {
+            return;
+          }
+          if (stream->idle_timer) {
+            stream->last_activity = std::chrono::steady_clock::now();
+          }
           if (len > 0) {
             stream->body.append(reinterpret_cast<const char *>(data), len);
+            telemetry::request_body_bytes(len);
           } else {
+            stream->body_complete = true;
+            stream->timer.body_complete();
+            if (stream->idle_timer) {
+              stream->idle_timer->cancel();
+            }
+            if (stream->deadline_timer) {
+              if (stream->deadline.is_set()) {
+                watch_deadline(stream, res, stream->deadline.when());
+              } else {
+                stream->deadline_timer->cancel();
+              }
+            }
             auto request = std::make_shared<Http2Request>(
                 std::move(stream->method), std::move(stream->path),
                 std::move(stream->headers), std::move(stream->body),
                 std::move(stream->query_params));
+            request->set_deadline(stream->deadline);
             auto response =
                 std::make_shared<Http2Response>(stream->response_writer);
 
-            stream->handler(request, response);
+            router->dispatch(std::move(stream->match), std::move(request),
+                             std::move(response));
           }
         });
   });
@@ -117,7 +474,24 @@ astra::outcome::Result<void, Http2ServerError> NgHttp2Server::start() {
 
   boost::system::error_code ec;
 
-  if (m_server.listen_and_serve(ec, address, port, true)) {
+  if (m_config.tls().enabled()) {
+    auto configured =
+        astra::tls::configure_server(m_tls, tls_options(m_config.tls()));
+    if (configured.is_err()) {
+      obs::error("Server TLS setup failed",
+                 {{"error", astra::tls::to_string(configured.error())}});
+      return astra::outcome::Result<void, Http2ServerError>::Err(
+          Http2ServerError::TlsSetupFailed);
+    }
+    if (m_config.tls().handshake_timeout_ms() > 0) {
+      m_server.tls_handshake_timeout(boost::posix_time::milliseconds(
+          m_config.tls().handshake_timeout_ms()));
+    }
+  }
+
+  if (m_config.tls().enabled()
+          ? m_server.listen_and_serve(ec, m_tls, address, port, true)
+          : m_server.listen_and_serve(ec, address, port, true)) {
     obs::error("Server failed to start: " + ec.message());
     return astra::outcome::Result<void, Http2ServerError>::Err(
         Http2ServerError::BindFailed);
@@ -140,15 +514,43 @@ astra::outcome::Result<void, Http2ServerError> NgHttp2Server::join() {
   return astra::outcome::Result<void, Http2ServerError>::Ok();
 }
 
-astra::outcome::Result<void, Http2ServerError> NgHttp2Server::stop() {
+// nghttp2-asio cannot send GOAWAY or close its acceptor on its own, so the
+// drain refuses each new stream with REFUSED_STREAM instead. That carries
+// the same promise as GOAWAY's last-stream-id: the request was never seen
+// and the client may retry it on another connection.
+astra::outcome::Result<DrainReport, Http2ServerError> NgHttp2Server::stop() {
   if (!m_is_running.load(std::memory_order_acquire)) {
-    return astra::outcome::Result<void, Http2ServerError>::Err(
+    return astra::outcome::Result<DrainReport, Http2ServerError>::Err(
         Http2ServerError::NotStarted);
   }
+  if (m_is_stopping.exchange(true, std::memory_order_acq_rel)) {
+    return astra::outcome::Result<DrainReport, Http2ServerError>::Ok({});
+  }
+
+  m_limiter.close();
+  const size_t in_flight = m_limiter.streams();
+  const auto timeout = std::chrono::milliseconds(m_config.drain_timeout_ms());
+  if (in_flight > 0 && timeout.count() > 0) {
+    obs::info("Server draining",
+              {{"streams", std::to_string(in_flight)},
+               {"timeout_ms", std::to_string(timeout.count())}});
+    m_limiter.wait_idle(std::chrono::steady_clock::now() + timeout);
+  }
+
+  // Nothing is admitted once closed, so whatever left the count finished
+  DrainReport report;
+  report.aborted = m_limiter.streams();
+  report.drained = in_flight - std::min(in_flight, report.aborted);
+  obs::counter("http2.server.drain_streams")
+      .inc(report.drained, {{"outcome", "drained"}});
+  obs::counter("http2.server.drain_streams")
+      .inc(report.aborted, {{"outcome", "aborted"}});
 
   m_server.stop();
-  obs::info("Server stop requested");
-  return astra::outcome::Result<void, Http2ServerError>::Ok();
+  obs::info("Server stop requested",
+            {{"drained", std::to_string(report.drained)},
+             {"aborted", std::to_string(report.aborted)}});
+  return astra::outcome::Result<DrainReport, Http2ServerError>::Ok(report);
 }
 
 } // namespace astra::http2
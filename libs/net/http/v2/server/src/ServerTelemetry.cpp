@@ -0,0 +1,135 @@
+#include "ServerTelemetry.h"
+
+#ifdef ASTRA_HTTP2_TELEMETRY
+
+#include <Log.h>
+#include <MetricsRegistry.h>
+#include <string>
+
+namespace astra::http2::telemetry {
+
+namespace {
+
+// Handles are looked up once; recording is then a call on a 4-byte id
+struct Handles {
+  Handles() {
+    registry
+        .gauge("connections", "http2.server.connections.active")
+        .gauge("streams", "http2.server.streams.active")
+        .histogram("streams_per_connection",
+                   "http2.server.streams.per_connection",
+                   obs::Unit::Dimensionless)
+        .counter("stream_resets", "http2.server.streams.reset")
+        .counter("header_bytes", "http2.server.request.header_bytes",
+                 obs::Unit::Bytes)
+        .counter("body_bytes_in", "http2.server.request.body_bytes",
+                 obs::Unit::Bytes)
+        .counter("body_bytes_out", "http2.server.response.body_bytes",
+                 obs::Unit::Bytes)
+        .counter("stalls", "http2.server.flow_control.stalls")
+        .histogram("body_phase", "http2.server.phase.body")
+        .histogram("handler_phase", "http2.server.phase.handler")
+        .histogram("write_phase", "http2.server.phase.write")
+        .histogram("total", "http2.server.phase.total");
+
+    connections = registry.gauge("connections");
+    streams = registry.gauge("streams");
+    streams_per_connection = registry.histogram("streams_per_connection");
+    stream_resets = registry.counter("stream_resets");
+    header_bytes = registry.counter("header_bytes");
+    body_bytes_in = registry.counter("body_bytes_in");
+    body_bytes_out = registry.counter("body_bytes_out");
+    stalls = registry.counter("stalls");
+    body_phase = registry.histogram("body_phase");
+    handler_phase = registry.histogram("handler_phase");
+    write_phase = registry.histogram("write_phase");
+    total = registry.histogram("total");
+  }
+
+  obs::MetricsRegistry registry;
+  obs::Gauge connections;
+  obs::Gauge streams;
+  obs::Histogram streams_per_connection;
+  obs::Counter stream_resets;
+  obs::Counter header_bytes;
+  obs::Counter body_bytes_in;
+  obs::Counter body_bytes_out;
+  obs::Counter stalls;
+  obs::Histogram body_phase;
+  obs::Histogram handler_phase;
+  obs::Histogram write_phase;
+  obs::Histogram total;
+};
+
+const Handles &handles() {
+  static const Handles instance;
+  return instance;
+}
+
+double ms_between(std::chrono::steady_clock::time_point from,
+                  std::chrono::steady_clock::time_point to) {
+  return std::chrono::duration<double, std::milli>(to - from).count();
+}
+
+} // namespace
+
+void connection_active(uint64_t connection) {
+  handles().connections.add(1);
+  obs::debug("HTTP/2 connection active",
+             {{"connection", std::to_string(connection)}});
+}
+
+void connection_idle(uint64_t connection) {
+  handles().connections.add(-1);
+  obs::debug("HTTP/2 connection idle",
+             {{"connection", std::to_string(connection)}});
+}
+
+void stream_opened(size_t open) {
+  handles().streams.add(1);
+  handles().streams_per_connection.record(static_cast<double>(open));
+}
+
+void stream_closed(uint32_t error_code) {
+  handles().streams.add(-1);
+  if (error_code != 0) {
+    handles().stream_resets.inc();
+  }
+}
+
+void request_header_bytes(size_t bytes) {
+  handles().header_bytes.inc(bytes);
+}
+
+void request_body_bytes(size_t bytes) {
+  handles().body_bytes_in.inc(bytes);
+}
+
+void response_body_bytes(size_t bytes) {
+  handles().body_bytes_out.inc(bytes);
+}
+
+void flow_control_stall() {
+  handles().stalls.inc();
+}
+
+void StreamTimer::finish() const {
+  const auto now = std::chrono::steady_clock::now();
+  const auto &h = handles();
+  const std::chrono::steady_clock::time_point unset{};
+
+  h.total.record(ms_between(m_headers, now));
+  if (m_body == unset) {
+    return;
+  }
+  h.body_phase.record(ms_between(m_headers, m_body));
+  if (m_response == unset) {
+    return;
+  }
+  h.handler_phase.record(ms_between(m_body, m_response));
+  h.write_phase.record(ms_between(m_response, now));
+}
+
+} // namespace astra::http2::telemetry
+
+#endif
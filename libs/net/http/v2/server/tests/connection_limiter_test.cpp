@@ -0,0 +1,144 @@
+#include "ConnectionLimiter.h"
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using astra::http2::ConnectionLimiter;
+using Admission = ConnectionLimiter::Admission;
+
+TEST(ConnectionLimiterTest, CapsStreamsPerConnection) {
+  ConnectionLimiter limiter(0, 2);
+
+  EXPECT_EQ(limiter.admit(1), Admission::Admitted);
+  EXPECT_EQ(limiter.admit(1), Admission::Admitted);
+  EXPECT_EQ(limiter.admit(1), Admission::StreamLimit);
+  EXPECT_EQ(limiter.admit(2), Admission::Admitted);
+
+  limiter.release(1);
+  EXPECT_EQ(limiter.admit(1), Admission::Admitted);
+}
+
+TEST(ConnectionLimiterTest, CapsActiveConnections) {
+  ConnectionLimiter limiter(2, 0);
+
+  EXPECT_EQ(limiter.admit(1), Admission::Admitted);
+  EXPECT_EQ(limiter.admit(2), Admission::Admitted);
+  EXPECT_EQ(limiter.admit(3), Admission::ConnectionLimit);
+  // Known connections can still open streams
+  EXPECT_EQ(limiter.admit(2), Admission::Admitted);
+  EXPECT_EQ(limiter.connections(), 2u);
+}
+
+TEST(ConnectionLimiterTest, ConnectionSlotFreedWithLastStream) {
+  ConnectionLimiter limiter(1, 0);
+
+  ASSERT_EQ(limiter.admit(1), Admission::Admitted);
+  ASSERT_EQ(limiter.admit(1), Admission::Admitted);
+  limiter.release(1);
+  EXPECT_EQ(limiter.admit(2), Admission::ConnectionLimit);
+
+  limiter.release(1);
+  EXPECT_EQ(limiter.connections(), 0u);
+  EXPECT_EQ(limiter.admit(2), Admission::Admitted);
+}
+
+TEST(ConnectionLimiterTest, ZeroMeansUnlimited) {
+  ConnectionLimiter limiter(0, 0);
+  for (uint64_t i = 0; i < 1000; ++i) {
+    EXPECT_EQ(limiter.admit(i % 10), Admission::Admitted);
+  }
+  EXPECT_EQ(limiter.streams(3), 100u);
+}
+
+TEST(ConnectionLimiterTest, ReleaseReportsStreamsLeft) {
+  ConnectionLimiter limiter(0, 0);
+  ASSERT_EQ(limiter.admit(1), Admission::Admitted);
+  ASSERT_EQ(limiter.admit(1), Admission::Admitted);
+
+  EXPECT_EQ(limiter.release(1), 1u);
+  EXPECT_EQ(limiter.release(1), 0u);
+  EXPECT_EQ(limiter.release(1), 0u); // Unknown connection
+}
+
+TEST(ConnectionLimiterTest, ClosedAdmitsNothing) {
+  ConnectionLimiter limiter(0, 0);
+
+  ASSERT_EQ(limiter.admit(1), Admission::Admitted);
+  limiter.close();
+  EXPECT_EQ(limiter.admit(1), Admission::Closed);
+  EXPECT_EQ(limiter.admit(2), Admission::Closed);
+  EXPECT_EQ(limiter.streams(), 1u);
+}
+
+TEST(ConnectionLimiterTest, WaitIdleReturnsWhenLastStreamReleased) {
+  ConnectionLimiter limiter(0, 0);
+  ASSERT_EQ(limiter.admit(1), Admission::Admitted);
+  ASSERT_EQ(limiter.admit(2), Admission::Admitted);
+  limiter.close();
+
+  std::thread releaser([&limiter] {
+    limiter.release(1);
+    limiter.release(2);
+  });
+  EXPECT_TRUE(limiter.wait_idle(std::chrono::steady_clock::now() +
+                                std::chrono::seconds(5)));
+  releaser.join();
+  EXPECT_EQ(limiter.streams(), 0u);
+}
+
+TEST(ConnectionLimiterTest, WaitIdleTimesOutWithOpenStreams) {
+  ConnectionLimiter limiter(0, 0);
+  ASSERT_EQ(limiter.admit(1), Admission::Admitted);
+
+  EXPECT_FALSE(limiter.wait_idle(std::chrono::steady_clock::now() +
+                                 std::chrono::milliseconds(10)));
+  EXPECT_EQ(limiter.streams(), 1u);
+}
+
+TEST(ConnectionLimiterTest, ConcurrentConnectionsNeverExceedCap) {
+  ConnectionLimiter limiter(8, 2);
+  std::atomic<size_t> max_seen{0};
+
+  auto worker = [&](uint64_t first) {
+    for (int i = 0; i < 2000; ++i) {
+      uint64_t connection = first + (i % 4);
+      if (limiter.admit(connection) != Admission::Admitted) {
+        continue;
+      }
+      size_t now = limiter.connections();
+      size_t seen = max_seen.load();
+      while (now > seen && !max_seen.compare_exchange_weak(seen, now)) {
+      }
+      limiter.release(connection);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (uint64_t t = 0; t < 8; ++t) {
+    threads.emplace_back(worker, t * 100);
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+
+  EXPECT_LE(max_seen.load(), 8u);
+  EXPECT_EQ(limiter.connections(), 0u);
+  EXPECT_EQ(limiter.streams(), 0u);
+}
+
+TEST(ConnectionLimiterTest, RefusalsLeaveNothingBehind) {
+  ConnectionLimiter limiter(1, 1);
+  ASSERT_EQ(limiter.admit(1), Admission::Admitted);
+
+  EXPECT_EQ(limiter.admit(2), Admission::ConnectionLimit);
+  EXPECT_EQ(limiter.admit(1), Admission::StreamLimit);
+  EXPECT_EQ(limiter.streams(), 1u);
+  EXPECT_EQ(limiter.connections(), 1u);
+
+  limiter.close();
+  EXPECT_EQ(limiter.admit(3), Admission::Closed);
+  limiter.release(1);
+  EXPECT_TRUE(limiter.wait_idle(std::chrono::steady_clock::now()));
+}
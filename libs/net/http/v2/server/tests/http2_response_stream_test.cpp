@@ -0,0 +1,147 @@
+#include "Http2Response.h"
+#include "Http2ResponseStream.h"
+#include "Http2ResponseWriter.h"
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+using namespace astra::http2;
+using State = Http2ResponseWriter::Pulled::State;
+
+class Http2ResponseStreamTest : public ::testing::Test {
+protected:
+  boost::asio::io_context io_ctx;
+  int started_status = -1;
+  astra::utils::HeaderBlock started_headers;
+  Http2ResponseWriter::Pull pull;
+  int resumes = 0;
+
+  std::shared_ptr<Http2ResponseWriter> make_writer() {
+    return std::make_shared<Http2ResponseWriter>(
+        [](int, astra::utils::HeaderBlock, std::string) {
+        },
+        [this](std::function<void()> work) {
+          boost::asio::post(io_ctx, std::move(work));
+        },
+        [this](int status, astra::utils::HeaderBlock headers,
+               Http2ResponseWriter::Pull p) {
+          started_status = status;
+          started_headers = std::move(headers);
+          pull = std::move(p);
+        },
+        [this]() {
+          ++resumes;
+        });
+  }
+
+  // Drains like nghttp2 would, `window` bytes per call
+  std::string drain(size_t window, State &last) {
+    std::string out;
+    std::vector<uint8_t> buf(window);
+    do {
+      auto pulled = pull(buf.data(), buf.size());
+      out.append(reinterpret_cast<char *>(buf.data()), pulled.size);
+      last = pulled.state;
+    } while (last == State::Data);
+    return out;
+  }
+};
+
+TEST_F(Http2ResponseStreamTest, SendsHeadersBeforeBody) {
+  auto writer = make_writer();
+  Http2Response res(writer);
+  res.set_status(201);
+  res.set_header("content-type", "application/x-ndjson");
+
+  auto stream = res.start_stream();
+  ASSERT_NE(stream, nullptr);
+  io_ctx.run();
+
+  EXPECT_EQ(started_status, 201);
+  EXPECT_EQ(started_headers["content-type"], "application/x-ndjson");
+  ASSERT_TRUE(pull);
+}
+
+TEST_F(Http2ResponseStreamTest, ChunksSplitAcrossSmallWindows) {
+  auto writer = make_writer();
+  Http2Response res(writer);
+  auto stream = res.start_stream();
+  io_ctx.run();
+
+  stream->write("hello ");
+  stream->write("streaming ");
+  stream->write("world");
+  stream->finish();
+
+  State last;
+  EXPECT_EQ(drain(4, last), "hello streaming world");
+  EXPECT_EQ(last, State::End);
+}
+
+TEST_F(Http2ResponseStreamTest, EmptyBufferParksUntilNextWrite) {
+  auto writer = make_writer();
+  auto stream = std::make_shared<Http2ResponseStream>(writer);
+  auto p = stream->puller();
+
+  uint8_t buf[16];
+  EXPECT_EQ(p(buf, sizeof(buf)).state, State::Wait);
+
+  stream->write("x");
+  io_ctx.run();
+  EXPECT_EQ(resumes, 1);
+
+  // Not parked any more, so a second write does not resume again
+  stream->write("y");
+  io_ctx.restart();
+  io_ctx.run();
+  EXPECT_EQ(resumes, 1);
+}
+
+TEST_F(Http2ResponseStreamTest, BackpressureReleasedBelowLowWater) {
+  auto writer = make_writer();
+  auto stream = std::make_shared<Http2ResponseStream>(writer, 8);
+  auto p = stream->puller();
+  int writable = 0;
+  stream->on_writable([&writable]() {
+    ++writable;
+  });
+
+  EXPECT_TRUE(stream->write("1234"));
+  EXPECT_FALSE(stream->write("5678")); // Reached the high-water mark
+  EXPECT_EQ(stream->buffered(), 8u);
+
+  uint8_t buf[3];
+  p(buf, sizeof(buf)); // 5 left, still above half
+  EXPECT_EQ(writable, 0);
+  p(buf, sizeof(buf)); // 2 left
+  EXPECT_EQ(writable, 1);
+  p(buf, sizeof(buf));
+  EXPECT_EQ(writable, 1);
+}
+
+TEST_F(Http2ResponseStreamTest, WritesFailOnceStreamClosed) {
+  auto writer = make_writer();
+  auto stream = std::make_shared<Http2ResponseStream>(writer);
+
+  writer->mark_closed();
+
+  EXPECT_FALSE(stream->is_alive());
+  EXPECT_FALSE(stream->write("late"));
+}
+
+TEST_F(Http2ResponseStreamTest, NotAvailableWithoutStreamingTransport) {
+  auto writer = std::make_shared<Http2ResponseWriter>(
+      [](int, astra::utils::HeaderBlock, std::string) {
+      },
+      [](std::function<void()> work) {
+        work();
+      });
+  Http2Response res(writer);
+
+  EXPECT_EQ(res.start_stream(), nullptr);
+  res.set_status(200);
+  res.close(); // Buffered path still usable
+}
@@ -15,7 +15,7 @@ class Http2ResponseWriterTest : public ::testing::Test {
 protected:
   boost::asio::io_context io_ctx;
   int captured_status = -1;
-  std::map<std::string, std::string> captured_headers;
+  astra::utils::HeaderBlock captured_headers;
   std::string captured_body;
   bool send_called = false;
 
@@ -27,7 +27,7 @@ protected:
   }
 
   auto make_send_fn() {
-    return [this](int status, std::map<std::string, std::string> headers,
+    return [this](int status, astra::utils::HeaderBlock headers,
                   std::string body) {
       captured_status = status;
       captured_headers = std::move(headers);
@@ -148,7 +148,7 @@ TEST_F(Http2ResponseWriterTest, IsAliveFalseAfterClose) {
 TEST_F(Http2ResponseWriterTest, ConcurrentSends) {
   // Test multiple worker threads sending through same handle
   auto handle = std::make_shared<Http2ResponseWriter>(
-      [](int, std::map<std::string, std::string>,
+      [](int, astra::utils::HeaderBlock,
          std::string) { /* no-op for this test */ },
       make_post_work());
 
@@ -283,6 +283,32 @@ TEST_F(Http2ResponseWriterTest, ScopedResourceReleasedInReverseOrder) {
   EXPECT_EQ(destruction_order[2], 3);
 }
 
+namespace {
+struct CountingOwner : astra::resilience::LoadShedderGuard::Owner {
+  int released = 0;
+
+  void release(uint32_t /*token*/) noexcept override {
+    ++released;
+  }
+};
+} // namespace
+
+TEST_F(Http2ResponseWriterTest, GuardsReleasedOnDestruction) {
+  CountingOwner owner;
+
+  {
+    auto handle =
+        std::make_shared<Http2ResponseWriter>(make_send_fn(), make_post_work());
+    // One more than fits inline, so the spill path is covered too
+    for (int i = 0; i < 3; ++i) {
+      handle->add_guard(astra::resilience::LoadShedderGuard::create(owner));
+    }
+    EXPECT_EQ(owner.released, 0);
+  }
+
+  EXPECT_EQ(owner.released, 3);
+}
+
 // =============================================================================
 // Edge Cases and SEDA Pattern Tests
 // =============================================================================
@@ -304,7 +330,7 @@ TEST_F(Http2ResponseWriterTest, SendWithEmptyData) {
 TEST_F(Http2ResponseWriterTest, MultipleSendsAllowed) {
   int send_count = 0;
   auto handle = std::make_shared<Http2ResponseWriter>(
-      [&send_count](int, std::map<std::string, std::string>, std::string) {
+      [&send_count](int, astra::utils::HeaderBlock, std::string) {
         send_count++;
       },
       make_post_work());
@@ -386,7 +412,7 @@ TEST_F(Http2ResponseWriterTest, SendWithManyHeaders) {
   auto handle =
       std::make_shared<Http2ResponseWriter>(make_send_fn(), make_post_work());
 
-  std::map<std::string, std::string> many_headers;
+  astra::utils::HeaderBlock many_headers;
   for (int i = 0; i < 100; ++i) {
     many_headers["X-Header-" + std::to_string(i)] =
         "value-" + std::to_string(i);
@@ -430,7 +456,7 @@ TEST_F(Http2ResponseWriterTest, DelayedSendAfterCreation) {
 TEST_F(Http2ResponseWriterTest, ConcurrentCloseAndSend) {
   // Race between close and send - should not crash
   auto handle = std::make_shared<Http2ResponseWriter>(
-      [](int, std::map<std::string, std::string>, std::string) {},
+      [](int, astra::utils::HeaderBlock, std::string) {},
       make_post_work());
 
   std::thread sender([handle]() {
@@ -457,3 +483,95 @@ TEST_F(Http2ResponseWriterTest, ConcurrentCloseAndSend) {
   // No crashes = success
   EXPECT_FALSE(handle->is_alive());
 }
+
+TEST_F(Http2ResponseWriterTest, SendPreparedSharesTheResponse) {
+  std::shared_ptr<const astra::router::PreparedResponse> sent;
+  auto handle = std::make_shared<Http2ResponseWriter>(
+      make_send_fn(), make_post_work(), nullptr, nullptr,
+      [&sent](const std::shared_ptr<const astra::router::PreparedResponse>
+                  &prepared) {
+        sent = prepared;
+      });
+  auto prepared = astra::router::PreparedResponse::create(404, {}, "missing");
+
+  handle->send_prepared(prepared);
+  io_ctx.run();
+
+  EXPECT_EQ(sent, prepared);
+  EXPECT_FALSE(send_called);
+}
+
+TEST_F(Http2ResponseWriterTest, SendPreparedFallsBackToSend) {
+  auto handle =
+      std::make_shared<Http2ResponseWriter>(make_send_fn(), make_post_work());
+
+  handle->send_prepared(
+      astra::router::PreparedResponse::create(503, {}, "overloaded"));
+  io_ctx.run();
+
+  EXPECT_TRUE(send_called);
+  EXPECT_EQ(captured_status, 503);
+  EXPECT_EQ(captured_headers.get("content-length"), "10");
+  EXPECT_EQ(captured_body, "overloaded");
+}
+
+TEST_F(Http2ResponseWriterTest, SendPreparedAfterCloseIsDropped) {
+  bool prepared_sent = false;
+  auto handle = std::make_shared<Http2ResponseWriter>(
+      make_send_fn(), make_post_work(), nullptr, nullptr,
+      [&prepared_sent](const auto &) {
+        prepared_sent = true;
+      });
+
+  handle->mark_closed();
+  handle->send_prepared(astra::router::PreparedResponse::create(200));
+  io_ctx.run();
+
+  EXPECT_FALSE(prepared_sent);
+}
+
+TEST_F(Http2ResponseWriterTest, SendOnIoThreadSkipsThePost) {
+  auto on_io_thread = [this]() {
+    return io_ctx.get_executor().running_in_this_thread();
+  };
+  auto handle = std::make_shared<Http2ResponseWriter>(
+      make_send_fn(), make_post_work(), nullptr, nullptr, nullptr,
+      on_io_thread);
+
+  // An inline route answers from inside the io thread's own callback
+  bool sent_before_return = false;
+  boost::asio::post(io_ctx, [&]() {
+    handle->send(200, {}, "inline");
+    sent_before_return = send_called;
+  });
+  io_ctx.run();
+
+  EXPECT_TRUE(sent_before_return);
+  EXPECT_EQ(captured_body, "inline");
+}
+
+TEST_F(Http2ResponseWriterTest, SendOffIoThreadIsPosted) {
+  auto handle = std::make_shared<Http2ResponseWriter>(
+      make_send_fn(), make_post_work(), nullptr, nullptr, nullptr,
+      [this]() {
+        return io_ctx.get_executor().running_in_this_thread();
+      });
+
+  handle->send(200, {}, "posted");
+  EXPECT_FALSE(send_called);
+
+  io_ctx.run();
+  EXPECT_TRUE(send_called);
+}
+
+TEST_F(Http2ResponseWriterTest, InlineSendAfterCloseIsDropped) {
+  auto handle = std::make_shared<Http2ResponseWriter>(
+      make_send_fn(), make_post_work(), nullptr, nullptr, nullptr, []() {
+        return true;
+      });
+
+  handle->mark_closed();
+  handle->send(200, {}, "dropped");
+
+  EXPECT_FALSE(send_called);
+}
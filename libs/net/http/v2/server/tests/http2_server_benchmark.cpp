@@ -3,12 +3,56 @@
 #include "Http2Server.h"
 #include "Router.h"
 
+#include <algorithm>
+#include <atomic>
 #include <benchmark/benchmark.h>
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <future>
 #include <memory>
+#include <new>
+#include <nghttp2/asio_http2_client.h>
+#include <string>
 #include <thread>
+#include <vector>
 
 using namespace astra::http2;
 
+// =============================================================================
+// Allocation Counting
+// =============================================================================
+
+namespace {
+
+std::atomic<uint64_t> g_allocations{0};
+std::atomic<uint64_t> g_server_allocations{0};
+// Set by the benchmark handler, so it marks the server's io threads
+thread_local bool t_server_thread = false;
+
+} // namespace
+
+void *operator new(std::size_t size) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (t_server_thread) {
+    g_server_allocations.fetch_add(1, std::memory_order_relaxed);
+  }
+  if (void *ptr = std::malloc(size > 0 ? size : 1)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+
 // =============================================================================
 // Router Dispatch Benchmarks (internal path through server)
 // =============================================================================
@@ -71,4 +115,279 @@ static void BM_ServerConstruction(benchmark::State &state) {
 }
 BENCHMARK(BM_ServerConstruction);
 
+// =============================================================================
+// Loopback Round Trips (nghttp2 parse -> handler -> writer -> wire)
+// =============================================================================
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+namespace h2client = nghttp2::asio_http2::client;
+
+constexpr size_t kWarmupRequests = 500;
+constexpr size_t kRequestsPerIteration = 2000;
+
+// Fresh port per server, so a run never trips over the last one's sockets
+uint16_t next_port() {
+  static std::atomic<uint16_t> port{19300};
+  return port.fetch_add(1);
+}
+
+// One h2 connection on its own client thread, kept busy closed-loop: each
+// answered request submits the next until the batch is done
+class LoopbackConnection {
+public:
+  explicit LoopbackConnection(uint16_t port)
+      : m_session(m_io, "127.0.0.1", std::to_string(port)),
+        m_work(boost::asio::make_work_guard(m_io)),
+        m_uri("http://127.0.0.1:" + std::to_string(port) + "/echo") {
+    auto ready = m_ready.get_future();
+    m_session.on_connect([this](auto) {
+      settle(true);
+    });
+    // A dropped connection fails whatever the batch had left, rather than
+    // leaving run_batch waiting on streams that will never close
+    m_session.on_error([this](const boost::system::error_code &) {
+      settle(false);
+      if (m_active) {
+        m_failed += m_outstanding + m_to_send;
+        m_outstanding = 0;
+        m_to_send = 0;
+        m_active = false;
+        m_done.set_value();
+      }
+    });
+    m_thread = std::thread([this] {
+      m_io.run();
+    });
+    m_connected = ready.get();
+  }
+
+  ~LoopbackConnection() {
+    boost::asio::post(m_io, [this] {
+      m_session.shutdown();
+    });
+    m_work.reset();
+    m_thread.join();
+  }
+
+  [[nodiscard]] bool connected() const {
+    return m_connected;
+  }
+
+  // Runs `count` requests, `streams` at a time, carrying `body`
+  std::future<void> start(size_t count, size_t streams,
+                          const std::string &body) {
+    m_done = std::promise<void>();
+    auto done = m_done.get_future();
+    boost::asio::post(m_io, [this, count, streams, &body] {
+      m_body = &body;
+      m_to_send = count;
+      m_active = true;
+      for (size_t i = 0; i < std::min(streams, count); ++i) {
+        submit_next();
+      }
+    });
+    return done;
+  }
+
+  // Only read between batches, once start()'s future is ready
+  std::vector<uint32_t> &latencies_us() {
+    return m_latencies_us;
+  }
+  [[nodiscard]] size_t failed() const {
+    return m_failed;
+  }
+
+private:
+  void settle(bool connected) {
+    if (!m_settled) {
+      m_settled = true;
+      m_ready.set_value(connected);
+    }
+  }
+
+  void submit_next() {
+    if (m_to_send == 0) {
+      return;
+    }
+    --m_to_send;
+    ++m_outstanding;
+
+    boost::system::error_code ec;
+    auto started = Clock::now();
+    const auto *req = m_body->empty()
+                          ? m_session.submit(ec, "GET", m_uri)
+                          : m_session.submit(ec, "POST", m_uri, *m_body);
+    if (!req) {
+      ++m_failed;
+      finish_one();
+      return;
+    }
+    req->on_response([this](const h2client::response &res) {
+      if (res.status_code() != 200) {
+        ++m_failed;
+      }
+      res.on_data([](const uint8_t *, std::size_t) {});
+    });
+    req->on_close([this, started](uint32_t error_code) {
+      if (error_code != 0) {
+        ++m_failed;
+      }
+      m_latencies_us.push_back(static_cast<uint32_t>(
+          std::chrono::duration_cast<std::chrono::microseconds>(
+              Clock::now() - started)
+              .count()));
+      finish_one();
+    });
+  }
+
+  void finish_one() {
+    if (!m_active) {
+      return;
+    }
+    --m_outstanding;
+    submit_next();
+    if (m_outstanding == 0 && m_to_send == 0) {
+      m_active = false;
+      m_done.set_value();
+    }
+  }
+
+  boost::asio::io_context m_io;
+  h2client::session m_session;
+  boost::asio::executor_work_guard<boost::asio::io_context::executor_type>
+      m_work;
+  std::string m_uri;
+  std::thread m_thread;
+  std::promise<bool> m_ready;
+  bool m_settled = false;
+  bool m_connected = false;
+
+  // Batch state; only touched on m_thread while a batch runs
+  const std::string *m_body = nullptr;
+  bool m_active = false;
+  size_t m_to_send = 0;
+  size_t m_outstanding = 0;
+  size_t m_failed = 0;
+  std::promise<void> m_done;
+  std::vector<uint32_t> m_latencies_us;
+};
+
+void run_batch(std::vector<std::unique_ptr<LoopbackConnection>> &connections,
+               size_t per_connection, size_t streams,
+               const std::string &body) {
+  std::vector<std::future<void>> batches;
+  batches.reserve(connections.size());
+  for (auto &connection : connections) {
+    batches.push_back(connection->start(per_connection, streams, body));
+  }
+  for (auto &batch : batches) {
+    batch.wait();
+  }
+}
+
+double percentile(const std::vector<uint32_t> &sorted, double p) {
+  if (sorted.empty()) {
+    return 0;
+  }
+  auto rank = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1));
+  return sorted[rank];
+}
+
+} // namespace
+
+// Args: server threads, body bytes each way, streams in flight per
+// connection. One client connection per server thread, since nghttp2-asio
+// pins a connection to one io thread. Latency is per request, headers out
+// to stream closed; the allocation counters cover the client too, except
+// server_allocs_per_req, which counts only the server's io threads.
+static void BM_ServerRoundTrip(benchmark::State &state) {
+  const auto threads = static_cast<size_t>(state.range(0));
+  const auto body_size = static_cast<size_t>(state.range(1));
+  const auto streams = static_cast<size_t>(state.range(2));
+
+  const uint16_t port = next_port();
+  ServerConfig config;
+  config.set_address("127.0.0.1");
+  config.set_port(port);
+  config.set_thread_count(static_cast<uint32_t>(threads));
+  Http2Server server(config);
+
+  auto echo = [](std::shared_ptr<astra::router::IRequest> req,
+                 std::shared_ptr<astra::router::IResponse> res) {
+    t_server_thread = true;
+    res->set_status(200);
+    res->write(std::string(req->body_view()));
+    res->close();
+  };
+  server.handle("GET", "/echo", echo);
+  server.handle("POST", "/echo", echo);
+  if (server.start().is_err()) {
+    state.SkipWithError("server failed to start");
+    return;
+  }
+
+  std::vector<std::unique_ptr<LoopbackConnection>> connections;
+  for (size_t i = 0; i < threads; ++i) {
+    connections.push_back(std::make_unique<LoopbackConnection>(port));
+    if (!connections.back()->connected()) {
+      state.SkipWithError("client failed to connect");
+      connections.clear();
+      server.stop();
+      server.join();
+      return;
+    }
+  }
+
+  const std::string body(body_size, 'x');
+  run_batch(connections, kWarmupRequests, streams, body);
+  for (auto &connection : connections) {
+    connection->latencies_us().clear();
+  }
+
+  const uint64_t allocations = g_allocations.load();
+  const uint64_t server_allocations = g_server_allocations.load();
+  size_t requests = 0;
+  for (auto _ : state) {
+    run_batch(connections, kRequestsPerIteration, streams, body);
+    requests += kRequestsPerIteration * connections.size();
+  }
+  const auto allocated =
+      static_cast<double>(g_allocations.load() - allocations);
+  const auto server_allocated =
+      static_cast<double>(g_server_allocations.load() - server_allocations);
+
+  std::vector<uint32_t> latencies;
+  size_t failed = 0;
+  for (auto &connection : connections) {
+    auto &own = connection->latencies_us();
+    latencies.insert(latencies.end(), own.begin(), own.end());
+    failed += connection->failed();
+  }
+  std::sort(latencies.begin(), latencies.end());
+
+  state.SetItemsProcessed(static_cast<int64_t>(requests));
+  state.SetBytesProcessed(static_cast<int64_t>(requests * body_size * 2));
+  state.counters["p50_us"] = percentile(latencies, 0.50);
+  state.counters["p99_us"] = percentile(latencies, 0.99);
+  state.counters["p999_us"] = percentile(latencies, 0.999);
+  state.counters["failed"] = static_cast<double>(failed);
+  if (requests > 0) {
+    state.counters["allocs_per_req"] =
+        allocated / static_cast<double>(requests);
+    state.counters["server_allocs_per_req"] =
+        server_allocated / static_cast<double>(requests);
+  }
+
+  connections.clear();
+  server.stop();
+  server.join();
+}
+BENCHMARK(BM_ServerRoundTrip)
+    ->ArgNames({"threads", "body", "streams"})
+    ->ArgsProduct({{1, 2, 4}, {0, 1024, 16384}, {1, 16, 64}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
 BENCHMARK_MAIN();
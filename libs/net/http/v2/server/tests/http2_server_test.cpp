@@ -3,9 +3,11 @@
 #include "Http2Server.h"
 
 #include <atomic>
+#include <boost/asio/steady_timer.hpp>
 #include <chrono>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <nghttp2/asio_http2_client.h>
 #include <thread>
 
 using namespace testing;
@@ -23,6 +25,46 @@ astra::http2::ServerConfig make_config(const std::string &address,
   return config;
 }
 
+// One request over a bare nghttp2 session; returns the response status, or
+// 0 when none arrives within `wait`. A `body` generator makes it a POST.
+int exchange(uint32_t port, const std::string &path,
+             nghttp2::asio_http2::generator_cb body = nullptr,
+             std::chrono::milliseconds wait = 2s) {
+  boost::asio::io_service io;
+  nghttp2::asio_http2::client::session session(io, "127.0.0.1",
+                                               std::to_string(port));
+  boost::asio::steady_timer guard(io, wait);
+  int status = 0;
+
+  session.on_connect([&](auto) {
+    boost::system::error_code ec;
+    auto uri = "http://127.0.0.1:" + std::to_string(port) + path;
+    const auto *req = body ? session.submit(ec, "POST", uri, body)
+                           : session.submit(ec, "GET", uri);
+    if (!req) {
+      session.shutdown();
+      return;
+    }
+    req->on_response([&](const nghttp2::asio_http2::client::response &res) {
+      status = res.status_code();
+    });
+    req->on_close([&](uint32_t) {
+      guard.cancel();
+      session.shutdown();
+    });
+  });
+  session.on_error([&](const boost::system::error_code &) {
+    guard.cancel();
+  });
+  guard.async_wait([&](const boost::system::error_code &ec) {
+    if (!ec) {
+      session.shutdown();
+    }
+  });
+  io.run();
+  return status;
+}
+
 } // namespace
 
 // =============================================================================
@@ -256,6 +298,21 @@ TEST_F(Http2ServerRuntimeTest, DoubleStopIsIdempotent) {
   server_thread_.join();
 }
 
+TEST_F(Http2ServerRuntimeTest, StopWithNothingInFlightDrainsNothing) {
+  auto start_result = server_->start();
+  ASSERT_TRUE(start_result.is_ok());
+
+  server_thread_ = std::thread([this] {
+    server_->join();
+  });
+
+  auto stop_result = server_->stop();
+  ASSERT_TRUE(stop_result.is_ok());
+  EXPECT_EQ(stop_result.value().drained, 0u);
+  EXPECT_EQ(stop_result.value().aborted, 0u);
+  server_thread_.join();
+}
+
 TEST_F(Http2ServerRuntimeTest, StopBeforeStartReturnsError) {
   auto result = server_->stop();
   EXPECT_TRUE(result.is_err());
@@ -280,6 +337,18 @@ TEST_F(Http2ServerRuntimeTest, DoubleStartReturnsError) {
   server_->stop();
 }
 
+TEST(Http2ServerTlsTest, StartFailsWithoutUsableCertificate) {
+  auto config = make_config("127.0.0.1", 9211);
+  config.mutable_tls()->set_enabled(true);
+  config.mutable_tls()->set_cert_file("/nonexistent/cert.pem");
+  config.mutable_tls()->set_key_file("/nonexistent/key.pem");
+  astra::http2::Http2Server server(config);
+
+  auto result = server.start();
+  ASSERT_TRUE(result.is_err());
+  EXPECT_EQ(result.error(), astra::http2::Http2ServerError::TlsSetupFailed);
+}
+
 TEST_F(Http2ServerRuntimeTest, HandlerRegistrationBeforeStart) {
   server_->handle("GET", "/test", [](auto, auto res) {
     res->set_status(200);
@@ -299,3 +368,62 @@ TEST_F(Http2ServerRuntimeTest, HandlerRegistrationBeforeStart) {
 
   SUCCEED();
 }
+
+// =============================================================================
+// Deadline Tests
+// =============================================================================
+
+TEST(Http2ServerDeadlineTest, HandlerThatNeverRespondsGets504) {
+  auto config = make_config("127.0.0.1", 9212);
+  config.set_request_timeout_ms(100);
+  astra::http2::Http2Server server(config);
+  server.handle("GET", "/stuck", [](auto, auto) {});
+  ASSERT_TRUE(server.start().is_ok());
+
+  EXPECT_EQ(exchange(9212, "/stuck"), 504);
+  server.stop();
+  server.join();
+}
+
+TEST(Http2ServerDeadlineTest, TricklingBodyGets408) {
+  auto config = make_config("127.0.0.1", 9213);
+  config.set_body_timeout_ms(100);
+  astra::http2::Http2Server server(config);
+  std::atomic<bool> dispatched{false};
+  server.handle("POST", "/upload", [&](auto, auto res) {
+    dispatched = true;
+    res->close();
+  });
+  ASSERT_TRUE(server.start().is_ok());
+
+  // One byte, then the body never finishes
+  auto trickle = [sent = false](uint8_t *buf, std::size_t,
+                                uint32_t *) mutable -> ssize_t {
+    if (sent) {
+      return NGHTTP2_ERR_DEFERRED;
+    }
+    sent = true;
+    buf[0] = 'x';
+    return 1;
+  };
+  EXPECT_EQ(exchange(9213, "/upload", trickle), 408);
+  EXPECT_FALSE(dispatched);
+  server.stop();
+  server.join();
+}
+
+TEST(Http2ServerDeadlineTest, PromptResponseIsUntouched) {
+  auto config = make_config("127.0.0.1", 9214);
+  config.set_request_timeout_ms(1000);
+  config.set_body_timeout_ms(1000);
+  astra::http2::Http2Server server(config);
+  server.handle("GET", "/ok", [](auto, auto res) {
+    res->set_status(200);
+    res->close();
+  });
+  ASSERT_TRUE(server.start().is_ok());
+
+  EXPECT_EQ(exchange(9214, "/ok"), 200);
+  server.stop();
+  server.join();
+}
@@ -94,3 +94,17 @@ TEST_F(Http2RequestTest, SharedPtrUsage) {
   EXPECT_EQ(req->method(), "GET");
   EXPECT_EQ(req->path(), "/test");
 }
+
+TEST_F(Http2RequestTest, BodyViewReadsSlicesWithoutCopy) {
+  astra::router::RequestBody body;
+  body.reserve(11);
+  body.append("hello", 5);
+  body.append(" world", 6);
+  const char *stored = body.slice(0).data();
+
+  Http2Request req("POST", "/upload", {}, std::move(body));
+
+  EXPECT_EQ(req.body_view(), "hello world");
+  EXPECT_EQ(req.body_view().data(), stored);
+  EXPECT_EQ(req.body(), "hello world");
+}
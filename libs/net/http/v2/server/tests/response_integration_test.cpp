@@ -24,7 +24,7 @@ protected:
 
   struct SentData {
     int status = -1;
-    std::map<std::string, std::string> headers;
+    astra::utils::HeaderBlock headers;
     std::string body;
     int send_count = 0;
   };
@@ -33,7 +33,7 @@ protected:
 
   std::shared_ptr<Http2ResponseWriter> make_response_handle() {
     return std::make_shared<Http2ResponseWriter>(
-        [this](int status, std::map<std::string, std::string> headers,
+        [this](int status, astra::utils::HeaderBlock headers,
                std::string body) {
           sent.status = status;
           sent.headers = std::move(headers);
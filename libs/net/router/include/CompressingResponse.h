@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Compression.h"
+#include "IResponse.h"
+
+#include <HeaderBlock.h>
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace astra::router {
+
+// Wraps a transport response for a route that opted in to compression,
+// once the client's Accept-Encoding has picked `encoding`. Status and
+// headers are held back until the body size is known; bodies under the
+// policy's min_size, or that already carry a Content-Encoding, go out
+// as they are. A streamed body is always compressed, chunk by chunk.
+class CompressingResponse final : public IResponse {
+public:
+  CompressingResponse(std::shared_ptr<IResponse> inner, Encoding encoding,
+                      std::shared_ptr<ResponseCompressor> compressor);
+
+  void set_status(int code) noexcept override;
+  void set_header(const std::string &key, const std::string &value) override;
+  void write(const std::string &data) override;
+  void close() override;
+  void
+  send_prepared(const std::shared_ptr<const PreparedResponse> &response) override;
+  [[nodiscard]] std::shared_ptr<IResponseStream> start_stream() override;
+  [[nodiscard]] bool is_alive() const noexcept override;
+
+private:
+  [[nodiscard]] bool worth_compressing(int status,
+                                       const astra::utils::HeaderBlock &headers,
+                                       size_t body_size) const noexcept;
+  // Status and headers onto the inner response, marked as encoded or not
+  void forward_head(int status, const astra::utils::HeaderBlock &headers,
+                    bool encoded);
+
+  std::shared_ptr<IResponse> m_inner;
+  Encoding m_encoding;
+  std::shared_ptr<ResponseCompressor> m_compressor;
+
+  std::optional<int> m_status;
+  astra::utils::HeaderBlock m_headers;
+  std::string m_body;
+  // Set once the inner response has been told the body is encoded
+  bool m_committed = false;
+  bool m_closed = false;
+};
+
+} // namespace astra::router
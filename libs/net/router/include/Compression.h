@@ -0,0 +1,110 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+typedef struct z_stream_s z_stream;
+
+namespace astra::router {
+
+enum class Encoding { Identity, Gzip, Deflate };
+
+// Content-Encoding token; empty for Identity
+std::string_view encoding_name(Encoding encoding) noexcept;
+
+// Best encoding an Accept-Encoding header allows, honouring q-values and
+// "*"; gzip wins a tie. Identity when neither gzip nor deflate is wanted.
+Encoding negotiate(std::string_view accept_encoding) noexcept;
+
+// One-shot compression of a whole body
+std::string compress(std::string_view body, Encoding encoding, int level);
+
+struct CompressionPolicy {
+  int level{6};          // zlib level: 1 is fastest, 9 smallest
+  size_t min_size{1024}; // Smaller bodies are not worth the bytes saved
+  // Compressed bodies kept for identical payloads; 0 turns the cache off
+  size_t cache_entries{128};
+  // Larger bodies are compressed every time rather than pinned in memory
+  size_t cache_max_body{256 * 1024};
+
+  static CompressionPolicy create(int level, size_t min_size,
+                                  size_t cache_entries,
+                                  size_t cache_max_body) {
+    if (level < 1 || level > 9) {
+      throw std::invalid_argument("level must be in [1, 9]");
+    }
+    return CompressionPolicy{level, min_size, cache_entries, cache_max_body};
+  }
+};
+
+// Compresses a body that arrives in chunks. Every chunk is flushed, so the
+// peer can decode what it has so far instead of waiting for the end.
+class StreamCompressor {
+public:
+  StreamCompressor(Encoding encoding, int level);
+  ~StreamCompressor();
+
+  StreamCompressor(const StreamCompressor &) = delete;
+  StreamCompressor &operator=(const StreamCompressor &) = delete;
+
+  std::string compress(std::string_view chunk);
+  // Trailer; nothing may be compressed after it
+  std::string finish();
+
+private:
+  std::string run(std::string_view input, int flush);
+
+  std::unique_ptr<z_stream> m_stream;
+  bool m_finished = false;
+};
+
+// Compression shared by every route that opts in, with an LRU of compressed
+// bodies keyed by content, so a payload served over and over (a prepared
+// response, a popular document) is compressed once. Thread-safe; the
+// compression itself runs outside the lock.
+class ResponseCompressor {
+public:
+  explicit ResponseCompressor(CompressionPolicy policy);
+
+  [[nodiscard]] const CompressionPolicy &policy() const noexcept {
+    return m_policy;
+  }
+
+  std::shared_ptr<const std::string> compress(std::string_view body,
+                                              Encoding encoding);
+
+  [[nodiscard]] uint64_t cache_hits() const noexcept {
+    return m_hits.load(std::memory_order_relaxed);
+  }
+  [[nodiscard]] uint64_t cache_misses() const noexcept {
+    return m_misses.load(std::memory_order_relaxed);
+  }
+
+private:
+  struct Entry {
+    Encoding encoding;
+    std::string body;
+    std::shared_ptr<const std::string> compressed;
+  };
+  using Lru = std::list<Entry>;
+
+  [[nodiscard]] Lru::iterator find(size_t hash, std::string_view body,
+                                   Encoding encoding);
+
+  CompressionPolicy m_policy;
+  std::mutex m_mutex;
+  Lru m_lru; // most recently used first
+  std::unordered_multimap<size_t, Lru::iterator> m_index;
+  std::atomic<uint64_t> m_hits{0};
+  std::atomic<uint64_t> m_misses{0};
+};
+
+} // namespace astra::router
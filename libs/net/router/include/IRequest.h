@@ -1,6 +1,8 @@
 #pragma once
 
+#include <Deadline.h>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 
 namespace astra::router {
@@ -14,6 +16,11 @@ public:
   [[nodiscard]] virtual std::string header(const std::string &key) const = 0;
   [[nodiscard]] virtual const std::string &body() const = 0;
 
+  /// The body without a copy; valid while the request is alive
+  [[nodiscard]] virtual std::string_view body_view() const {
+    return body();
+  }
+
   [[nodiscard]] virtual std::string
   path_param(const std::string &key) const = 0;
   [[nodiscard]] virtual std::string
@@ -21,6 +28,11 @@ public:
 
   virtual void
   set_path_params(std::unordered_map<std::string, std::string> params) = 0;
+
+  /// When the caller stops waiting for the response; unset by default
+  [[nodiscard]] virtual astra::utils::Deadline deadline() const {
+    return {};
+  }
 };
 
 } // namespace astra::router
@@ -1,5 +1,9 @@
 #pragma once
 
+#include "IResponseStream.h"
+#include "PreparedResponse.h"
+
+#include <memory>
 #include <string>
 
 namespace astra::router {
@@ -13,6 +17,26 @@ public:
   virtual void write(const std::string &data) = 0;
   virtual void close() = 0;
 
+  /// Sends the status and headers now and hands back the body stream;
+  /// the response is closed for write(). Null when the transport cannot
+  /// stream, in which case write() and close() are still usable.
+  [[nodiscard]] virtual std::shared_ptr<IResponseStream> start_stream() {
+    return nullptr;
+  }
+
+  /// Sends `response` as is and closes this one. The default copies it
+  /// through the setters; transports override it to send the shared
+  /// headers and body without building anything per request.
+  virtual void
+  send_prepared(const std::shared_ptr<const PreparedResponse> &response) {
+    set_status(response->status());
+    for (const auto &[name, value] : response->headers()) {
+      set_header(name, value);
+    }
+    write(std::string(response->body()));
+    close();
+  }
+
   [[nodiscard]] virtual bool is_alive() const noexcept = 0;
 };
 
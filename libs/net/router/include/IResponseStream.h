@@ -0,0 +1,30 @@
+#pragma once
+
+#include <functional>
+#include <string>
+
+namespace astra::router {
+
+// Body of a response whose status and headers have already been sent.
+// Chunks are buffered until the transport can send them; write() reports
+// when the buffer is over its high-water mark so the producer can pause
+// until on_writable fires. Safe to use from any thread.
+class IResponseStream {
+public:
+  virtual ~IResponseStream() = default;
+
+  /// False once the buffer is full or the stream is gone; the chunk is
+  /// still queued in the first case and dropped in the second
+  virtual bool write(std::string chunk) = 0;
+
+  /// Runs once the buffer drains below its low-water mark after a write()
+  /// returned false. Called on the transport's thread, so keep it short.
+  virtual void on_writable(std::function<void()> callback) = 0;
+
+  /// Ends the body once everything queued has been sent
+  virtual void finish() = 0;
+
+  [[nodiscard]] virtual bool is_alive() const noexcept = 0;
+};
+
+} // namespace astra::router
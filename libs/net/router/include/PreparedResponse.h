@@ -0,0 +1,40 @@
+#pragma once
+
+#include <HeaderBlock.h>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace astra::router {
+
+// A response built once and sent many times: health checks, 404s, the
+// 503s a load shedder hands out. Headers, content-length included, and
+// body are fixed at creation; IResponse::send_prepared() shares the object
+// by refcount instead of rebuilding a header block and body per request.
+class PreparedResponse {
+public:
+  // Throws std::invalid_argument for a status outside 100-599
+  static std::shared_ptr<const PreparedResponse>
+  create(int status, astra::utils::HeaderBlock headers = {},
+         std::string body = {});
+
+  [[nodiscard]] int status() const noexcept {
+    return m_status;
+  }
+  [[nodiscard]] const astra::utils::HeaderBlock &headers() const noexcept {
+    return m_headers;
+  }
+  [[nodiscard]] std::string_view body() const noexcept {
+    return m_body;
+  }
+
+private:
+  PreparedResponse(int status, astra::utils::HeaderBlock headers,
+                   std::string body);
+
+  const int m_status;
+  const astra::utils::HeaderBlock m_headers;
+  const std::string m_body;
+};
+
+} // namespace astra::router
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace astra::router {
+
+// Request body held as a chain of refcounted slices. Bytes are copied once,
+// out of the transport's buffer, into blocks that never reallocate; copying
+// a RequestBody shares the blocks instead of the bytes. When the size is
+// known up front (content-length) the body lands in a single slice.
+class RequestBody {
+public:
+  static constexpr size_t kBlockSize = 16 * 1024;
+  // Upper bound on what a declared length may pre-allocate, so a bogus
+  // content-length cannot reserve memory the peer never sends
+  static constexpr size_t kMaxReserve = 1024 * 1024;
+
+  RequestBody() = default;
+  explicit RequestBody(std::string_view contiguous);
+
+  // Sizes the next block for `expected` more bytes, capped at kMaxReserve
+  void reserve(size_t expected);
+  void append(const char *data, size_t len);
+
+  [[nodiscard]] size_t size() const noexcept {
+    return m_size;
+  }
+  [[nodiscard]] bool empty() const noexcept {
+    return m_size == 0;
+  }
+
+  [[nodiscard]] size_t slice_count() const noexcept {
+    return m_blocks.size();
+  }
+  [[nodiscard]] std::string_view slice(size_t index) const noexcept {
+    const auto &block = m_blocks[index];
+    return {block.data.get(), block.size};
+  }
+
+  // Contiguous view. A chained body is merged into one slice on the first
+  // call, so the first call must not race with other readers.
+  [[nodiscard]] std::string_view view() const;
+  [[nodiscard]] std::string to_string() const;
+
+private:
+  struct Block {
+    std::shared_ptr<char[]> data;
+    size_t size = 0;
+    size_t capacity = 0;
+  };
+
+  static Block make_block(size_t capacity);
+
+  mutable std::vector<Block> m_blocks;
+  size_t m_size = 0;
+  size_t m_reserve = 0;
+};
+
+} // namespace astra::router
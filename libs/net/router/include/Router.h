@@ -1,11 +1,13 @@
 #pragma once
 
+#include "Compression.h"
 #include "IRequest.h"
 #include "IResponse.h"
 
 #include <functional>
 #include <memory>
 #include <optional>
+#include <resilience/policy/Criticality.h>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -15,24 +17,76 @@ namespace astra::router {
 using Handler =
     std::function<void(std::shared_ptr<IRequest>, std::shared_ptr<IResponse>)>;
 
+// Where a matched route's handler runs. Inline calls it on the transport's
+// io thread, which suits cheap handlers that answer straight away; a
+// response sent from there skips the hop back. Offload hands the call to
+// the function given to Router::set_offload.
+enum class Execution { Inline, Offload };
+
+// Per-route settings attached at registration time
+struct RouteOptions {
+  astra::resilience::Criticality criticality{
+      astra::resilience::Criticality::Default};
+  // Content-Encoding negotiated from Accept-Encoding; takes effect once
+  // Router::set_compression has been called
+  bool compress{false};
+  Execution execution{Execution::Inline};
+};
+
+// Runs after a route matches and before its handler. Returning false means
+// the request was rejected and the admission function already closed `res`.
+using Admission = std::function<bool(const RouteOptions &,
+                                     const std::shared_ptr<IRequest> &,
+                                     const std::shared_ptr<IResponse> &)>;
+
+// Runs an Execution::Offload handler call, typically by queueing it on an
+// executor; it must run `work` exactly once. `req` is the request `work`
+// serves, so an executor can key its choice of worker on it.
+using Offload = std::function<void(const std::shared_ptr<IRequest> &req,
+                                   std::function<void()> work)>;
+
 class Router {
 public:
   Router() = default;
   ~Router() = default;
 
-  void get(const std::string &path, Handler handler);
-  void post(const std::string &path, Handler handler);
-  void put(const std::string &path, Handler handler);
-  void del(const std::string &path, Handler handler);
+  void get(const std::string &path, Handler handler,
+           RouteOptions options = {});
+  void post(const std::string &path, Handler handler,
+            RouteOptions options = {});
+  void put(const std::string &path, Handler handler,
+           RouteOptions options = {});
+  void del(const std::string &path, Handler handler,
+           RouteOptions options = {});
+  // Any method; kAnyMethod ("*") routes are tried after the method's own
+  void add_route(const std::string &method, const std::string &path,
+                 Handler handler, RouteOptions options = {});
+
+  static constexpr const char *kAnyMethod = "*";
+
+  void set_admission(Admission admission);
+  // Without one, Execution::Offload routes run inline
+  void set_offload(Offload offload);
+  // Shared by every route with RouteOptions::compress; call before serving
+  void set_compression(CompressionPolicy policy);
 
   struct MatchResult {
     Handler handler;
     std::unordered_map<std::string, std::string> params;
+    RouteOptions options;
   };
 
   [[nodiscard]] std::optional<MatchResult> match(const std::string &method,
                                                  const std::string &path) const;
   void dispatch(std::shared_ptr<IRequest> req, std::shared_ptr<IResponse> res);
+  // For transports that matched up front, before reading the body:
+  // applies admission, sets the path params and runs the handler
+  void dispatch(MatchResult match, std::shared_ptr<IRequest> req,
+                std::shared_ptr<IResponse> res);
+
+  // What dispatch() sends when nothing matches
+  [[nodiscard]] static const std::shared_ptr<const PreparedResponse> &
+  not_found();
 
 private:
   struct Node {
@@ -40,12 +94,16 @@ private:
     std::unique_ptr<Node> wildcard_child;
     std::string param_name;
     Handler handler;
+    RouteOptions options;
   };
 
   std::unordered_map<std::string, std::unique_ptr<Node>> m_roots;
+  Admission m_admission;
+  Offload m_offload;
+  std::shared_ptr<ResponseCompressor> m_compressor;
 
-  void add_route(const std::string &method, const std::string &path,
-                 Handler handler);
+  [[nodiscard]] std::optional<MatchResult>
+  match_root(const std::string &method, const std::string &path) const;
 };
 
 } // namespace astra::router
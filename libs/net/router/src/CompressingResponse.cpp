@@ -0,0 +1,168 @@
+#include "CompressingResponse.h"
+
+#include <mutex>
+
+namespace astra::router {
+
+namespace {
+
+namespace header = astra::utils::header;
+
+class CompressingStream final : public IResponseStream {
+public:
+  CompressingStream(std::shared_ptr<IResponseStream> inner, Encoding encoding,
+                    int level)
+      : m_inner(std::move(inner)), m_compressor(encoding, level) {
+  }
+
+  bool write(std::string chunk) override {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_inner->write(m_compressor.compress(chunk));
+  }
+
+  void on_writable(std::function<void()> callback) override {
+    m_inner->on_writable(std::move(callback));
+  }
+
+  void finish() override {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_inner->write(m_compressor.finish());
+    m_inner->finish();
+  }
+
+  [[nodiscard]] bool is_alive() const noexcept override {
+    return m_inner->is_alive();
+  }
+
+private:
+  std::shared_ptr<IResponseStream> m_inner;
+  // Serializes chunks: deflate state must see them in write() order
+  std::mutex m_mutex;
+  StreamCompressor m_compressor;
+};
+
+} // namespace
+
+CompressingResponse::CompressingResponse(
+    std::shared_ptr<IResponse> inner, Encoding encoding,
+    std::shared_ptr<ResponseCompressor> compressor)
+    : m_inner(std::move(inner)), m_encoding(encoding),
+      m_compressor(std::move(compressor)) {
+}
+
+void CompressingResponse::set_status(int code) noexcept {
+  m_status = code;
+}
+
+void CompressingResponse::set_header(const std::string &key,
+                                     const std::string &value) {
+  m_headers.set(key, value);
+}
+
+void CompressingResponse::write(const std::string &data) {
+  m_body.append(data);
+}
+
+void CompressingResponse::close() {
+  if (m_closed) {
+    return;
+  }
+  m_closed = true;
+
+  int status = m_status.value_or(500);
+  bool encode =
+      m_committed || worth_compressing(status, m_headers, m_body.size());
+  if (!m_committed) {
+    forward_head(status, m_headers, encode);
+  }
+  if (encode) {
+    auto compressed = m_compressor->compress(m_body, m_encoding);
+    m_inner->set_header(std::string(header::kContentLength.name()),
+                        std::to_string(compressed->size()));
+    m_inner->write(*compressed);
+  } else {
+    m_inner->write(m_body);
+  }
+  m_inner->close();
+}
+
+void CompressingResponse::send_prepared(
+    const std::shared_ptr<const PreparedResponse> &response) {
+  if (m_closed) {
+    return;
+  }
+  if (!m_committed &&
+      !worth_compressing(response->status(), response->headers(),
+                         response->body().size())) {
+    m_closed = true;
+    m_inner->send_prepared(response);
+    return;
+  }
+
+  // The cache compresses each distinct body once; only the copy is per
+  // request
+  m_status = response->status();
+  m_headers = response->headers();
+  m_body.assign(response->body());
+  forward_head(*m_status, m_headers, true);
+  m_committed = true;
+  close();
+}
+
+std::shared_ptr<IResponseStream> CompressingResponse::start_stream() {
+  if (m_closed) {
+    return nullptr;
+  }
+  // The size is unknown, so a stream is compressed unless already encoded
+  bool encode = !m_headers.contains(header::kContentEncoding);
+  forward_head(m_status.value_or(200), m_headers, encode);
+  m_committed = encode;
+
+  auto stream = m_inner->start_stream();
+  if (!stream) {
+    // Falls back to write() and close(), which keep the promised encoding
+    return nullptr;
+  }
+  m_closed = true;
+  if (!encode) {
+    return stream;
+  }
+  return std::make_shared<CompressingStream>(std::move(stream), m_encoding,
+                                             m_compressor->policy().level);
+}
+
+bool CompressingResponse::is_alive() const noexcept {
+  return m_inner->is_alive();
+}
+
+bool CompressingResponse::worth_compressing(
+    int status, const astra::utils::HeaderBlock &headers,
+    size_t body_size) const noexcept {
+  if (status < 200 || status == 204 || status == 304) {
+    return false;
+  }
+  return body_size >= m_compressor->policy().min_size &&
+         !headers.contains(header::kContentEncoding);
+}
+
+void CompressingResponse::forward_head(int status,
+                                       const astra::utils::HeaderBlock &headers,
+                                       bool encoded) {
+  m_inner->set_status(status);
+  for (const auto &[name, value] : headers) {
+    // Rewritten for the encoded body, or set by the transport
+    if (encoded && header::kContentLength.name() == name) {
+      continue;
+    }
+    m_inner->set_header(name, value);
+  }
+  // Caches must not hand this body to a client that cannot decode it
+  m_inner->set_header(std::string(header::kVary.name()),
+                      std::string(header::kAcceptEncoding.name()));
+  if (encoded) {
+    m_inner->set_header(std::string(header::kContentEncoding.name()),
+                        std::string(encoding_name(m_encoding)));
+  }
+}
+
+} // namespace astra::router
@@ -0,0 +1,235 @@
+#include "Compression.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <functional>
+#include <zlib.h>
+
+namespace astra::router {
+
+namespace {
+
+// Window bits select the wrapper: +16 is gzip, plain is zlib, which is
+// what HTTP calls "deflate"
+int window_bits(Encoding encoding) {
+  return encoding == Encoding::Gzip ? MAX_WBITS + 16 : MAX_WBITS;
+}
+
+std::string_view trim(std::string_view s) {
+  while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) {
+    s.remove_prefix(1);
+  }
+  while (!s.empty() && (s.back() == ' ' || s.back() == '\t')) {
+    s.remove_suffix(1);
+  }
+  return s;
+}
+
+bool iequals(std::string_view a, std::string_view b) {
+  return a.size() == b.size() &&
+         std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+           return std::tolower(static_cast<unsigned char>(x)) ==
+                  std::tolower(static_cast<unsigned char>(y));
+         });
+}
+
+// q-value of one Accept-Encoding element; 1 when absent, 0 when malformed
+double quality(std::string_view params) {
+  while (!params.empty()) {
+    auto semi = params.find(';');
+    auto param = trim(params.substr(0, semi));
+    params = semi == std::string_view::npos ? std::string_view{}
+                                            : params.substr(semi + 1);
+    if (param.size() >= 2 && (param[0] == 'q' || param[0] == 'Q') &&
+        param[1] == '=') {
+      std::string value(trim(param.substr(2)));
+      char *end = nullptr;
+      double q = std::strtod(value.c_str(), &end);
+      return end != value.c_str() && q >= 0 && q <= 1 ? q : 0;
+    }
+  }
+  return 1;
+}
+
+size_t hash_of(std::string_view body, Encoding encoding) {
+  return std::hash<std::string_view>{}(body) ^ static_cast<size_t>(encoding);
+}
+
+} // namespace
+
+std::string_view encoding_name(Encoding encoding) noexcept {
+  switch (encoding) {
+  case Encoding::Gzip:
+    return "gzip";
+  case Encoding::Deflate:
+    return "deflate";
+  case Encoding::Identity:
+    break;
+  }
+  return {};
+}
+
+Encoding negotiate(std::string_view accept_encoding) noexcept {
+  double gzip = -1;
+  double deflate = -1;
+  double any = -1;
+
+  while (!accept_encoding.empty()) {
+    auto comma = accept_encoding.find(',');
+    auto element = accept_encoding.substr(0, comma);
+    accept_encoding = comma == std::string_view::npos
+                          ? std::string_view{}
+                          : accept_encoding.substr(comma + 1);
+
+    auto semi = element.find(';');
+    auto coding = trim(element.substr(0, semi));
+    double q = semi == std::string_view::npos ? 1
+                                              : quality(element.substr(semi + 1));
+    if (iequals(coding, "gzip") || iequals(coding, "x-gzip")) {
+      gzip = q;
+    } else if (iequals(coding, "deflate")) {
+      deflate = q;
+    } else if (coding == "*") {
+      any = q;
+    }
+  }
+
+  // Codings not named explicitly fall back to "*"
+  if (gzip < 0) {
+    gzip = std::max(any, 0.0);
+  }
+  if (deflate < 0) {
+    deflate = std::max(any, 0.0);
+  }
+  if (gzip <= 0 && deflate <= 0) {
+    return Encoding::Identity;
+  }
+  return gzip >= deflate ? Encoding::Gzip : Encoding::Deflate;
+}
+
+std::string compress(std::string_view body, Encoding encoding, int level) {
+  if (encoding == Encoding::Identity) {
+    return std::string(body);
+  }
+  StreamCompressor compressor(encoding, level);
+  std::string out = compressor.compress(body);
+  out += compressor.finish();
+  return out;
+}
+
+StreamCompressor::StreamCompressor(Encoding encoding, int level)
+    : m_stream(std::make_unique<z_stream>()) {
+  if (deflateInit2(m_stream.get(), level, Z_DEFLATED, window_bits(encoding),
+                   8, Z_DEFAULT_STRATEGY) != Z_OK) {
+    throw std::runtime_error("deflateInit2 failed");
+  }
+}
+
+StreamCompressor::~StreamCompressor() {
+  deflateEnd(m_stream.get());
+}
+
+std::string StreamCompressor::compress(std::string_view chunk) {
+  if (m_finished || chunk.empty()) {
+    return {};
+  }
+  return run(chunk, Z_SYNC_FLUSH);
+}
+
+std::string StreamCompressor::finish() {
+  if (m_finished) {
+    return {};
+  }
+  m_finished = true;
+  return run({}, Z_FINISH);
+}
+
+std::string StreamCompressor::run(std::string_view input, int flush) {
+  auto &z = *m_stream;
+  z.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(input.data()));
+  z.avail_in = static_cast<uInt>(input.size());
+
+  std::string out;
+  size_t produced = 0;
+  out.resize(deflateBound(&z, static_cast<uLong>(input.size())) + 16);
+  while (true) {
+    z.next_out = reinterpret_cast<Bytef *>(out.data() + produced);
+    z.avail_out = static_cast<uInt>(out.size() - produced);
+    int rc = deflate(&z, flush);
+    produced = out.size() - z.avail_out;
+    // Room left over means zlib has written everything it had
+    bool done = flush == Z_FINISH ? rc == Z_STREAM_END : z.avail_out > 0;
+    if (done || rc == Z_STREAM_ERROR) {
+      break;
+    }
+    out.resize(out.size() * 2);
+  }
+  out.resize(produced);
+  return out;
+}
+
+ResponseCompressor::ResponseCompressor(CompressionPolicy policy)
+    : m_policy(policy) {
+}
+
+std::shared_ptr<const std::string>
+ResponseCompressor::compress(std::string_view body, Encoding encoding) {
+  bool cacheable =
+      m_policy.cache_entries > 0 && body.size() <= m_policy.cache_max_body;
+  if (!cacheable) {
+    return std::make_shared<const std::string>(
+        router::compress(body, encoding, m_policy.level));
+  }
+
+  size_t hash = hash_of(body, encoding);
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = find(hash, body, encoding);
+    if (it != m_lru.end()) {
+      m_lru.splice(m_lru.begin(), m_lru, it);
+      m_hits.fetch_add(1, std::memory_order_relaxed);
+      return it->compressed;
+    }
+  }
+  m_misses.fetch_add(1, std::memory_order_relaxed);
+
+  auto compressed = std::make_shared<const std::string>(
+      router::compress(body, encoding, m_policy.level));
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  // Another thread may have compressed the same body meanwhile
+  if (find(hash, body, encoding) != m_lru.end()) {
+    return compressed;
+  }
+  m_lru.push_front(Entry{encoding, std::string(body), compressed});
+  m_index.emplace(hash, m_lru.begin());
+
+  if (m_lru.size() > m_policy.cache_entries) {
+    auto &oldest = m_lru.back();
+    auto range = m_index.equal_range(hash_of(oldest.body, oldest.encoding));
+    for (auto it = range.first; it != range.second; ++it) {
+      if (&*it->second == &oldest) {
+        m_index.erase(it);
+        break;
+      }
+    }
+    m_lru.pop_back();
+  }
+  return compressed;
+}
+
+ResponseCompressor::Lru::iterator
+ResponseCompressor::find(size_t hash, std::string_view body,
+                         Encoding encoding) {
+  auto range = m_index.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    const auto &entry = *it->second;
+    if (entry.encoding == encoding && entry.body == body) {
+      return it->second;
+    }
+  }
+  return m_lru.end();
+}
+
+} // namespace astra::router
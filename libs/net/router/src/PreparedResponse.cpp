@@ -0,0 +1,26 @@
+#include "PreparedResponse.h"
+
+#include <stdexcept>
+
+namespace astra::router {
+
+std::shared_ptr<const PreparedResponse>
+PreparedResponse::create(int status, astra::utils::HeaderBlock headers,
+                         std::string body) {
+  if (status < 100 || status > 599) {
+    throw std::invalid_argument("status must be in 100-599");
+  }
+  headers.set(astra::utils::header::kContentLength,
+              std::to_string(body.size()));
+  return std::shared_ptr<const PreparedResponse>(
+      new PreparedResponse(status, std::move(headers), std::move(body)));
+}
+
+PreparedResponse::PreparedResponse(int status,
+                                   astra::utils::HeaderBlock headers,
+                                   std::string body)
+    : m_status(status), m_headers(std::move(headers)),
+      m_body(std::move(body)) {
+}
+
+} // namespace astra::router
@@ -0,0 +1,67 @@
+#include "RequestBody.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace astra::router {
+
+RequestBody::RequestBody(std::string_view contiguous) {
+  append(contiguous.data(), contiguous.size());
+}
+
+void RequestBody::reserve(size_t expected) {
+  m_reserve = std::min(expected, kMaxReserve);
+}
+
+void RequestBody::append(const char *data, size_t len) {
+  while (len > 0) {
+    // A block shared with a copy of this body is frozen; its owner must
+    // not see bytes appear under a view it already handed out
+    if (m_blocks.empty() || m_blocks.back().size == m_blocks.back().capacity ||
+        m_blocks.back().data.use_count() > 1) {
+      size_t capacity = m_reserve > 0 ? m_reserve : std::max(len, kBlockSize);
+      m_reserve = 0;
+      m_blocks.push_back(make_block(capacity));
+    }
+
+    auto &block = m_blocks.back();
+    size_t n = std::min(len, block.capacity - block.size);
+    std::memcpy(block.data.get() + block.size, data, n);
+    block.size += n;
+    m_size += n;
+    data += n;
+    len -= n;
+  }
+}
+
+std::string_view RequestBody::view() const {
+  if (m_blocks.empty()) {
+    return {};
+  }
+  if (m_blocks.size() > 1) {
+    Block merged = make_block(m_size);
+    for (const auto &block : m_blocks) {
+      std::memcpy(merged.data.get() + merged.size, block.data.get(),
+                  block.size);
+      merged.size += block.size;
+    }
+    m_blocks.clear();
+    m_blocks.push_back(std::move(merged));
+  }
+  return slice(0);
+}
+
+std::string RequestBody::to_string() const {
+  std::string out;
+  out.reserve(m_size);
+  for (const auto &block : m_blocks) {
+    out.append(block.data.get(), block.size);
+  }
+  return out;
+}
+
+RequestBody::Block RequestBody::make_block(size_t capacity) {
+  return {std::shared_ptr<char[]>(new char[capacity]), 0, capacity};
+}
+
+} // namespace astra::router
@@ -1,27 +1,44 @@
 #include "Router.h"
 
+#include "CompressingResponse.h"
 #include "StringUtils.h"
 
 namespace astra::router {
 
-void Router::get(const std::string &path, Handler handler) {
-  add_route("GET", path, std::move(handler));
+void Router::get(const std::string &path, Handler handler,
+                 RouteOptions options) {
+  add_route("GET", path, std::move(handler), options);
 }
 
-void Router::post(const std::string &path, Handler handler) {
-  add_route("POST", path, std::move(handler));
+void Router::post(const std::string &path, Handler handler,
+                  RouteOptions options) {
+  add_route("POST", path, std::move(handler), options);
 }
 
-void Router::put(const std::string &path, Handler handler) {
-  add_route("PUT", path, std::move(handler));
+void Router::put(const std::string &path, Handler handler,
+                 RouteOptions options) {
+  add_route("PUT", path, std::move(handler), options);
 }
 
-void Router::del(const std::string &path, Handler handler) {
-  add_route("DELETE", path, std::move(handler));
+void Router::del(const std::string &path, Handler handler,
+                 RouteOptions options) {
+  add_route("DELETE", path, std::move(handler), options);
+}
+
+void Router::set_admission(Admission admission) {
+  m_admission = std::move(admission);
+}
+
+void Router::set_offload(Offload offload) {
+  m_offload = std::move(offload);
+}
+
+void Router::set_compression(CompressionPolicy policy) {
+  m_compressor = std::make_shared<ResponseCompressor>(policy);
 }
 
 void Router::add_route(const std::string &method, const std::string &path,
-                       Handler handler) {
+                       Handler handler, RouteOptions options) {
   if (m_roots.find(method) == m_roots.end()) {
     m_roots[method] = std::make_unique<Node>();
   }
@@ -49,10 +66,19 @@ void Router::add_route(const std::string &method, const std::string &path,
   }
 
   current->handler = std::move(handler);
+  current->options = options;
 }
 
 std::optional<Router::MatchResult>
 Router::match(const std::string &method, const std::string &path) const {
+  if (auto result = match_root(method, path)) {
+    return result;
+  }
+  return method == kAnyMethod ? std::nullopt : match_root(kAnyMethod, path);
+}
+
+std::optional<Router::MatchResult>
+Router::match_root(const std::string &method, const std::string &path) const {
   auto it = m_roots.find(method);
   if (it == m_roots.end()) {
     return std::nullopt;
@@ -82,7 +108,7 @@ Router::match(const std::string &method, const std::string &path) const {
     return std::nullopt;
   }
 
-  return MatchResult{current->handler, std::move(params)};
+  return MatchResult{current->handler, std::move(params), current->options};
 }
 
 void Router::dispatch(std::shared_ptr<IRequest> req,
@@ -90,13 +116,38 @@ void Router::dispatch(std::shared_ptr<IRequest> req,
   auto result = match(req->method(), req->path());
 
   if (result) {
-    req->set_path_params(std::move(result->params));
-    result->handler(req, res);
+    dispatch(std::move(*result), std::move(req), std::move(res));
   } else {
-    res->set_status(404);
-    res->write("Not Found");
-    res->close();
+    res->send_prepared(not_found());
   }
 }
 
+void Router::dispatch(MatchResult match, std::shared_ptr<IRequest> req,
+                      std::shared_ptr<IResponse> res) {
+  if (m_admission && !m_admission(match.options, req, res)) {
+    return;
+  }
+  if (match.options.compress && m_compressor) {
+    auto encoding = negotiate(req->header("accept-encoding"));
+    if (encoding != Encoding::Identity) {
+      res = std::make_shared<CompressingResponse>(std::move(res), encoding,
+                                                  m_compressor);
+    }
+  }
+  req->set_path_params(std::move(match.params));
+  if (match.options.execution == Execution::Offload && m_offload) {
+    m_offload(req, [handler = std::move(match.handler), req,
+                    res = std::move(res)]() {
+      handler(req, res);
+    });
+    return;
+  }
+  match.handler(req, res);
+}
+
+const std::shared_ptr<const PreparedResponse> &Router::not_found() {
+  static const auto response = PreparedResponse::create(404, {}, "Not Found");
+  return response;
+}
+
 } // namespace astra::router
@@ -0,0 +1,394 @@
+#include "CompressingResponse.h"
+#include "Compression.h"
+#include "Router.h"
+
+#include <gtest/gtest.h>
+#include <map>
+#include <stdexcept>
+#include <zlib.h>
+
+using namespace astra::router;
+
+namespace {
+
+// Decodes gzip and zlib alike (window bits + 32 detects the wrapper)
+std::string inflate_all(const std::string &data) {
+  z_stream z{};
+  inflateInit2(&z, MAX_WBITS + 32);
+  z.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data.data()));
+  z.avail_in = static_cast<uInt>(data.size());
+  std::string out;
+  char buf[4096];
+  int rc = Z_OK;
+  while (rc == Z_OK) {
+    z.next_out = reinterpret_cast<Bytef *>(buf);
+    z.avail_out = sizeof(buf);
+    rc = inflate(&z, Z_NO_FLUSH);
+    out.append(buf, sizeof(buf) - z.avail_out);
+    if (z.avail_in == 0 && rc == Z_OK && z.avail_out > 0) {
+      break;
+    }
+  }
+  inflateEnd(&z);
+  return out;
+}
+
+std::string json_body(size_t records) {
+  std::string body = "[";
+  for (size_t i = 0; i < records; ++i) {
+    body += R"({"code":"abc)" + std::to_string(i) +
+            R"(","url":"https://example.com/some/long/path"},)";
+  }
+  body.back() = ']';
+  return body;
+}
+
+class FakeRequest : public IRequest {
+public:
+  explicit FakeRequest(std::string accept_encoding)
+      : m_accept_encoding(std::move(accept_encoding)) {
+  }
+
+  const std::string &method() const override {
+    return m_method;
+  }
+  const std::string &path() const override {
+    return m_path;
+  }
+  std::string header(const std::string &key) const override {
+    return key == "accept-encoding" ? m_accept_encoding : "";
+  }
+  const std::string &body() const override {
+    return m_empty;
+  }
+  std::string path_param(const std::string &) const override {
+    return "";
+  }
+  std::string query_param(const std::string &) const override {
+    return "";
+  }
+  void set_path_params(std::unordered_map<std::string, std::string>) override {
+  }
+
+private:
+  std::string m_method = "GET";
+  std::string m_path = "/items";
+  std::string m_accept_encoding;
+  std::string m_empty;
+};
+
+class FakeStream : public IResponseStream {
+public:
+  bool write(std::string chunk) override {
+    chunks.push_back(std::move(chunk));
+    return true;
+  }
+  void on_writable(std::function<void()>) override {
+  }
+  void finish() override {
+    finished = true;
+  }
+  bool is_alive() const noexcept override {
+    return true;
+  }
+
+  std::vector<std::string> chunks;
+  bool finished = false;
+};
+
+class FakeResponse : public IResponse {
+public:
+  explicit FakeResponse(bool can_stream = false) : m_can_stream(can_stream) {
+  }
+
+  void set_status(int code) noexcept override {
+    status = code;
+  }
+  void set_header(const std::string &key, const std::string &value) override {
+    headers[key] = value;
+  }
+  void write(const std::string &data) override {
+    body += data;
+  }
+  void close() override {
+    closed = true;
+  }
+  void
+  send_prepared(const std::shared_ptr<const PreparedResponse> &) override {
+    sent_prepared = true;
+    closed = true;
+  }
+  std::shared_ptr<IResponseStream> start_stream() override {
+    if (!m_can_stream) {
+      return nullptr;
+    }
+    stream = std::make_shared<FakeStream>();
+    return stream;
+  }
+  bool is_alive() const noexcept override {
+    return true;
+  }
+
+  int status = 0;
+  std::map<std::string, std::string> headers;
+  std::string body;
+  bool closed = false;
+  bool sent_prepared = false;
+  std::shared_ptr<FakeStream> stream;
+
+private:
+  bool m_can_stream;
+};
+
+class CompressionRouterTest : public ::testing::Test {
+protected:
+  CompressionRouterTest() {
+    m_router.set_compression(CompressionPolicy::create(6, 256, 16, 1 << 20));
+  }
+
+  std::shared_ptr<FakeResponse> dispatch(const std::string &accept_encoding,
+                                         bool can_stream = false) {
+    auto res = std::make_shared<FakeResponse>(can_stream);
+    m_router.dispatch(std::make_shared<FakeRequest>(accept_encoding), res);
+    return res;
+  }
+
+  Router m_router;
+};
+
+} // namespace
+
+TEST(NegotiateTest, PicksTheBestAcceptableCoding) {
+  EXPECT_EQ(negotiate(""), Encoding::Identity);
+  EXPECT_EQ(negotiate("gzip"), Encoding::Gzip);
+  EXPECT_EQ(negotiate("deflate"), Encoding::Deflate);
+  EXPECT_EQ(negotiate("deflate, gzip"), Encoding::Gzip);
+  EXPECT_EQ(negotiate("gzip;q=0.5, deflate;q=0.8"), Encoding::Deflate);
+  EXPECT_EQ(negotiate("br, identity"), Encoding::Identity);
+  EXPECT_EQ(negotiate("GZIP ; Q=1"), Encoding::Gzip);
+}
+
+TEST(NegotiateTest, HonoursRefusalAndWildcard) {
+  EXPECT_EQ(negotiate("gzip;q=0"), Encoding::Identity);
+  EXPECT_EQ(negotiate("*"), Encoding::Gzip);
+  EXPECT_EQ(negotiate("*;q=0.3, gzip;q=0"), Encoding::Deflate);
+  EXPECT_EQ(negotiate("*;q=0"), Encoding::Identity);
+  EXPECT_EQ(negotiate("gzip;q=bogus"), Encoding::Identity);
+}
+
+TEST(CompressTest, RoundTripsBothEncodings) {
+  auto body = json_body(200);
+  for (auto encoding : {Encoding::Gzip, Encoding::Deflate}) {
+    auto compressed = compress(body, encoding, 6);
+    EXPECT_LT(compressed.size(), body.size() / 4);
+    EXPECT_EQ(inflate_all(compressed), body);
+  }
+  EXPECT_EQ(compress(body, Encoding::Identity, 6), body);
+}
+
+TEST(CompressTest, StreamChunksDecodeAsTheyArrive) {
+  StreamCompressor compressor(Encoding::Gzip, 6);
+  auto first = compressor.compress("hello ");
+  // Flushed: the first chunk alone decodes to its input
+  EXPECT_EQ(inflate_all(first), "hello ");
+
+  auto all = first + compressor.compress("world");
+  all += compressor.finish();
+  EXPECT_EQ(inflate_all(all), "hello world");
+  EXPECT_TRUE(compressor.finish().empty());
+}
+
+TEST(CompressionPolicyTest, RejectsLevelsZlibDoesNotHave) {
+  EXPECT_THROW(CompressionPolicy::create(0, 0, 0, 0), std::invalid_argument);
+  EXPECT_THROW(CompressionPolicy::create(10, 0, 0, 0), std::invalid_argument);
+  EXPECT_NO_THROW(CompressionPolicy::create(1, 0, 0, 0));
+}
+
+TEST(ResponseCompressorTest, IdenticalBodiesAreCompressedOnce) {
+  ResponseCompressor compressor(CompressionPolicy::create(6, 0, 4, 1 << 20));
+  auto body = json_body(50);
+
+  auto first = compressor.compress(body, Encoding::Gzip);
+  auto second = compressor.compress(body, Encoding::Gzip);
+  EXPECT_EQ(first.get(), second.get());
+  EXPECT_EQ(compressor.cache_hits(), 1u);
+  EXPECT_EQ(compressor.cache_misses(), 1u);
+
+  // Same bytes, other encoding: a separate entry
+  auto deflated = compressor.compress(body, Encoding::Deflate);
+  EXPECT_NE(deflated.get(), first.get());
+  EXPECT_EQ(compressor.cache_misses(), 2u);
+}
+
+TEST(ResponseCompressorTest, EvictsLeastRecentlyUsed) {
+  ResponseCompressor compressor(CompressionPolicy::create(6, 0, 2, 1 << 20));
+  compressor.compress("aaaa", Encoding::Gzip);
+  compressor.compress("bbbb", Encoding::Gzip);
+  compressor.compress("aaaa", Encoding::Gzip); // refresh a
+  compressor.compress("cccc", Encoding::Gzip); // evicts b
+  ASSERT_EQ(compressor.cache_hits(), 1u);
+
+  compressor.compress("aaaa", Encoding::Gzip);
+  EXPECT_EQ(compressor.cache_hits(), 2u);
+  compressor.compress("bbbb", Encoding::Gzip);
+  EXPECT_EQ(compressor.cache_hits(), 2u);
+}
+
+TEST(ResponseCompressorTest, LargeBodiesBypassTheCache) {
+  ResponseCompressor compressor(CompressionPolicy::create(6, 0, 4, 16));
+  auto body = json_body(10);
+  compressor.compress(body, Encoding::Gzip);
+  compressor.compress(body, Encoding::Gzip);
+  EXPECT_EQ(compressor.cache_hits(), 0u);
+}
+
+TEST_F(CompressionRouterTest, CompressesOptedInRoute) {
+  auto body = json_body(100);
+  m_router.get(
+      "/items",
+      [&](std::shared_ptr<IRequest>, std::shared_ptr<IResponse> res) {
+        res->set_status(200);
+        res->set_header("content-type", "application/json");
+        res->set_header("content-length", std::to_string(body.size()));
+        res->write(body);
+        res->close();
+      },
+      {astra::resilience::Criticality::Default, true});
+
+  auto res = dispatch("gzip, deflate");
+  EXPECT_TRUE(res->closed);
+  EXPECT_EQ(res->status, 200);
+  EXPECT_EQ(res->headers["content-encoding"], "gzip");
+  EXPECT_EQ(res->headers["vary"], "accept-encoding");
+  EXPECT_EQ(res->headers["content-type"], "application/json");
+  EXPECT_EQ(res->headers["content-length"], std::to_string(res->body.size()));
+  EXPECT_EQ(inflate_all(res->body), body);
+}
+
+TEST_F(CompressionRouterTest, LeavesOtherResponsesAlone) {
+  auto body = json_body(100);
+  auto handler = [&](std::shared_ptr<IRequest>,
+                     std::shared_ptr<IResponse> res) {
+    res->set_status(200);
+    res->write(body);
+    res->close();
+  };
+  m_router.get("/items", handler); // not opted in
+
+  auto res = dispatch("gzip");
+  EXPECT_EQ(res->headers.count("content-encoding"), 0u);
+  EXPECT_EQ(res->body, body);
+
+  Router opted_in;
+  opted_in.set_compression(CompressionPolicy::create(6, 256, 16, 1 << 20));
+  opted_in.get("/items", handler, {astra::resilience::Criticality::Default, true});
+  auto identity = std::make_shared<FakeResponse>();
+  opted_in.dispatch(std::make_shared<FakeRequest>(""), identity);
+  EXPECT_EQ(identity->headers.count("content-encoding"), 0u);
+  EXPECT_EQ(identity->body, body);
+}
+
+TEST_F(CompressionRouterTest, SkipsSmallAndAlreadyEncodedBodies) {
+  m_router.get(
+      "/items",
+      [](std::shared_ptr<IRequest>, std::shared_ptr<IResponse> res) {
+        res->set_status(200);
+        res->write("tiny");
+        res->close();
+      },
+      {astra::resilience::Criticality::Default, true});
+  auto small = dispatch("gzip");
+  EXPECT_EQ(small->headers.count("content-encoding"), 0u);
+  EXPECT_EQ(small->body, "tiny");
+
+  Router router;
+  router.set_compression(CompressionPolicy::create(6, 0, 16, 1 << 20));
+  router.get(
+      "/items",
+      [](std::shared_ptr<IRequest>, std::shared_ptr<IResponse> res) {
+        res->set_status(200);
+        res->set_header("content-encoding", "br");
+        res->write("already brotli");
+        res->close();
+      },
+      {astra::resilience::Criticality::Default, true});
+  auto encoded = std::make_shared<FakeResponse>();
+  router.dispatch(std::make_shared<FakeRequest>("gzip"), encoded);
+  EXPECT_EQ(encoded->headers["content-encoding"], "br");
+  EXPECT_EQ(encoded->body, "already brotli");
+}
+
+TEST_F(CompressionRouterTest, PreparedResponsesComeFromTheCache) {
+  auto prepared = PreparedResponse::create(
+      200, {{"content-type", "application/json"}}, json_body(100));
+  auto small = PreparedResponse::create(200, {}, "ok");
+  m_router.get(
+      "/items",
+      [&](std::shared_ptr<IRequest>, std::shared_ptr<IResponse> res) {
+        res->send_prepared(prepared);
+      },
+      {astra::resilience::Criticality::Default, true});
+
+  auto first = dispatch("deflate");
+  auto second = dispatch("deflate");
+  EXPECT_FALSE(first->sent_prepared);
+  EXPECT_EQ(first->headers["content-encoding"], "deflate");
+  EXPECT_EQ(inflate_all(first->body), std::string(prepared->body()));
+  EXPECT_EQ(second->body, first->body);
+
+  Router router;
+  router.set_compression(CompressionPolicy::create(6, 256, 16, 1 << 20));
+  router.get(
+      "/items",
+      [&](std::shared_ptr<IRequest>, std::shared_ptr<IResponse> res) {
+        res->send_prepared(small);
+      },
+      {astra::resilience::Criticality::Default, true});
+  auto passthrough = std::make_shared<FakeResponse>();
+  router.dispatch(std::make_shared<FakeRequest>("gzip"), passthrough);
+  EXPECT_TRUE(passthrough->sent_prepared);
+}
+
+TEST_F(CompressionRouterTest, StreamsAreCompressedChunkByChunk) {
+  m_router.get(
+      "/items",
+      [](std::shared_ptr<IRequest>, std::shared_ptr<IResponse> res) {
+        res->set_status(200);
+        res->set_header("content-length", "10");
+        auto stream = res->start_stream();
+        ASSERT_NE(stream, nullptr);
+        stream->write("first ");
+        stream->write("second");
+        stream->finish();
+      },
+      {astra::resilience::Criticality::Default, true});
+
+  auto res = dispatch("gzip", true);
+  ASSERT_NE(res->stream, nullptr);
+  EXPECT_TRUE(res->stream->finished);
+  EXPECT_EQ(res->headers["content-encoding"], "gzip");
+  EXPECT_EQ(res->headers.count("content-length"), 0u);
+  EXPECT_EQ(inflate_all(res->stream->chunks[0]), "first ");
+
+  std::string all;
+  for (const auto &chunk : res->stream->chunks) {
+    all += chunk;
+  }
+  EXPECT_EQ(inflate_all(all), "first second");
+}
+
+TEST_F(CompressionRouterTest, StreamFallbackKeepsTheEncodingPromise) {
+  m_router.get(
+      "/items",
+      [](std::shared_ptr<IRequest>, std::shared_ptr<IResponse> res) {
+        res->set_status(200);
+        EXPECT_EQ(res->start_stream(), nullptr);
+        res->write("short");
+        res->close();
+      },
+      {astra::resilience::Criticality::Default, true});
+
+  auto res = dispatch("gzip", false);
+  EXPECT_EQ(res->headers["content-encoding"], "gzip");
+  EXPECT_EQ(inflate_all(res->body), "short");
+}
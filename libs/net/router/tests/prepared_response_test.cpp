@@ -0,0 +1,73 @@
+#include "IResponse.h"
+#include "PreparedResponse.h"
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+
+using namespace astra::router;
+
+namespace {
+
+class RecordingResponse : public IResponse {
+public:
+  void set_status(int code) noexcept override {
+    status = code;
+  }
+  void set_header(const std::string &key, const std::string &value) override {
+    headers.emplace_back(key, value);
+  }
+  void write(const std::string &data) override {
+    body += data;
+  }
+  void close() override {
+    closed = true;
+  }
+  bool is_alive() const noexcept override {
+    return !closed;
+  }
+
+  int status = 0;
+  std::vector<std::pair<std::string, std::string>> headers;
+  std::string body;
+  bool closed = false;
+};
+
+} // namespace
+
+TEST(PreparedResponseTest, AddsContentLength) {
+  auto prepared = PreparedResponse::create(
+      503, {{"Content-Type", "application/json"}}, R"({"error": "busy"})");
+
+  EXPECT_EQ(prepared->status(), 503);
+  EXPECT_EQ(prepared->headers().get("content-type"), "application/json");
+  EXPECT_EQ(prepared->headers().get("content-length"), "17");
+  EXPECT_EQ(prepared->body(), R"({"error": "busy"})");
+}
+
+TEST(PreparedResponseTest, EmptyBodyHasZeroLength) {
+  auto prepared = PreparedResponse::create(204);
+
+  EXPECT_TRUE(prepared->body().empty());
+  EXPECT_EQ(prepared->headers().get("content-length"), "0");
+}
+
+TEST(PreparedResponseTest, RejectsInvalidStatus) {
+  EXPECT_THROW(PreparedResponse::create(99), std::invalid_argument);
+  EXPECT_THROW(PreparedResponse::create(600), std::invalid_argument);
+}
+
+TEST(PreparedResponseTest, DefaultSendCopiesThroughSetters) {
+  auto prepared =
+      PreparedResponse::create(200, {{"content-type", "text/plain"}}, "ok");
+  RecordingResponse res;
+
+  res.send_prepared(prepared);
+
+  EXPECT_EQ(res.status, 200);
+  EXPECT_EQ(res.body, "ok");
+  EXPECT_TRUE(res.closed);
+  ASSERT_EQ(res.headers.size(), 2u);
+  EXPECT_EQ(res.headers[0].first, "content-type");
+  EXPECT_EQ(res.headers[1].first, "content-length");
+}
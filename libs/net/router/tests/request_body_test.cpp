@@ -0,0 +1,60 @@
+#include "RequestBody.h"
+
+#include <gtest/gtest.h>
+#include <string>
+
+using astra::router::RequestBody;
+
+TEST(RequestBodyTest, EmptyBodyHasNoSlices) {
+  RequestBody body;
+  EXPECT_TRUE(body.empty());
+  EXPECT_EQ(body.slice_count(), 0u);
+  EXPECT_EQ(body.view(), "");
+}
+
+TEST(RequestBodyTest, ReservedBodyLandsInOneSlice) {
+  std::string chunk(1000, 'x');
+  RequestBody body;
+  body.reserve(40 * 1000);
+  for (int i = 0; i < 40; ++i) {
+    body.append(chunk.data(), chunk.size());
+  }
+
+  EXPECT_EQ(body.size(), 40000u);
+  EXPECT_EQ(body.slice_count(), 1u);
+  const char *first = body.slice(0).data();
+  EXPECT_EQ(body.view().data(), first); // No merge needed
+}
+
+TEST(RequestBodyTest, UnsizedBodyChainsBlocksAndMergesOnView) {
+  std::string chunk(RequestBody::kBlockSize / 2 + 1, 'a');
+  RequestBody body;
+  body.append(chunk.data(), chunk.size());
+  body.append(chunk.data(), chunk.size());
+
+  EXPECT_EQ(body.slice_count(), 2u);
+  EXPECT_EQ(body.to_string(), chunk + chunk);
+  EXPECT_EQ(body.view(), chunk + chunk);
+  EXPECT_EQ(body.slice_count(), 1u);
+}
+
+TEST(RequestBodyTest, ReserveIsCapped) {
+  RequestBody body;
+  body.reserve(RequestBody::kMaxReserve * 100);
+  std::string chunk(RequestBody::kMaxReserve + 1, 'b');
+  body.append(chunk.data(), chunk.size());
+
+  EXPECT_EQ(body.slice_count(), 2u);
+  EXPECT_EQ(body.slice(0).size(), RequestBody::kMaxReserve);
+}
+
+TEST(RequestBodyTest, CopiesShareBytesAndDoNotSeeLaterAppends) {
+  RequestBody body(std::string_view("hello"));
+  RequestBody copy = body;
+  EXPECT_EQ(copy.slice(0).data(), body.slice(0).data());
+
+  body.append(" world", 6);
+  EXPECT_EQ(body.to_string(), "hello world");
+  EXPECT_EQ(copy.to_string(), "hello");
+  EXPECT_EQ(body.slice_count(), 2u);
+}
@@ -1,5 +1,6 @@
 #include "Router.h"
 
+#include <functional>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <thread>
@@ -357,3 +358,184 @@ TEST_F(RouterTest, DispatchNoMatchDoesNotCrash) {
   // Should not crash when no handler matches
   EXPECT_NO_THROW(m_router.dispatch(req, res));
 }
+
+// =============================================================================
+// Route Options and Admission Tests
+// =============================================================================
+
+TEST_F(RouterTest, RouteOptionsDefaultToDefaultCriticality) {
+  m_router.get("/users", [](auto, auto) {});
+
+  auto result = m_router.match("GET", "/users");
+  ASSERT_TRUE(result);
+  EXPECT_EQ(result->options.criticality,
+            astra::resilience::Criticality::Default);
+}
+
+TEST_F(RouterTest, RouteOptionsReturnedFromMatch) {
+  m_router.get("/health", [](auto, auto) {},
+               {astra::resilience::Criticality::Critical});
+  m_router.post("/shorten", [](auto, auto) {},
+                {astra::resilience::Criticality::Sheddable});
+
+  auto health = m_router.match("GET", "/health");
+  auto shorten = m_router.match("POST", "/shorten");
+  ASSERT_TRUE(health);
+  ASSERT_TRUE(shorten);
+  EXPECT_EQ(health->options.criticality,
+            astra::resilience::Criticality::Critical);
+  EXPECT_EQ(shorten->options.criticality,
+            astra::resilience::Criticality::Sheddable);
+}
+
+TEST_F(RouterTest, AdmissionRejectSkipsHandler) {
+  bool handler_called = false;
+  std::optional<astra::resilience::Criticality> seen;
+  m_router.post(
+      "/shorten",
+      [&handler_called](auto, auto) {
+        handler_called = true;
+      },
+      {astra::resilience::Criticality::Sheddable});
+  m_router.set_admission([&seen](const RouteOptions &options, const auto &,
+                                 const auto &) {
+    seen = options.criticality;
+    return false;
+  });
+
+  auto req = std::make_shared<MockRequest>("/shorten", "POST");
+  auto res = std::make_shared<MockResponse>();
+
+  m_router.dispatch(req, res);
+  EXPECT_FALSE(handler_called);
+  EXPECT_EQ(seen, astra::resilience::Criticality::Sheddable);
+}
+
+TEST_F(RouterTest, AdmissionAcceptRunsHandler) {
+  bool handler_called = false;
+  m_router.get("/test", [&handler_called](auto, auto) {
+    handler_called = true;
+  });
+  m_router.set_admission([](const RouteOptions &, const auto &, const auto &) {
+    return true;
+  });
+
+  auto req = std::make_shared<MockRequest>("/test", "GET");
+  auto res = std::make_shared<MockResponse>();
+
+  m_router.dispatch(req, res);
+  EXPECT_TRUE(handler_called);
+}
+
+TEST_F(RouterTest, AdmissionNotConsultedWithoutMatch) {
+  bool admission_called = false;
+  m_router.set_admission(
+      [&admission_called](const RouteOptions &, const auto &, const auto &) {
+        admission_called = true;
+        return true;
+      });
+
+  auto req = std::make_shared<MockRequest>("/nonexistent", "GET");
+  auto res = std::make_shared<MockResponse>();
+
+  m_router.dispatch(req, res);
+  EXPECT_FALSE(admission_called);
+}
+
+TEST_F(RouterTest, OffloadRouteRunsThroughOffload) {
+  bool handler_called = false;
+  std::vector<std::function<void()>> queued;
+  RouteOptions options;
+  options.execution = Execution::Offload;
+  m_router.post(
+      "/shorten",
+      [&handler_called](auto, auto) {
+        handler_called = true;
+      },
+      options);
+  std::shared_ptr<IRequest> offloaded_req;
+  m_router.set_offload([&queued, &offloaded_req](
+                           const std::shared_ptr<IRequest> &req,
+                           std::function<void()> work) {
+    offloaded_req = req;
+    queued.push_back(std::move(work));
+  });
+
+  auto req = std::make_shared<MockRequest>("/shorten", "POST");
+  m_router.dispatch(req, std::make_shared<MockResponse>());
+  EXPECT_FALSE(handler_called);
+  ASSERT_EQ(queued.size(), 1u);
+  EXPECT_EQ(offloaded_req, req);
+
+  queued.front()();
+  EXPECT_TRUE(handler_called);
+}
+
+TEST_F(RouterTest, InlineRouteSkipsOffload) {
+  bool handler_called = false;
+  bool offloaded = false;
+  m_router.get("/health", [&handler_called](auto, auto) {
+    handler_called = true;
+  });
+  m_router.set_offload([&offloaded](const std::shared_ptr<IRequest> &,
+                                    std::function<void()> work) {
+    offloaded = true;
+    work();
+  });
+
+  m_router.dispatch(std::make_shared<MockRequest>("/health", "GET"),
+                    std::make_shared<MockResponse>());
+  EXPECT_TRUE(handler_called);
+  EXPECT_FALSE(offloaded);
+}
+
+TEST_F(RouterTest, OffloadRouteRunsInlineWithoutOffload) {
+  bool handler_called = false;
+  RouteOptions options;
+  options.execution = Execution::Offload;
+  m_router.get(
+      "/test",
+      [&handler_called](auto, auto) {
+        handler_called = true;
+      },
+      options);
+
+  m_router.dispatch(std::make_shared<MockRequest>("/test", "GET"),
+                    std::make_shared<MockResponse>());
+  EXPECT_TRUE(handler_called);
+}
+
+TEST_F(RouterTest, AnyMethodRouteIsAFallback) {
+  m_router.add_route(Router::kAnyMethod, "/items/:id", [](auto, auto) {});
+  m_router.get("/items/special", [](auto, auto) {});
+
+  auto any = m_router.match("PATCH", "/items/42");
+  ASSERT_TRUE(any);
+  EXPECT_EQ(any->params.at("id"), "42");
+
+  // The method's own route still wins
+  auto own = m_router.match("GET", "/items/special");
+  ASSERT_TRUE(own);
+  EXPECT_TRUE(own->params.empty());
+}
+
+TEST_F(RouterTest, DispatchPrematchedRunsAdmissionAndHandler) {
+  bool handler_called = false;
+  m_router.get("/users/:id", [&handler_called](auto, auto) {
+    handler_called = true;
+  });
+  bool admitted = false;
+  m_router.set_admission(
+      [&admitted](const RouteOptions &, const auto &, const auto &) {
+        admitted = true;
+        return true;
+      });
+
+  auto match = m_router.match("GET", "/users/7");
+  ASSERT_TRUE(match);
+  auto req = std::make_shared<MockRequest>("/users/7", "GET");
+  m_router.dispatch(std::move(*match), req, std::make_shared<MockResponse>());
+
+  EXPECT_TRUE(admitted);
+  EXPECT_TRUE(handler_called);
+}
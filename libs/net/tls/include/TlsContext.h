@@ -0,0 +1,79 @@
+#pragma once
+
+#include <Result.h>
+#include <boost/asio/ssl/context.hpp>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace astra::tls {
+
+enum class TlsError {
+  CertificateLoad,
+  PrivateKeyLoad,
+  KeyMismatch,
+  CipherList,
+  CaLoad,
+  AlpnList
+};
+
+const char *to_string(TlsError error) noexcept;
+
+struct ServerOptions {
+  std::string cert_file; // PEM, leaf first
+  std::string key_file;  // PEM
+  // TLS 1.2 cipher list and TLS 1.3 suites; empty keeps OpenSSL's default
+  std::string ciphers;
+  std::string ciphersuites;
+  // Server preference order. A client offering none of these gets a
+  // no_application_protocol alert rather than a protocol it cannot speak.
+  std::vector<std::string> alpn{"h2"};
+
+  // Stateful resumption; 0 turns the server-side cache off
+  size_t session_cache_size = 20480;
+  std::chrono::seconds session_timeout{7200};
+  // Stateless resumption; OpenSSL rotates the ticket keys itself
+  bool session_tickets = true;
+  // Ask OpenSSL to hand record encryption to the kernel (see ktls_engaged)
+  bool ktls = false;
+};
+
+struct ClientOptions {
+  std::string ca_file; // empty uses the system trust store
+  bool verify_peer = true;
+  // Host name or IP the certificate must be issued for; empty checks only
+  // the chain. The client keeps one context per origin, so it can be fixed.
+  std::string server_name;
+  std::string ciphers;
+  std::string ciphersuites;
+  std::vector<std::string> alpn{"h2"};
+  // Keep the last session the server issued and offer it on reconnect
+  bool session_resumption = true;
+  bool ktls = false;
+};
+
+// Both set TLS 1.2 as the floor and count handshakes as
+// tls.handshakes{side, resumed}. Call before the context is shared with
+// any connection.
+astra::outcome::Result<void, TlsError>
+configure_server(boost::asio::ssl::context &context,
+                 const ServerOptions &options);
+astra::outcome::Result<void, TlsError>
+configure_client(boost::asio::ssl::context &context,
+                 const ClientOptions &options);
+
+// ALPN wire format: each protocol prefixed by its length. Empty when a
+// protocol name is empty or longer than 255 bytes.
+std::string encode_alpn(const std::vector<std::string> &protocols);
+// First of `supported` that the peer offered; empty when there is none
+std::string_view select_alpn(std::string_view offered_wire,
+                             const std::vector<std::string> &supported);
+
+// Whether the kernel is doing record encryption for this connection. Only
+// possible when OpenSSL talks to the socket directly; over asio's
+// ssl::stream, which feeds OpenSSL through a memory BIO pair, it is not.
+bool ktls_engaged(const SSL *ssl) noexcept;
+
+} // namespace astra::tls
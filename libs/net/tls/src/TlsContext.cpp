@@ -0,0 +1,299 @@
+#include "TlsContext.h"
+
+#include <Metrics.h>
+#include <mutex>
+#include <openssl/ssl.h>
+#include <openssl/x509v3.h>
+
+namespace astra::tls {
+
+namespace {
+
+using astra::outcome::Result;
+
+// The last session a client context was issued. One per context, and the
+// HTTP/2 client keeps one context per origin, so no key is needed.
+struct ClientSessionSlot {
+  std::mutex mutex;
+  SSL_SESSION *session = nullptr;
+
+  ~ClientSessionSlot() {
+    if (session) {
+      SSL_SESSION_free(session);
+    }
+  }
+};
+
+void free_slot(void *, void *ptr, CRYPTO_EX_DATA *, int, long, void *) {
+  delete static_cast<ClientSessionSlot *>(ptr);
+}
+
+int slot_index() {
+  static const int index = SSL_CTX_get_ex_new_index(0, nullptr, nullptr,
+                                                    nullptr, free_slot);
+  return index;
+}
+
+ClientSessionSlot *slot_of(SSL_CTX *ctx) {
+  return static_cast<ClientSessionSlot *>(
+      SSL_CTX_get_ex_data(ctx, slot_index()));
+}
+
+int store_session(SSL *ssl, SSL_SESSION *session) {
+  auto *slot = slot_of(SSL_get_SSL_CTX(ssl));
+  if (!slot) {
+    return 0;
+  }
+  std::lock_guard<std::mutex> lock(slot->mutex);
+  if (slot->session) {
+    SSL_SESSION_free(slot->session);
+  }
+  slot->session = session;
+  return 1; // keeps the reference
+}
+
+void on_handshake(const SSL *ssl, int where, int) {
+  auto *mutable_ssl = const_cast<SSL *>(ssl);
+  bool server = SSL_is_server(mutable_ssl) == 1;
+
+  // The ClientHello is not written yet, so a session set now is offered
+  if ((where & SSL_CB_HANDSHAKE_START) && !server) {
+    if (auto *slot = slot_of(SSL_get_SSL_CTX(ssl))) {
+      std::lock_guard<std::mutex> lock(slot->mutex);
+      if (slot->session && SSL_SESSION_is_resumable(slot->session)) {
+        SSL_set_session(mutable_ssl, slot->session);
+      }
+    }
+    return;
+  }
+
+  if (where & SSL_CB_HANDSHAKE_DONE) {
+    static auto handshakes = obs::counter("tls.handshakes");
+    handshakes.inc(1, {{"side", server ? "server" : "client"},
+                       {"resumed", SSL_session_reused(mutable_ssl) == 1
+                                       ? "true"
+                                       : "false"}});
+#ifdef SSL_OP_ENABLE_KTLS
+    if (SSL_get_options(mutable_ssl) & SSL_OP_ENABLE_KTLS) {
+      static auto ktls = obs::counter("tls.ktls");
+      ktls.inc(1, {{"side", server ? "server" : "client"},
+                   {"engaged", ktls_engaged(ssl) ? "true" : "false"}});
+    }
+#endif
+  }
+}
+
+int select_protocol(SSL *, const unsigned char **out, unsigned char *outlen,
+                    const unsigned char *in, unsigned int inlen, void *arg) {
+  const auto &supported = *static_cast<const std::vector<std::string> *>(arg);
+  auto chosen = select_alpn(
+      std::string_view(reinterpret_cast<const char *>(in), inlen), supported);
+  if (chosen.empty()) {
+    return SSL_TLSEXT_ERR_ALERT_FATAL;
+  }
+  *out = reinterpret_cast<const unsigned char *>(chosen.data());
+  *outlen = static_cast<unsigned char>(chosen.size());
+  return SSL_TLSEXT_ERR_OK;
+}
+
+// Protocol lists handed to the ALPN callback must outlive the context
+std::vector<std::string> *keep_alpn(SSL_CTX *ctx,
+                                    std::vector<std::string> protocols) {
+  static const int index = SSL_CTX_get_ex_new_index(
+      0, nullptr, nullptr, nullptr,
+      [](void *, void *ptr, CRYPTO_EX_DATA *, int, long, void *) {
+        delete static_cast<std::vector<std::string> *>(ptr);
+      });
+  auto *kept = new std::vector<std::string>(std::move(protocols));
+  delete static_cast<std::vector<std::string> *>(
+      SSL_CTX_get_ex_data(ctx, index));
+  SSL_CTX_set_ex_data(ctx, index, kept);
+  return kept;
+}
+
+Result<void, TlsError> apply_common(SSL_CTX *ctx, const std::string &ciphers,
+                                    const std::string &ciphersuites,
+                                    bool ktls) {
+  SSL_CTX_set_min_proto_version(ctx, TLS1_2_VERSION);
+  SSL_CTX_set_options(ctx, SSL_OP_NO_COMPRESSION |
+                               SSL_OP_NO_RENEGOTIATION |
+                               SSL_OP_CIPHER_SERVER_PREFERENCE);
+  if (!ciphers.empty() && SSL_CTX_set_cipher_list(ctx, ciphers.c_str()) != 1) {
+    return Result<void, TlsError>::Err(TlsError::CipherList);
+  }
+  if (!ciphersuites.empty() &&
+      SSL_CTX_set_ciphersuites(ctx, ciphersuites.c_str()) != 1) {
+    return Result<void, TlsError>::Err(TlsError::CipherList);
+  }
+#ifdef SSL_OP_ENABLE_KTLS
+  if (ktls) {
+    SSL_CTX_set_options(ctx, SSL_OP_ENABLE_KTLS);
+  }
+#else
+  (void)ktls;
+#endif
+  SSL_CTX_set_info_callback(ctx, on_handshake);
+  return Result<void, TlsError>::Ok();
+}
+
+} // namespace
+
+const char *to_string(TlsError error) noexcept {
+  switch (error) {
+  case TlsError::CertificateLoad:
+    return "CertificateLoad";
+  case TlsError::PrivateKeyLoad:
+    return "PrivateKeyLoad";
+  case TlsError::KeyMismatch:
+    return "KeyMismatch";
+  case TlsError::CipherList:
+    return "CipherList";
+  case TlsError::CaLoad:
+    return "CaLoad";
+  case TlsError::AlpnList:
+    return "AlpnList";
+  }
+  return "Unknown";
+}
+
+Result<void, TlsError> configure_server(boost::asio::ssl::context &context,
+                                        const ServerOptions &options) {
+  SSL_CTX *ctx = context.native_handle();
+
+  if (SSL_CTX_use_certificate_chain_file(ctx, options.cert_file.c_str()) !=
+      1) {
+    return Result<void, TlsError>::Err(TlsError::CertificateLoad);
+  }
+  if (SSL_CTX_use_PrivateKey_file(ctx, options.key_file.c_str(),
+                                  SSL_FILETYPE_PEM) != 1) {
+    return Result<void, TlsError>::Err(TlsError::PrivateKeyLoad);
+  }
+  if (SSL_CTX_check_private_key(ctx) != 1) {
+    return Result<void, TlsError>::Err(TlsError::KeyMismatch);
+  }
+  if (encode_alpn(options.alpn).empty()) {
+    return Result<void, TlsError>::Err(TlsError::AlpnList);
+  }
+
+  auto common = apply_common(ctx, options.ciphers, options.ciphersuites,
+                             options.ktls);
+  if (common.is_err()) {
+    return common;
+  }
+
+  // Resumption needs a context id, or OpenSSL refuses cached sessions
+  static const unsigned char kSessionContext[] = "astra";
+  SSL_CTX_set_session_id_context(ctx, kSessionContext,
+                                 sizeof(kSessionContext) - 1);
+  if (options.session_cache_size > 0) {
+    SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_SERVER);
+    SSL_CTX_sess_set_cache_size(ctx, static_cast<long>(
+                                         options.session_cache_size));
+  } else {
+    SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_OFF);
+  }
+  SSL_CTX_set_timeout(ctx, static_cast<long>(options.session_timeout.count()));
+  if (!options.session_tickets) {
+    SSL_CTX_set_options(ctx, SSL_OP_NO_TICKET);
+    // TLS 1.3 still issues stateful tickets from the cache; none without it
+    if (options.session_cache_size == 0) {
+      SSL_CTX_set_num_tickets(ctx, 0);
+    }
+  }
+
+  SSL_CTX_set_alpn_select_cb(ctx, select_protocol,
+                             keep_alpn(ctx, options.alpn));
+  return Result<void, TlsError>::Ok();
+}
+
+Result<void, TlsError> configure_client(boost::asio::ssl::context &context,
+                                        const ClientOptions &options) {
+  SSL_CTX *ctx = context.native_handle();
+
+  if (options.verify_peer) {
+    int loaded =
+        options.ca_file.empty()
+            ? SSL_CTX_set_default_verify_paths(ctx)
+            : SSL_CTX_load_verify_locations(ctx, options.ca_file.c_str(),
+                                            nullptr);
+    if (loaded != 1) {
+      return Result<void, TlsError>::Err(TlsError::CaLoad);
+    }
+    SSL_CTX_set_verify(ctx, SSL_VERIFY_PEER, nullptr);
+    if (!options.server_name.empty()) {
+      auto *param = SSL_CTX_get0_param(ctx);
+      if (X509_VERIFY_PARAM_set1_ip_asc(param, options.server_name.c_str()) !=
+          1) {
+        X509_VERIFY_PARAM_set1_host(param, options.server_name.c_str(), 0);
+      }
+    }
+  } else {
+    SSL_CTX_set_verify(ctx, SSL_VERIFY_NONE, nullptr);
+  }
+
+  auto alpn = encode_alpn(options.alpn);
+  // Unlike every other OpenSSL setter, this one returns 0 on success
+  if (alpn.empty() ||
+      SSL_CTX_set_alpn_protos(
+          ctx, reinterpret_cast<const unsigned char *>(alpn.data()),
+          static_cast<unsigned int>(alpn.size())) != 0) {
+    return Result<void, TlsError>::Err(TlsError::AlpnList);
+  }
+
+  auto common = apply_common(ctx, options.ciphers, options.ciphersuites,
+                             options.ktls);
+  if (common.is_err()) {
+    return common;
+  }
+
+  if (options.session_resumption) {
+    // Internal store off: the slot is the only cache a client needs
+    SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_CLIENT |
+                                            SSL_SESS_CACHE_NO_INTERNAL_STORE);
+    SSL_CTX_sess_set_new_cb(ctx, store_session);
+    if (!slot_of(ctx)) {
+      SSL_CTX_set_ex_data(ctx, slot_index(), new ClientSessionSlot());
+    }
+  } else {
+    SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_OFF);
+    SSL_CTX_set_options(ctx, SSL_OP_NO_TICKET);
+  }
+  return Result<void, TlsError>::Ok();
+}
+
+std::string encode_alpn(const std::vector<std::string> &protocols) {
+  std::string wire;
+  for (const auto &protocol : protocols) {
+    if (protocol.empty() || protocol.size() > 255) {
+      return {};
+    }
+    wire.push_back(static_cast<char>(protocol.size()));
+    wire += protocol;
+  }
+  return wire;
+}
+
+std::string_view select_alpn(std::string_view offered_wire,
+                             const std::vector<std::string> &supported) {
+  for (const auto &protocol : supported) {
+    std::string_view rest = offered_wire;
+    while (!rest.empty()) {
+      size_t len = static_cast<unsigned char>(rest.front());
+      if (len + 1 > rest.size()) {
+        break; // malformed; nothing after this can be trusted
+      }
+      if (rest.substr(1, len) == protocol) {
+        return protocol;
+      }
+      rest.remove_prefix(len + 1);
+    }
+  }
+  return {};
+}
+
+bool ktls_engaged(const SSL *ssl) noexcept {
+  BIO *wbio = SSL_get_wbio(ssl);
+  return wbio != nullptr && BIO_get_ktls_send(wbio);
+}
+
+} // namespace astra::tls
@@ -0,0 +1,241 @@
+#include "TlsContext.h"
+
+#include <boost/asio.hpp>
+#include <boost/asio/ssl.hpp>
+#include <cstdio>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/x509.h>
+#include <thread>
+
+namespace {
+
+namespace net = boost::asio;
+namespace ssl = boost::asio::ssl;
+using astra::tls::ClientOptions;
+using astra::tls::ServerOptions;
+using tcp = net::ip::tcp;
+
+// Self-signed P-256 certificate for "localhost", written next to the test
+struct SelfSigned {
+  std::string cert_file;
+  std::string key_file;
+
+  SelfSigned() {
+    auto dir = std::filesystem::temp_directory_path();
+    cert_file = (dir / "astra_tls_test_cert.pem").string();
+    key_file = (dir / "astra_tls_test_key.pem").string();
+
+    EVP_PKEY *key = EVP_EC_gen("P-256");
+    X509 *cert = X509_new();
+    ASN1_INTEGER_set(X509_get_serialNumber(cert), 1);
+    X509_gmtime_adj(X509_getm_notBefore(cert), 0);
+    X509_gmtime_adj(X509_getm_notAfter(cert), 3600);
+    X509_set_pubkey(cert, key);
+    X509_NAME *name = X509_get_subject_name(cert);
+    X509_NAME_add_entry_by_txt(
+        name, "CN", MBSTRING_ASC,
+        reinterpret_cast<const unsigned char *>("localhost"), -1, -1, 0);
+    X509_set_issuer_name(cert, name);
+    X509_sign(cert, key, EVP_sha256());
+
+    FILE *out = std::fopen(cert_file.c_str(), "w");
+    PEM_write_X509(out, cert);
+    std::fclose(out);
+    out = std::fopen(key_file.c_str(), "w");
+    PEM_write_PrivateKey(out, key, nullptr, nullptr, 0, nullptr, nullptr);
+    std::fclose(out);
+
+    X509_free(cert);
+    EVP_PKEY_free(key);
+  }
+
+  ~SelfSigned() {
+    std::remove(cert_file.c_str());
+    std::remove(key_file.c_str());
+  }
+};
+
+struct Handshake {
+  bool ok = false;
+  bool resumed = false;
+  std::string alpn;
+};
+
+class TlsContextTest : public ::testing::Test {
+protected:
+  ServerOptions server_options() const {
+    ServerOptions options;
+    options.cert_file = m_cert.cert_file;
+    options.key_file = m_cert.key_file;
+    return options;
+  }
+
+  ClientOptions client_options() const {
+    ClientOptions options;
+    options.ca_file = m_cert.cert_file;
+    return options;
+  }
+
+  // One connection: handshake, then a byte from the server so the client
+  // reads any TLS 1.3 tickets sent after the handshake
+  static Handshake connect(ssl::context &server_ctx, ssl::context &client_ctx) {
+    net::io_context ioc;
+    tcp::acceptor acceptor(ioc, {net::ip::make_address("127.0.0.1"), 0});
+
+    std::thread server([&] {
+      ssl::stream<tcp::socket> stream(ioc, server_ctx);
+      boost::system::error_code ec;
+      acceptor.accept(stream.next_layer(), ec);
+      stream.handshake(ssl::stream_base::server, ec);
+      if (!ec) {
+        net::write(stream, net::buffer("x", 1), ec);
+        stream.shutdown(ec);
+      }
+    });
+
+    Handshake result;
+    ssl::stream<tcp::socket> stream(ioc, client_ctx);
+    SSL_set_tlsext_host_name(stream.native_handle(), "localhost");
+    stream.next_layer().connect(acceptor.local_endpoint());
+    boost::system::error_code ec;
+    stream.handshake(ssl::stream_base::client, ec);
+    if (!ec) {
+      char byte;
+      net::read(stream, net::buffer(&byte, 1), ec);
+      result.ok = !ec;
+      result.resumed = SSL_session_reused(stream.native_handle()) == 1;
+      const unsigned char *alpn = nullptr;
+      unsigned int alpn_len = 0;
+      SSL_get0_alpn_selected(stream.native_handle(), &alpn, &alpn_len);
+      result.alpn.assign(reinterpret_cast<const char *>(alpn), alpn_len);
+      stream.shutdown(ec);
+    }
+    server.join();
+    return result;
+  }
+
+  SelfSigned m_cert;
+};
+
+} // namespace
+
+TEST(AlpnTest, SelectsInServerPreferenceOrder) {
+  auto offered = astra::tls::encode_alpn({"http/1.1", "h2"});
+  EXPECT_EQ(astra::tls::select_alpn(offered, {"h2", "http/1.1"}), "h2");
+  EXPECT_EQ(astra::tls::select_alpn(offered, {"http/1.1"}), "http/1.1");
+  EXPECT_EQ(astra::tls::select_alpn(offered, {"h3"}), "");
+}
+
+TEST(AlpnTest, RejectsMalformedInput) {
+  EXPECT_EQ(astra::tls::encode_alpn({"h2", ""}), "");
+  EXPECT_EQ(astra::tls::encode_alpn({std::string(256, 'x')}), "");
+  // Claims 9 bytes, carries 2
+  EXPECT_EQ(astra::tls::select_alpn(std::string("\x09h2", 3), {"h2"}), "");
+}
+
+TEST_F(TlsContextTest, ServerNeedsLoadableCertificateAndKey) {
+  ssl::context ctx(ssl::context::tls_server);
+  auto options = server_options();
+  options.cert_file = "/nonexistent.pem";
+  auto result = astra::tls::configure_server(ctx, options);
+  ASSERT_TRUE(result.is_err());
+  EXPECT_EQ(result.error(), astra::tls::TlsError::CertificateLoad);
+
+  options = server_options();
+  options.ciphers = "NOT-A-CIPHER";
+  result = astra::tls::configure_server(ctx, options);
+  ASSERT_TRUE(result.is_err());
+  EXPECT_EQ(result.error(), astra::tls::TlsError::CipherList);
+}
+
+TEST_F(TlsContextTest, NegotiatesH2WhenClientAlsoOffersHttp11) {
+  ssl::context server_ctx(ssl::context::tls_server);
+  ssl::context client_ctx(ssl::context::tls_client);
+  ASSERT_TRUE(astra::tls::configure_server(server_ctx, server_options()).is_ok());
+  auto options = client_options();
+  options.alpn = {"http/1.1", "h2"};
+  ASSERT_TRUE(astra::tls::configure_client(client_ctx, options).is_ok());
+
+  auto handshake = connect(server_ctx, client_ctx);
+  EXPECT_TRUE(handshake.ok);
+  EXPECT_EQ(handshake.alpn, "h2");
+}
+
+TEST_F(TlsContextTest, RefusesClientWithoutACommonProtocol) {
+  ssl::context server_ctx(ssl::context::tls_server);
+  ssl::context client_ctx(ssl::context::tls_client);
+  ASSERT_TRUE(astra::tls::configure_server(server_ctx, server_options()).is_ok());
+  auto options = client_options();
+  options.alpn = {"http/1.1"};
+  ASSERT_TRUE(astra::tls::configure_client(client_ctx, options).is_ok());
+
+  EXPECT_FALSE(connect(server_ctx, client_ctx).ok);
+}
+
+TEST_F(TlsContextTest, VerifiesServerName) {
+  ssl::context server_ctx(ssl::context::tls_server);
+  ssl::context good_ctx(ssl::context::tls_client);
+  ssl::context bad_ctx(ssl::context::tls_client);
+  ASSERT_TRUE(astra::tls::configure_server(server_ctx, server_options()).is_ok());
+  auto options = client_options();
+  options.server_name = "localhost";
+  ASSERT_TRUE(astra::tls::configure_client(good_ctx, options).is_ok());
+  options.server_name = "example.com";
+  ASSERT_TRUE(astra::tls::configure_client(bad_ctx, options).is_ok());
+
+  EXPECT_TRUE(connect(server_ctx, good_ctx).ok);
+  EXPECT_FALSE(connect(server_ctx, bad_ctx).ok);
+}
+
+TEST_F(TlsContextTest, ResumesWithTickets) {
+  ssl::context server_ctx(ssl::context::tls_server);
+  ssl::context client_ctx(ssl::context::tls_client);
+  ASSERT_TRUE(astra::tls::configure_server(server_ctx, server_options()).is_ok());
+  ASSERT_TRUE(astra::tls::configure_client(client_ctx, client_options()).is_ok());
+
+  auto first = connect(server_ctx, client_ctx);
+  auto second = connect(server_ctx, client_ctx);
+  ASSERT_TRUE(first.ok);
+  ASSERT_TRUE(second.ok);
+  EXPECT_FALSE(first.resumed);
+  EXPECT_TRUE(second.resumed);
+}
+
+TEST_F(TlsContextTest, ResumesFromServerCacheWithoutTickets) {
+  ssl::context server_ctx(ssl::context::tls_server);
+  ssl::context client_ctx(ssl::context::tls_client);
+  auto options = server_options();
+  options.session_tickets = false;
+  ASSERT_TRUE(astra::tls::configure_server(server_ctx, options).is_ok());
+  ASSERT_TRUE(astra::tls::configure_client(client_ctx, client_options()).is_ok());
+  SSL_CTX_set_max_proto_version(client_ctx.native_handle(), TLS1_2_VERSION);
+
+  ASSERT_TRUE(connect(server_ctx, client_ctx).ok);
+  EXPECT_TRUE(connect(server_ctx, client_ctx).resumed);
+}
+
+TEST_F(TlsContextTest, NoResumptionWhenClientOptsOut) {
+  ssl::context server_ctx(ssl::context::tls_server);
+  ssl::context client_ctx(ssl::context::tls_client);
+  ASSERT_TRUE(astra::tls::configure_server(server_ctx, server_options()).is_ok());
+  auto options = client_options();
+  options.session_resumption = false;
+  ASSERT_TRUE(astra::tls::configure_client(client_ctx, options).is_ok());
+
+  ASSERT_TRUE(connect(server_ctx, client_ctx).ok);
+  EXPECT_FALSE(connect(server_ctx, client_ctx).resumed);
+}
+
+TEST_F(TlsContextTest, KtlsIsNotEngagedOverAsioStreams) {
+  ssl::context ctx(ssl::context::tls_client);
+  auto options = client_options();
+  options.ktls = true;
+  ASSERT_TRUE(astra::tls::configure_client(ctx, options).is_ok());
+
+  net::io_context ioc;
+  ssl::stream<tcp::socket> stream(ioc, ctx);
+  EXPECT_FALSE(astra::tls::ktls_engaged(stream.native_handle()));
+}